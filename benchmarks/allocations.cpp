@@ -0,0 +1,195 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "allocations.h"
+
+#include <malloc.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+// glibc hands out its allocator under these names, such that
+// replacements of malloc can forward to it.
+extern "C"
+{
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void* __libc_valloc(std::size_t size);
+void* __libc_pvalloc(std::size_t size);
+void __libc_free(void* ptr);
+}
+
+namespace
+{
+// Both are constant-initialized, i.e., usable before any constructor ran.
+std::atomic<std::uint64_t> allocation_count{0};
+std::atomic<std::uint64_t> allocated_bytes{0};
+
+std::atomic<bool> live_tracking{false};
+std::atomic<std::int64_t> live{0};
+
+// Threads serving the local httpbin instance must not be accounted for.
+thread_local bool tracked{false};
+// Counted for every thread, without synchronization.
+thread_local std::uint64_t thread_allocation_count{0};
+thread_local std::uint64_t thread_allocated_bytes{0};
+
+inline void account(std::size_t size)
+{
+    thread_allocation_count++;
+    thread_allocated_bytes += size;
+
+    if (not tracked)
+        return;
+
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+// Accounts for a block being handed out (sign 1) or taken back (sign -1).
+inline void account_live(void* ptr, std::int64_t sign)
+{
+    if (ptr && live_tracking.load(std::memory_order_relaxed))
+        live.fetch_add(sign * static_cast<std::int64_t>(malloc_usable_size(ptr)), std::memory_order_relaxed);
+}
+}
+
+extern "C"
+{
+__attribute__((visibility("default"))) void* malloc(std::size_t size)
+{
+    account(size);
+
+    auto result = __libc_malloc(size);
+    account_live(result, 1);
+
+    return result;
+}
+
+__attribute__((visibility("default"))) void* calloc(std::size_t count, std::size_t size)
+{
+    account(count * size);
+
+    auto result = __libc_calloc(count, size);
+    account_live(result, 1);
+
+    return result;
+}
+
+__attribute__((visibility("default"))) void* realloc(void* ptr, std::size_t size)
+{
+    account(size);
+    account_live(ptr, -1);
+
+    auto result = __libc_realloc(ptr, size);
+    // A failed realloc leaves the original block in place.
+    account_live(result ? result : (size > 0 ? ptr : nullptr), 1);
+
+    return result;
+}
+
+// Blocks handed out with an alignment end up in free as well, so these must
+// be accounted for just like the ones handed out by malloc.
+__attribute__((visibility("default"))) void* memalign(std::size_t alignment, std::size_t size)
+{
+    account(size);
+
+    auto result = __libc_memalign(alignment, size);
+    account_live(result, 1);
+
+    return result;
+}
+
+__attribute__((visibility("default"))) int posix_memalign(void** ptr, std::size_t alignment, std::size_t size)
+{
+    // glibc reports these as errors, whereas memalign rounds them up.
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0 || alignment == 0)
+        return EINVAL;
+
+    auto result = memalign(alignment, size);
+
+    if (not result && size > 0)
+        return ENOMEM;
+
+    *ptr = result;
+    return 0;
+}
+
+__attribute__((visibility("default"))) void* aligned_alloc(std::size_t alignment, std::size_t size)
+{
+    return memalign(alignment, size);
+}
+
+__attribute__((visibility("default"))) void* valloc(std::size_t size)
+{
+    account(size);
+
+    auto result = __libc_valloc(size);
+    account_live(result, 1);
+
+    return result;
+}
+
+__attribute__((visibility("default"))) void* pvalloc(std::size_t size)
+{
+    account(size);
+
+    auto result = __libc_pvalloc(size);
+    account_live(result, 1);
+
+    return result;
+}
+
+__attribute__((visibility("default"))) void free(void* ptr)
+{
+    account_live(ptr, -1);
+    __libc_free(ptr);
+}
+}
+
+bench::Allocations bench::Allocations::snapshot()
+{
+    return Allocations
+    {
+        allocation_count.load(std::memory_order_relaxed),
+        allocated_bytes.load(std::memory_order_relaxed)
+    };
+}
+
+void bench::Allocations::track_this_thread(bool enabled)
+{
+    tracked = enabled;
+}
+
+bench::Allocations bench::Allocations::of_this_thread()
+{
+    return Allocations{thread_allocation_count, thread_allocated_bytes};
+}
+
+void bench::Allocations::track_live_bytes()
+{
+    live_tracking.store(true);
+}
+
+std::int64_t bench::Allocations::live_bytes()
+{
+    return live.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef BENCHMARKS_ALLOCATIONS_H_
+#define BENCHMARKS_ALLOCATIONS_H_
+
+#include <cstdint>
+
+namespace bench
+{
+// Counts the heap allocations carried out by tracked threads. Linking
+// allocations.cpp into an executable interposes malloc and friends for
+// the whole process, including libcurl and the C++ runtime.
+struct Allocations
+{
+    // Number of calls to malloc, calloc and realloc.
+    std::uint64_t count;
+    // Number of bytes requested by these calls.
+    std::uint64_t bytes;
+
+    // Returns the allocations of all tracked threads so far.
+    static Allocations snapshot();
+
+    // Starts or stops counting the allocations of the calling thread.
+    static void track_this_thread(bool enabled);
+
+    // Returns the allocations of the calling thread so far, whether tracked or not.
+    static Allocations of_this_thread();
+
+    // Starts accounting for the bytes in use by all threads, as reported by live_bytes().
+    // Blocks allocated before are not accounted for, so only differences are meaningful.
+    static void track_live_bytes();
+
+    // Returns the number of bytes in use, including the overhead of the allocator.
+    static std::int64_t live_bytes();
+
+    Allocations operator-(const Allocations& rhs) const
+    {
+        return Allocations{count - rhs.count, bytes - rhs.bytes};
+    }
+
+    Allocations& operator+=(const Allocations& rhs)
+    {
+        count += rhs.count;
+        bytes += rhs.bytes;
+        return *this;
+    }
+};
+}
+
+#endif // BENCHMARKS_ALLOCATIONS_H_
@@ -0,0 +1,895 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "allocations.h"
+#include "httpbin.h"
+#include "open_loop.h"
+#include "workload.h"
+
+#include <core/net/error.h>
+#include <core/net/http/client.h>
+#include <core/net/http/histogram.h>
+#include <core/net/http/request.h>
+#include <core/net/http/response.h>
+
+#include <json/json.h>
+
+#include <pthread.h>
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace http = core::net::http;
+
+namespace
+{
+using bench::Clock;
+using bench::KiB;
+using bench::MiB;
+using bench::Mode;
+using bench::Scenario;
+using bench::Seconds;
+using bench::Tally;
+using bench::Workload;
+
+using bench::cpu_time_of;
+using bench::in_microseconds;
+using bench::name_of;
+using bench::workload_for;
+
+// Every connection occupies a descriptor on both ends, as the server runs in-process.
+constexpr const std::size_t descriptors_per_request{2};
+// Descriptors used by the process apart from connections.
+constexpr const std::size_t spare_descriptors{64};
+
+const char* usage
+{
+    "Usage: net-cpp-bench [OPTION]...\n"
+    "Runs end-to-end scenarios against a local httpbin instance and reports the results as JSON.\n"
+    "\n"
+    "  --duration=SECONDS      time every scenario is measured for (default: 2)\n"
+    "  --warmup=SECONDS        time every scenario runs before measuring (default: 0.5)\n"
+    "  --filter=REGEX          only run scenarios with a matching name\n"
+    "  --output=FILE           write the results to FILE instead of stdout\n"
+    "  --port=PORT             port of the local httpbin instance (default: any free one)\n"
+    "  --server-threads=N      threads serving requests, one per core if 0 (default: 0)\n"
+    "  --list                  print the names of the scenarios and exit\n"
+    "\n"
+    "  --open-loop             send requests at a rising rate instead, reporting latency versus throughput\n"
+    "                          for every workload, i.e., scenario without concurrency and mode\n"
+    "  --arrivals=KIND         'constant' or 'poisson' intervals between requests (default: poisson)\n"
+    "  --start-rate=RPS        rate of the first step, a step lasts for the duration (default: 100)\n"
+    "  --rate-factor=FACTOR    factor the rate is raised with from step to step (default: 1.5)\n"
+    "  --max-rate=RPS          highest rate to offer (default: 1000000)\n"
+    "  --p99-threshold=MS      stop after the first step with a higher p99 (default: 100)\n"
+    "  --seed=N                seeds the intervals of Poisson arrivals (default: 42)\n"
+    "\n"
+    "  --footprint[=N,...]     measure memory and allocations per idle request in flight instead,\n"
+    "                          for every given number of requests (default: 10000,100000)\n"
+};
+
+// Options of a run, as given on the command line.
+struct Settings
+{
+    Seconds duration{2};
+    Seconds warmup{0.5};
+    std::regex filter{""};
+    std::string output;
+    std::uint16_t port{0};
+    std::size_t server_threads{0};
+    bool list{false};
+    bool open_loop{false};
+    bench::Ramp ramp;
+    bool footprint{false};
+    std::vector<std::size_t> in_flight{10000, 100000};
+};
+
+// The measurements of a scenario.
+struct Result
+{
+    Tally tally;
+    Seconds elapsed{0};
+    // CPU time spent by the client, excluding the threads serving requests.
+    Seconds cpu{0};
+    bench::Allocations allocations{};
+    // The reason for not running the scenario, empty if it ran.
+    std::string skipped;
+};
+
+std::vector<Scenario> scenarios()
+{
+    std::vector<Scenario> result;
+
+    // Request rate for empty responses, by concurrency.
+    for (std::size_t concurrency : {1, 10, 100, 1000, 10000})
+        result.push_back(Scenario{http::Method::get, 0, concurrency, true, Mode::async});
+    for (std::size_t concurrency : {1, 10, 100})
+        result.push_back(Scenario{http::Method::get, 0, concurrency, true, Mode::sync});
+
+    // The cost of setting up connections.
+    for (std::size_t concurrency : {1, 10, 100})
+        result.push_back(Scenario{http::Method::get, 0, concurrency, false, Mode::async});
+    for (std::size_t concurrency : {1, 10})
+        result.push_back(Scenario{http::Method::get, 0, concurrency, false, Mode::sync});
+
+    // Throughput of downloads and uploads, by body size.
+    for (std::size_t size : {KiB, 64 * KiB, MiB, 100 * MiB})
+        result.push_back(Scenario{http::Method::get, size, 1, true, Mode::async});
+    result.push_back(Scenario{http::Method::get, MiB, 10, true, Mode::async});
+
+    for (std::size_t size : {KiB, 64 * KiB, MiB, 100 * MiB})
+    {
+        result.push_back(Scenario{http::Method::post, size, 1, true, Mode::async});
+        result.push_back(Scenario{http::Method::put, size, 1, true, Mode::async});
+    }
+    result.push_back(Scenario{http::Method::post, KiB, 100, true, Mode::async});
+    result.push_back(Scenario{http::Method::post, KiB, 10, true, Mode::sync});
+
+    // The remaining methods.
+    for (std::size_t concurrency : {1, 100})
+    {
+        result.push_back(Scenario{http::Method::head, 0, concurrency, true, Mode::async});
+        result.push_back(Scenario{http::Method::del, 0, concurrency, true, Mode::async});
+    }
+
+    return result;
+}
+
+// Keeps a fixed number of requests in flight until the deadline passed,
+// issuing the next request from the handler of a completed one.
+class ClosedLoop : public std::enable_shared_from_this<ClosedLoop>
+{
+public:
+    ClosedLoop(http::Client& client, const Workload& workload, const Clock::time_point& deadline)
+        : client(client),
+          workload(workload),
+          deadline(deadline)
+    {
+    }
+
+    Tally run()
+    {
+        in_flight = workload.scenario.concurrency;
+
+        for (std::size_t i = 0; i < workload.scenario.concurrency; i++)
+            issue();
+
+        std::unique_lock<std::mutex> lock(guard);
+        done.wait(lock, [this]() { return in_flight == 0; });
+
+        tally.created = load(created_allocations);
+        tally.executed = load(executed_allocations);
+
+        return tally;
+    }
+
+private:
+    void issue()
+    {
+        auto self = shared_from_this();
+        auto started = Clock::now();
+
+        auto before = bench::Allocations::of_this_thread();
+        auto request = workload.make(client);
+        auto created = bench::Allocations::of_this_thread();
+
+        // Handlers run on the reactor, one after another, so the tally needs no lock.
+        request->async_execute(
+                    http::Request::Handler()
+                    .on_response([self, started](const http::Response& response)
+                    {
+                        self->workload.record(self->tally, started, response);
+                        self->next();
+                    })
+                    .on_error([self](const core::net::Error&)
+                    {
+                        self->tally.requests++;
+                        self->tally.errors++;
+                        self->next();
+                    }));
+
+        // The first requests are issued from another thread than the reactor.
+        auto executed = bench::Allocations::of_this_thread();
+        account(created_allocations, created - before);
+        account(executed_allocations, executed - created);
+    }
+
+    struct Counter
+    {
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<std::uint64_t> bytes{0};
+    };
+
+    static void account(Counter& counter, const bench::Allocations& allocations)
+    {
+        counter.count.fetch_add(allocations.count, std::memory_order_relaxed);
+        counter.bytes.fetch_add(allocations.bytes, std::memory_order_relaxed);
+    }
+
+    static bench::Allocations load(const Counter& counter)
+    {
+        return bench::Allocations{counter.count.load(), counter.bytes.load()};
+    }
+
+    void next()
+    {
+        if (Clock::now() < deadline)
+        {
+            issue();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lg(guard);
+        if (--in_flight == 0)
+            done.notify_all();
+    }
+
+    http::Client& client;
+    Workload workload;
+    Clock::time_point deadline;
+
+    Tally tally;
+    Counter created_allocations;
+    Counter executed_allocations;
+
+    std::mutex guard;
+    std::condition_variable done;
+    std::size_t in_flight{0};
+};
+
+// Executes requests synchronously on a thread per concurrent request until
+// the deadline passed, accumulating the CPU time of these threads in cpu.
+Tally run_blocking(http::Client& client, const Workload& workload, const Clock::time_point& deadline, Seconds& cpu)
+{
+    auto concurrency = workload.scenario.concurrency;
+
+    std::vector<Tally> tallies(concurrency);
+    std::vector<Seconds> cpu_times(concurrency, Seconds{0});
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < concurrency; i++)
+    {
+        threads.emplace_back([&client, &workload, &deadline, &tallies, &cpu_times, i]()
+        {
+            bench::Allocations::track_this_thread(true);
+            auto start = cpu_time_of(pthread_self());
+
+            while (Clock::now() < deadline)
+            {
+                auto started = Clock::now();
+
+                try
+                {
+                    auto before = bench::Allocations::of_this_thread();
+                    auto request = workload.make(client);
+                    auto created = bench::Allocations::of_this_thread();
+
+                    auto response = request->execute([](const http::Request::Progress&)
+                    {
+                        return http::Request::Progress::Next::continue_operation;
+                    });
+
+                    tallies[i].created += created - before;
+                    tallies[i].executed += bench::Allocations::of_this_thread() - created;
+                    workload.record(tallies[i], started, response);
+                } catch (const std::exception&)
+                {
+                    tallies[i].requests++;
+                    tallies[i].errors++;
+                }
+            }
+
+            cpu_times[i] = cpu_time_of(pthread_self()) - start;
+            bench::Allocations::track_this_thread(false);
+        });
+    }
+
+    Tally result;
+
+    for (std::size_t i = 0; i < concurrency; i++)
+    {
+        threads[i].join();
+        result.merge(tallies[i]);
+        cpu += cpu_times[i];
+    }
+
+    return result;
+}
+
+// Runs the workload for the given duration and measures the client while doing so.
+Result measure(http::Client& client, pthread_t reactor, const Workload& workload, const Seconds& duration)
+{
+    Result result;
+
+    bench::Allocations::track_this_thread(true);
+
+    auto allocations = bench::Allocations::snapshot();
+    auto cpu = cpu_time_of(reactor) + cpu_time_of(pthread_self());
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::duration_cast<Clock::duration>(duration);
+
+    if (workload.scenario.mode == Mode::async)
+        result.tally = std::make_shared<ClosedLoop>(client, workload, deadline)->run();
+    else
+        result.tally = run_blocking(client, workload, deadline, result.cpu);
+
+    result.elapsed = Clock::now() - start;
+    result.cpu += cpu_time_of(reactor) + cpu_time_of(pthread_self()) - cpu;
+    result.allocations = bench::Allocations::snapshot() - allocations;
+
+    bench::Allocations::track_this_thread(false);
+
+    return result;
+}
+
+Result run(const Scenario& scenario, const Settings& settings, const std::string& host)
+{
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+
+    auto required = scenario.concurrency * descriptors_per_request + spare_descriptors;
+    if (limit.rlim_cur < required)
+    {
+        Result result;
+        result.skipped = "Requires " + std::to_string(required) + " file descriptors, the limit is " + std::to_string(limit.rlim_cur) + ".";
+        return result;
+    }
+
+    auto workload = workload_for(scenario, host);
+    auto client = http::make_client();
+
+    std::thread reactor{[client]()
+    {
+        bench::Allocations::track_this_thread(true);
+        client->run();
+    }};
+
+    if (settings.warmup.count() > 0)
+        measure(*client, reactor.native_handle(), workload, settings.warmup);
+
+    auto result = measure(*client, reactor.native_handle(), workload, settings.duration);
+
+    client->stop();
+    reactor.join();
+
+    return result;
+}
+
+double per_request(double value, const Result& result)
+{
+    return result.tally.requests > 0 ? value / result.tally.requests : 0.;
+}
+
+Json::Value to_json(const http::Histogram& latencies)
+{
+    Json::Value value;
+
+    value["min"] = in_microseconds(latencies.min());
+    value["mean"] = in_microseconds(latencies.mean());
+    value["p50"] = in_microseconds(latencies.percentile(50));
+    value["p90"] = in_microseconds(latencies.percentile(90));
+    value["p99"] = in_microseconds(latencies.percentile(99));
+    value["p999"] = in_microseconds(latencies.percentile(99.9));
+    value["max"] = in_microseconds(latencies.max());
+
+    return value;
+}
+
+Json::Value to_json(const Scenario& scenario, const Result& result)
+{
+    Json::Value value;
+
+    value["name"] = scenario.name();
+    value["method"] = name_of(scenario.method);
+    value["body_size"] = Json::UInt64(scenario.body_size);
+    value["concurrency"] = Json::UInt64(scenario.concurrency);
+    value["connections"] = scenario.keep_alive ? "keep-alive" : "fresh";
+    value["mode"] = scenario.mode == Mode::async ? "async" : "sync";
+
+    if (not result.skipped.empty())
+    {
+        value["skipped"] = result.skipped;
+        return value;
+    }
+
+    const auto& tally = result.tally;
+
+    value["requests"] = Json::UInt64(tally.requests);
+    value["errors"] = Json::UInt64(tally.errors);
+    value["duration_s"] = result.elapsed.count();
+    value["requests_per_second"] = tally.requests / result.elapsed.count();
+    value["megabytes_per_second"] = tally.bytes / result.elapsed.count() / 1e6;
+    value["cpu_per_request_us"] = per_request(in_microseconds(result.cpu), result);
+    value["allocations_per_request"] = per_request(result.allocations.count, result);
+    value["allocated_bytes_per_request"] = per_request(result.allocations.bytes, result);
+
+    // Transfers are carried out on the reactor, or on the issuing thread for synchronous
+    // requests, where they show up as part of executing them.
+    auto transferred = result.allocations - tally.created - tally.executed;
+    auto stage = [&result](const bench::Allocations& allocations)
+    {
+        Json::Value v;
+        v["allocations"] = per_request(allocations.count, result);
+        v["bytes"] = per_request(allocations.bytes, result);
+        return v;
+    };
+
+    value["allocations_by_stage"]["create"] = stage(tally.created);
+    value["allocations_by_stage"]["execute"] = stage(tally.executed);
+    value["allocations_by_stage"]["transfer"] = stage(transferred);
+
+    if (tally.latencies.count() > 0)
+        value["latency_us"] = to_json(tally.latencies);
+
+    return value;
+}
+
+// Returns true if the step kept its p99 below the threshold without failing requests.
+bool sustained(const bench::Step& step, const bench::Ramp& ramp)
+{
+    return step.tally.errors == 0 &&
+            step.tally.latencies.count() > 0 &&
+            step.tally.latencies.percentile(99) <= ramp.p99_threshold;
+}
+
+// Ramps up the rate of requests of the workload of scenario, and returns the latency-versus-throughput curve.
+Json::Value run_open_loop(const Scenario& scenario, const Settings& settings, const std::string& host)
+{
+    auto workload = workload_for(scenario, host);
+    auto client = http::make_client();
+
+    std::thread reactor{[client]() { client->run(); }};
+
+    // Sets up connections at the start rate, such that the first step does not pay for it.
+    if (settings.warmup.count() > 0)
+    {
+        auto warmup = settings.ramp;
+        warmup.step = settings.warmup;
+        warmup.max_rate = warmup.start_rate;
+        bench::ramp_up(*client, reactor.native_handle(), workload, warmup);
+    }
+
+    auto steps = bench::ramp_up(*client, reactor.native_handle(), workload, settings.ramp);
+
+    client->stop();
+    reactor.join();
+
+    Json::Value value;
+
+    value["workload"] = scenario.workload_name();
+    value["arrivals"] = settings.ramp.arrivals == bench::Arrivals::poisson ? "poisson" : "constant";
+    value["p99_threshold_us"] = in_microseconds(settings.ramp.p99_threshold);
+    value["capacity_rps"] = 0.;
+    value["steps"] = Json::Value(Json::arrayValue);
+
+    for (const auto& step : steps)
+    {
+        const auto& tally = step.tally;
+
+        Json::Value v;
+        v["offered_rps"] = step.offered_rate;
+        v["achieved_rps"] = tally.requests / step.elapsed.count();
+        v["requests"] = Json::UInt64(tally.requests);
+        v["errors"] = Json::UInt64(tally.errors);
+        v["cpu_per_request_us"] = tally.requests > 0 ? in_microseconds(step.cpu) / tally.requests : 0.;
+        if (tally.latencies.count() > 0)
+            v["latency_us"] = to_json(tally.latencies);
+        value["steps"].append(v);
+
+        if (sustained(step, settings.ramp))
+            value["capacity_rps"] = step.offered_rate;
+
+        std::cerr << std::left << std::setw(34) << scenario.workload_name() << std::right
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(11) << step.offered_rate << " offered"
+                  << std::setw(11) << v["achieved_rps"].asDouble() << " req/s"
+                  << "  p50 " << std::setw(9) << v["latency_us"]["p50"].asDouble() << "µs"
+                  << "  p99 " << std::setw(9) << v["latency_us"]["p99"].asDouble() << "µs"
+                  << "  p999 " << std::setw(9) << v["latency_us"]["p999"].asDouble() << "µs"
+                  << (sustained(step, settings.ramp) ? "" : "  saturated") << std::endl;
+    }
+
+    return value;
+}
+
+// Prints a one-line summary of a scenario, to follow the progress of a run.
+void summarize(std::ostream& out, const Scenario& scenario, const Result& result)
+{
+    out << std::left << std::setw(34) << scenario.name() << std::right;
+
+    if (not result.skipped.empty())
+    {
+        out << " skipped: " << result.skipped << std::endl;
+        return;
+    }
+
+    const auto& tally = result.tally;
+    auto p = [&tally](double percentage)
+    {
+        return tally.latencies.count() > 0 ? in_microseconds(tally.latencies.percentile(percentage)) : 0.;
+    };
+
+    out << std::fixed << std::setprecision(1)
+        << std::setw(11) << tally.requests / result.elapsed.count() << " req/s"
+        << std::setw(10) << tally.bytes / result.elapsed.count() / 1e6 << " MB/s"
+        << "  p50 " << std::setw(9) << p(50) << "µs"
+        << "  p99 " << std::setw(9) << p(99) << "µs"
+        << std::setw(10) << per_request(in_microseconds(result.cpu), result) << " µs cpu/req"
+        << std::setw(8) << per_request(result.allocations.count, result) << " allocs/req";
+
+    if (tally.errors > 0)
+        out << "  " << tally.errors << " errors";
+
+    out << std::endl;
+}
+
+// Returns the number of bytes of memory of this process that are resident.
+std::size_t resident_bytes()
+{
+    std::ifstream statm{"/proc/self/statm"};
+
+    std::size_t size{0}, resident{0};
+    statm >> size >> resident;
+
+    return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+}
+
+// Parks requests in flight on the local httpbin instance, and measures the memory
+// they occupy once they are all connected and waiting for a response.
+Json::Value run_footprint(std::size_t in_flight, const std::string& host)
+{
+    Json::Value value;
+    value["in_flight"] = Json::UInt64(in_flight);
+
+    rlimit limit;
+    getrlimit(RLIMIT_NOFILE, &limit);
+
+    auto required = in_flight + spare_descriptors;
+    if (limit.rlim_cur < required)
+    {
+        value["skipped"] = "Requires " + std::to_string(required) + " file descriptors, the limit is " + std::to_string(limit.rlim_cur) + ".";
+        std::cerr << std::left << std::setw(34) << ("footprint/" + std::to_string(in_flight)) << std::right
+                  << " skipped: " << value["skipped"].asString() << std::endl;
+        return value;
+    }
+
+    auto client = http::make_client();
+
+    std::thread reactor{[client]()
+    {
+        bench::Allocations::track_this_thread(true);
+        client->run();
+    }};
+
+    bench::Allocations::track_this_thread(true);
+
+    auto resident = resident_bytes();
+    auto live = bench::Allocations::live_bytes();
+    auto allocations = bench::Allocations::snapshot();
+
+    // The longest delay httpbin offers, requests have to connect within it.
+    auto uri = host + httpbin::resources::delay(std::chrono::seconds{10});
+    auto connect_timeout = std::chrono::seconds{8};
+    auto errors = std::make_shared<std::atomic<std::size_t>>(0);
+
+    for (std::size_t i = 0; i < in_flight; i++)
+    {
+        client->get(http::Request::Configuration::from_uri_as_string(uri))->async_execute(
+                    http::Request::Handler()
+                    .on_response([](const http::Response&) {})
+                    .on_error([errors](const core::net::Error&) { (*errors)++; }));
+    }
+
+    // Every request waiting for its response occupies a socket watched by the reactor.
+    auto deadline = Clock::now() + connect_timeout;
+    while (client->reactor_statistics().active_sockets < in_flight && *errors == 0 && Clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+    auto connected = client->reactor_statistics().active_sockets;
+
+    auto per_request = [in_flight](double value) { return value / in_flight; };
+    auto allocated = bench::Allocations::snapshot() - allocations;
+
+    value["connected"] = Json::UInt64(connected);
+    value["errors"] = Json::UInt64(*errors);
+    value["resident_bytes_per_request"] = per_request(static_cast<double>(resident_bytes()) - resident);
+    value["heap_bytes_per_request"] = per_request(bench::Allocations::live_bytes() - live);
+    value["allocations_per_request"] = per_request(allocated.count);
+    value["allocated_bytes_per_request"] = per_request(allocated.bytes);
+    value["resident_bytes"] = Json::UInt64(resident_bytes());
+
+    bench::Allocations::track_this_thread(false);
+
+    client->stop();
+    reactor.join();
+
+    std::cerr << std::left << std::setw(34) << ("footprint/" + std::to_string(in_flight)) << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(8) << connected << " connected"
+              << std::setw(11) << value["resident_bytes_per_request"].asDouble() << " B rss/req"
+              << std::setw(11) << value["heap_bytes_per_request"].asDouble() << " B heap/req"
+              << std::setw(8) << value["allocations_per_request"].asDouble() << " allocs/req"
+              << (*errors > 0 ? "  " + std::to_string(*errors) + " errors" : std::string{}) << std::endl;
+
+    return value;
+}
+
+// Serves requests from a child process, such that the server does not show up
+// in the memory of this process. The child is killed once this process exits.
+// Returns the port the child listens on.
+std::uint16_t serve_from_child(const httpbin::Options& options)
+{
+    int ready[2];
+    if (::pipe(ready) < 0)
+        throw std::system_error(errno, std::system_category(), "Could not create pipe");
+
+    auto pid = ::fork();
+    if (pid < 0)
+        throw std::system_error(errno, std::system_category(), "Could not fork");
+
+    if (pid == 0)
+    {
+        ::close(ready[0]);
+        ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+
+        httpbin::Instance instance{options};
+
+        auto port = instance.port();
+        if (::write(ready[1], &port, sizeof(port)) != sizeof(port))
+            ::_exit(1);
+
+        while (true)
+            ::pause();
+    }
+
+    ::close(ready[1]);
+
+    std::uint16_t port{0};
+    auto rc = ::read(ready[0], &port, sizeof(port));
+    ::close(ready[0]);
+
+    // The child closes its end without writing if it fails to listen.
+    if (rc != sizeof(port))
+        throw std::runtime_error("Could not start the local httpbin instance.");
+
+    return port;
+}
+
+std::string utc_now()
+{
+    auto now = std::time(nullptr);
+    std::tm tm;
+    gmtime_r(&now, &tm);
+
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &tm);
+
+    return buffer;
+}
+
+Settings parse(int argc, char** argv)
+{
+    Settings settings;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg{argv[i]};
+
+        auto equals = arg.find('=');
+        auto key = arg.substr(0, equals);
+        auto value = equals == std::string::npos ? std::string{} : arg.substr(equals + 1);
+
+        if (key == "--duration")
+            settings.duration = Seconds{std::stod(value)};
+        else if (key == "--warmup")
+            settings.warmup = Seconds{std::stod(value)};
+        else if (key == "--filter")
+            settings.filter = std::regex{value};
+        else if (key == "--output")
+            settings.output = value;
+        else if (key == "--port")
+            settings.port = static_cast<std::uint16_t>(std::stoul(value));
+        else if (key == "--server-threads")
+            settings.server_threads = std::stoul(value);
+        else if (key == "--list")
+            settings.list = true;
+        else if (key == "--open-loop")
+            settings.open_loop = true;
+        else if (key == "--arrivals" && (value == "constant" || value == "poisson"))
+            settings.ramp.arrivals = value == "constant" ? bench::Arrivals::constant : bench::Arrivals::poisson;
+        else if (key == "--start-rate")
+            settings.ramp.start_rate = std::stod(value);
+        else if (key == "--rate-factor")
+            settings.ramp.factor = std::stod(value);
+        else if (key == "--max-rate")
+            settings.ramp.max_rate = std::stod(value);
+        else if (key == "--p99-threshold")
+            settings.ramp.p99_threshold = Seconds{std::stod(value) / 1000.};
+        else if (key == "--seed")
+            settings.ramp.seed = std::stoull(value);
+        else if (key == "--footprint")
+        {
+            settings.footprint = true;
+
+            if (not value.empty())
+                settings.in_flight.clear();
+
+            for (std::size_t begin = 0; begin < value.size();)
+            {
+                auto end = std::min(value.find(',', begin), value.size());
+                settings.in_flight.push_back(std::stoul(value.substr(begin, end - begin)));
+                begin = end + 1;
+            }
+        }
+        else
+            throw std::invalid_argument("Unknown option: " + arg);
+    }
+
+    settings.ramp.step = settings.duration;
+
+    if (settings.ramp.start_rate <= 0 || settings.ramp.factor <= 1)
+        throw std::invalid_argument("The rate must start above 0 and rise from step to step.");
+
+    return settings;
+}
+
+// Returns the scenarios to run, or one scenario per workload when ramping up the rate.
+std::vector<Scenario> select(const Settings& settings)
+{
+    std::vector<Scenario> result;
+
+    for (const auto& scenario : scenarios())
+    {
+        auto name = settings.open_loop ? scenario.workload_name() : scenario.name();
+
+        auto seen = std::any_of(result.begin(), result.end(), [&name](const Scenario& s)
+        {
+            return s.workload_name() == name;
+        });
+
+        if (std::regex_search(name, settings.filter) && not (settings.open_loop && seen))
+            result.push_back(scenario);
+    }
+
+    return result;
+}
+}
+
+int main(int argc, char** argv)
+{
+    Settings settings;
+
+    try
+    {
+        settings = parse(argc, argv);
+    } catch (const std::exception& e)
+    {
+        std::cerr << e.what() << std::endl << usage;
+        return 1;
+    }
+
+    auto selected = select(settings);
+
+    if (settings.list)
+    {
+        for (const auto& scenario : selected)
+            std::cout << (settings.open_loop ? scenario.workload_name() : scenario.name()) << std::endl;
+        return 0;
+    }
+
+    // High concurrency needs plenty of descriptors, take all we can get.
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    httpbin::Options options;
+    options.port = settings.port;
+    options.threads = settings.server_threads;
+
+    std::unique_ptr<httpbin::Instance> instance;
+    std::string host;
+
+    if (settings.footprint)
+    {
+        // Must be enabled before any memory is handed out to the client.
+        bench::Allocations::track_live_bytes();
+        host = "http://127.0.0.1:" + std::to_string(serve_from_child(options));
+    } else
+    {
+        instance.reset(new httpbin::Instance{options});
+        host = instance->host();
+    }
+
+    Json::Value root;
+    root["net-cpp"] = NET_CPP_VERSION;
+    root["started"] = utc_now();
+    root["settings"]["duration_s"] = settings.duration.count();
+    root["settings"]["warmup_s"] = settings.warmup.count();
+    root["settings"]["server_threads"] = Json::UInt64(settings.server_threads);
+    root["settings"]["hardware_concurrency"] = std::thread::hardware_concurrency();
+
+    if (settings.footprint)
+    {
+        root["footprint"] = Json::Value(Json::arrayValue);
+
+        for (auto in_flight : settings.in_flight)
+            root["footprint"].append(run_footprint(in_flight, host));
+    } else if (settings.open_loop)
+    {
+        root["open_loop"] = Json::Value(Json::arrayValue);
+
+        for (const auto& scenario : selected)
+            root["open_loop"].append(run_open_loop(scenario, settings, host));
+    } else
+    {
+        root["scenarios"] = Json::Value(Json::arrayValue);
+
+        for (const auto& scenario : selected)
+        {
+            auto result = run(scenario, settings, host);
+            summarize(std::cerr, scenario, result);
+            root["scenarios"].append(to_json(scenario, result));
+        }
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    std::unique_ptr<Json::StreamWriter> writer{builder.newStreamWriter()};
+
+    if (settings.output.empty())
+    {
+        writer->write(root, &std::cout);
+        std::cout << std::endl;
+    } else
+    {
+        std::ofstream out{settings.output};
+        writer->write(root, &out);
+        out << std::endl;
+
+        if (not out)
+        {
+            std::cerr << "Could not write results to " << settings.output << std::endl;
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,555 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/base64.h>
+#include <core/net/percent_encoding.h>
+#include <core/net/uri.h>
+#include <core/net/url.h>
+#include <core/net/http/client.h>
+#include <core/net/http/event_stream.h>
+#include <core/net/http/header.h>
+#include <core/net/http/ndjson_stream.h>
+
+#include "core/net/http/impl/curl/request.h"
+#include "core/net/impl/base64.h"
+#include "core/net/impl/line_break.h"
+#include "core/net/impl/percent_encoding.h"
+
+#include "allocations.h"
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace http = core::net::http;
+namespace net = core::net;
+
+namespace
+{
+// The header lines of a typical response of a JSON API, as handed out by curl.
+const std::vector<std::string>& response_header_lines()
+{
+    static const std::vector<std::string> lines
+    {
+        "HTTP/1.1 200 OK\r\n",
+        "Date: Tue, 15 Nov 1994 08:12:31 GMT\r\n",
+        "Content-Type: application/json; charset=utf-8\r\n",
+        "Content-Length: 1432\r\n",
+        "Connection: keep-alive\r\n",
+        "Cache-Control: private, max-age=0, no-cache\r\n",
+        "ETag: W/\"598-sxwdmvVL2Rq0ySOjD7U1Ig\"\r\n",
+        "Vary: Accept-Encoding, Origin\r\n",
+        "X-Request-Id: 6f0c2a8e-93a1-4b8e-bb7e-1c5d4d6b2f10\r\n",
+        "Strict-Transport-Security: max-age=31536000; includeSubDomains\r\n",
+        "Set-Cookie: session=Q2hhbmdlIGlzIHRoZSBvbmx5IGNvbnN0YW50Lg; Path=/; HttpOnly; Secure\r\n",
+        "\r\n"
+    };
+
+    return lines;
+}
+
+std::size_t size_of(const std::vector<std::string>& strings)
+{
+    std::size_t result{0};
+    for (const auto& s : strings)
+        result += s.size();
+    return result;
+}
+
+// The field names of response_header_lines(), as spelled by servers in the wild.
+const std::vector<std::string>& field_names()
+{
+    static const std::vector<std::string> names
+    {
+        "date", "Content-Type", "content-length", "CONNECTION", "cache-control",
+        "etag", "Vary", "x-request-id", "strict-transport-security", "set-cookie"
+    };
+
+    return names;
+}
+
+// A path segment, a query value with reserved and non-ASCII characters, and an opaque token.
+const std::vector<std::string>& strings_to_escape()
+{
+    static const std::vector<std::string> strings
+    {
+        "orders",
+        "caf\xC3\xA9 & cr\xC3\xA8me br\xC3\xBBl\xC3\xA9""e/50% off?",
+        std::string(256, 'a') + "+/=" + std::string(256, 'Z')
+    };
+
+    return strings;
+}
+
+std::string random_bytes(std::size_t size)
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> byte{0, 255};
+
+    std::string result(size, '\0');
+    for (auto& c : result)
+        c = static_cast<char>(byte(rng));
+
+    return result;
+}
+
+const std::shared_ptr<http::Client>& client()
+{
+    static const auto instance = http::make_client();
+    return instance;
+}
+
+void parse_header_line(benchmark::State& state)
+{
+    const auto& lines = response_header_lines();
+
+    for (auto _ : state)
+        for (const auto& line : lines)
+            benchmark::DoNotOptimize(http::impl::curl::parse_header_line(line.data(), line.size()));
+
+    state.SetItemsProcessed(state.iterations() * lines.size());
+    state.SetBytesProcessed(state.iterations() * size_of(lines));
+}
+BENCHMARK(parse_header_line);
+
+void handle_header_line(benchmark::State& state)
+{
+    auto lines = response_header_lines();
+
+    for (auto _ : state)
+        for (auto& line : lines)
+            benchmark::DoNotOptimize(http::impl::curl::handle_header_line(&line[0], 1, line.size()));
+
+    state.SetItemsProcessed(state.iterations() * lines.size());
+    state.SetBytesProcessed(state.iterations() * size_of(lines));
+}
+BENCHMARK(handle_header_line);
+
+void header_canonicalize_key(benchmark::State& state)
+{
+    const auto& names = field_names();
+
+    for (auto _ : state)
+        for (const auto& name : names)
+            benchmark::DoNotOptimize(http::Header::canonicalize_key(name));
+
+    state.SetItemsProcessed(state.iterations() * names.size());
+    state.SetBytesProcessed(state.iterations() * size_of(names));
+}
+BENCHMARK(header_canonicalize_key);
+
+// Fills a header the way the response handler does, from the parsed lines of a response.
+void header_add(benchmark::State& state)
+{
+    std::vector<std::pair<std::string, std::string>> fields;
+    for (const auto& line : response_header_lines())
+    {
+        auto kv = http::impl::curl::parse_header_line(line.data(), line.size());
+        if (not std::get<0>(kv).empty())
+            fields.emplace_back(std::get<0>(kv), std::get<1>(kv));
+    }
+
+    for (auto _ : state)
+    {
+        http::Header header;
+        for (const auto& field : fields)
+            header.add(field.first, field.second);
+        benchmark::DoNotOptimize(header);
+    }
+
+    state.SetItemsProcessed(state.iterations() * fields.size());
+}
+BENCHMARK(header_add);
+
+void header_enumerate(benchmark::State& state)
+{
+    http::Header header;
+    for (const auto& line : response_header_lines())
+    {
+        auto kv = http::impl::curl::parse_header_line(line.data(), line.size());
+        if (not std::get<0>(kv).empty())
+            header.add(std::get<0>(kv), std::get<1>(kv));
+    }
+
+    std::size_t fields{0};
+
+    for (auto _ : state)
+    {
+        fields = 0;
+        header.enumerate([&fields](const std::string& key, const std::set<std::string>& values)
+        {
+            benchmark::DoNotOptimize(key.data());
+            fields += values.size();
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations() * fields);
+}
+BENCHMARK(header_enumerate);
+
+void client_url_escape(benchmark::State& state)
+{
+    const auto& s = strings_to_escape().at(state.range(0));
+    const auto& c = client();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c->url_escape(s));
+
+    state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(client_url_escape)->ArgName("string")->DenseRange(0, 2);
+
+// Registers strings_to_escape() with each kernel the CPU supports.
+void for_each_supported_isa_and_string(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"isa", "string"});
+
+    for (auto isa : net::impl::supported_isas())
+        for (std::size_t i = 0; i < strings_to_escape().size(); i++)
+            b->Args({static_cast<int>(isa), static_cast<int>(i)});
+}
+
+void percent_encode(benchmark::State& state)
+{
+    auto isa = static_cast<net::impl::Isa>(state.range(0));
+    const auto& s = strings_to_escape().at(state.range(1));
+
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        net::impl::percent_encoding::encode(s.data(), s.size(), out, net::percent_encoding::Component::unreserved, isa);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetLabel(net::impl::name_of(isa));
+    state.SetBytesProcessed(state.iterations() * s.size());
+}
+BENCHMARK(percent_encode)->Apply(for_each_supported_isa_and_string);
+
+void percent_decode(benchmark::State& state)
+{
+    auto isa = static_cast<net::impl::Isa>(state.range(0));
+    auto text = net::percent_encoding::encode(strings_to_escape().at(state.range(1)));
+
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        net::impl::percent_encoding::decode(text.data(), text.size(), out, net::percent_encoding::Component::unreserved, isa);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetLabel(net::impl::name_of(isa));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(percent_decode)->Apply(for_each_supported_isa_and_string);
+
+// A feed of events about 1KB in size, split up into chunks of size bytes like a network would.
+std::vector<std::string> event_stream_chunks(std::size_t size)
+{
+    std::string text;
+    for (int id = 0; id < 256; id++)
+        text += "id: " + std::to_string(id) + "\nevent: update\ndata: {\"id\": " + std::to_string(id) +
+                ", \"payload\": \"" + std::string(1000, 'x') + "\"}\n\n";
+
+    std::vector<std::string> chunks;
+    for (std::size_t i = 0; i < text.size(); i += size)
+        chunks.push_back(text.substr(i, size));
+
+    return chunks;
+}
+
+void find_line_break(benchmark::State& state)
+{
+    auto isa = static_cast<net::impl::Isa>(state.range(0));
+    std::string line(state.range(1), 'x');
+    line.push_back('\n');
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(net::impl::find_line_break(line.data(), line.size(), isa));
+
+    state.SetLabel(net::impl::name_of(isa));
+    state.SetBytesProcessed(state.iterations() * line.size());
+}
+BENCHMARK(find_line_break)->Apply([](benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"isa", "size"});
+
+    for (auto isa : net::impl::supported_isas())
+        for (auto size : {64, 1024, 64 * 1024})
+            b->Args({static_cast<int>(isa), size});
+});
+
+void event_stream_feed(benchmark::State& state)
+{
+    auto chunks = event_stream_chunks(state.range(0));
+
+    std::size_t events{0};
+    http::EventStream stream{[&events](const http::EventStream::Event& event)
+    {
+        benchmark::DoNotOptimize(event.data.data());
+        events++;
+    }};
+
+    for (auto _ : state)
+        for (const auto& chunk : chunks)
+            stream.feed(chunk);
+
+    state.SetBytesProcessed(state.iterations() * size_of(chunks));
+    state.counters["events"] = benchmark::Counter(events, benchmark::Counter::kIsRate);
+}
+BENCHMARK(event_stream_feed)->ArgName("chunk")->Arg(100)->Arg(1500)->Arg(16 * 1024);
+
+void ndjson_stream_feed(benchmark::State& state)
+{
+    auto chunks = event_stream_chunks(state.range(0));
+
+    std::size_t records{0};
+    http::NdjsonStream stream{[&records](const char* data, std::size_t)
+    {
+        benchmark::DoNotOptimize(data);
+        records++;
+    }};
+
+    for (auto _ : state)
+        for (const auto& chunk : chunks)
+            stream.feed(chunk);
+
+    state.SetBytesProcessed(state.iterations() * size_of(chunks));
+    state.counters["records"] = benchmark::Counter(records, benchmark::Counter::kIsRate);
+}
+BENCHMARK(ndjson_stream_feed)->ArgName("chunk")->Arg(100)->Arg(1500)->Arg(16 * 1024);
+
+void client_base64_encode(benchmark::State& state)
+{
+    auto data = random_bytes(state.range(0));
+    const auto& c = client();
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c->base64_encode(data));
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(client_base64_encode)->Arg(16)->Arg(1024)->Arg(64 * 1024);
+
+void client_base64_decode(benchmark::State& state)
+{
+    const auto& c = client();
+    auto data = c->base64_encode(random_bytes(state.range(0)));
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c->base64_decode(data));
+
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(client_base64_decode)->Arg(16)->Arg(1024)->Arg(64 * 1024);
+
+// Registers the sizes we encode/decode with each kernel the CPU supports.
+void for_each_supported_isa(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"isa", "alphabet", "size"});
+
+    for (auto isa : net::impl::supported_isas())
+        for (auto alphabet : {net::base64::Alphabet::standard, net::base64::Alphabet::url_safe})
+            for (auto size : {16, 1024, 64 * 1024, 1024 * 1024})
+                b->Args({static_cast<int>(isa), static_cast<int>(alphabet), size});
+}
+
+void base64_encode(benchmark::State& state)
+{
+    auto isa = static_cast<net::impl::Isa>(state.range(0));
+    auto alphabet = static_cast<net::base64::Alphabet>(state.range(1));
+    auto data = random_bytes(state.range(2));
+
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        net::impl::base64::encode(data.data(), data.size(), out, alphabet, true, isa);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetLabel(net::impl::name_of(isa));
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(base64_encode)->Apply(for_each_supported_isa);
+
+void base64_decode(benchmark::State& state)
+{
+    auto isa = static_cast<net::impl::Isa>(state.range(0));
+    auto alphabet = static_cast<net::base64::Alphabet>(state.range(1));
+    auto text = net::base64::encode(random_bytes(state.range(2)), alphabet);
+
+    std::string out;
+    for (auto _ : state)
+    {
+        out.clear();
+        net::impl::base64::decode(text.data(), text.size(), out, alphabet, isa);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetLabel(net::impl::name_of(isa));
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(base64_decode)->Apply(for_each_supported_isa);
+
+void client_uri_to_string(benchmark::State& state)
+{
+    net::Uri uri
+    {
+        "https://api.example.com",
+        {"v1", "users", "4711", "orders"},
+        {{"status", "open"}, {"since", "2014-01-01T00:00:00Z"}, {"q", "caf\xC3\xA9 latte"}}
+    };
+
+    const auto& c = client();
+    std::size_t size{0};
+
+    for (auto _ : state)
+    {
+        auto s = c->uri_to_string(uri);
+        size = s.size();
+        benchmark::DoNotOptimize(s);
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(client_uri_to_string);
+
+// A search API call with 40 query parameters, reporting the heap allocations per call.
+void client_uri_to_string_with_40_parameters(benchmark::State& state)
+{
+    net::Uri uri{"https://api.example.com", {"v1", "search"}, {}};
+    for (int i = 0; i < 40; i++)
+        uri.query_parameters.emplace_back("filter[" + std::to_string(i) + "]", "caf\xC3\xA9 & cr\xC3\xA8me " + std::to_string(i));
+
+    const auto& c = client();
+    std::size_t size{0};
+
+    auto before = bench::Allocations::of_this_thread();
+    for (auto _ : state)
+    {
+        auto s = c->uri_to_string(uri);
+        size = s.size();
+        benchmark::DoNotOptimize(s);
+    }
+    auto allocations = bench::Allocations::of_this_thread() - before;
+
+    state.counters["allocations"] = benchmark::Counter(allocations.count, benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(client_uri_to_string_with_40_parameters);
+
+// A typical REST call with 5 path segments and 10 query parameters.
+const net::Uri& typical_uri()
+{
+    static const net::Uri uri
+    {
+        "https://api.example.com",
+        {"v2", "stores", "4711", "products", "caf\xC3\xA9 latte"},
+        {
+            {"category", "beverages"}, {"sort", "price"}, {"order", "asc"}, {"limit", "50"},
+            {"offset", "100"}, {"since", "2014-01-01T00:00:00Z"}, {"q", "oat milk & honey"},
+            {"fields", "id,name,price"}, {"currency", "EUR"}, {"locale", "de_DE"}
+        }
+    };
+
+    return uri;
+}
+
+void typical_uri_to_string(benchmark::State& state)
+{
+    const auto& uri = typical_uri();
+    const auto& c = client();
+
+    auto before = bench::Allocations::of_this_thread();
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c->uri_to_string(uri));
+    auto allocations = bench::Allocations::of_this_thread() - before;
+
+    state.counters["allocations"] = benchmark::Counter(allocations.count, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(typical_uri_to_string);
+
+// Builds the same URL as typical_uri_to_string, reusing a single instance.
+void typical_url_build(benchmark::State& state)
+{
+    const auto& uri = typical_uri();
+    net::Url url;
+
+    auto before = bench::Allocations::of_this_thread();
+    for (auto _ : state)
+    {
+        url.assign(uri.host);
+        for (const auto& segment : uri.path)
+            url.append_path_segment(segment);
+        for (const auto& parameter : uri.query_parameters)
+            url.append_query_parameter(parameter.first, parameter.second);
+
+        benchmark::DoNotOptimize(url.c_str());
+    }
+    auto allocations = bench::Allocations::of_this_thread() - before;
+
+    state.counters["allocations"] = benchmark::Counter(allocations.count, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(typical_url_build);
+
+void typical_url_parse(benchmark::State& state)
+{
+    const auto& uri = typical_uri();
+    const auto text = client()->uri_to_string(uri);
+    net::Url url;
+
+    for (auto _ : state)
+    {
+        url.assign(text);
+        benchmark::DoNotOptimize(url.c_str());
+    }
+
+    state.SetBytesProcessed(state.iterations() * text.size());
+}
+BENCHMARK(typical_url_parse);
+
+// Includes creating the request, which is all that post_form does apart from building the body.
+void client_post_form(benchmark::State& state)
+{
+    std::map<std::string, std::string> values
+    {
+        {"grant_type", "password"},
+        {"username", "jane.doe@example.com"},
+        {"password", "c0rrect horse+battery&staple"},
+        {"scope", "read write"},
+        {"client_id", "6f0c2a8e-93a1-4b8e-bb7e-1c5d4d6b2f10"}
+    };
+
+    const auto& c = client();
+    auto configuration = http::Request::Configuration::from_uri_as_string("http://127.0.0.1/oauth/token");
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(c->post_form(configuration, values));
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(client_post_form);
+}
+
+BENCHMARK_MAIN();
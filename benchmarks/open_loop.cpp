@@ -0,0 +1,174 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "open_loop.h"
+
+#include <core/net/error.h>
+
+#include <sys/prctl.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace
+{
+typedef bench::Clock Clock;
+typedef bench::Seconds Seconds;
+
+// Hands out the points in time that requests are due at.
+class Schedule
+{
+public:
+    Schedule(bench::Arrivals arrivals, double rate, std::mt19937_64& rng, const Clock::time_point& start)
+        : arrivals(arrivals),
+          interval(1. / rate),
+          exponential(rate),
+          rng(rng),
+          due(start)
+    {
+    }
+
+    Clock::time_point next()
+    {
+        auto gap = arrivals == bench::Arrivals::constant ? interval : Seconds{exponential(rng)};
+        due += std::chrono::duration_cast<Clock::duration>(gap);
+
+        return due;
+    }
+
+private:
+    bench::Arrivals arrivals;
+    Seconds interval;
+    std::exponential_distribution<double> exponential;
+    std::mt19937_64& rng;
+    Clock::time_point due;
+};
+
+// The requests of a step that are in flight.
+struct Outstanding : public std::enable_shared_from_this<Outstanding>
+{
+    void issue(bench::http::Client& client, const bench::Workload& workload, const Clock::time_point& due)
+    {
+        {
+            std::lock_guard<std::mutex> lg(guard);
+            in_flight++;
+        }
+
+        auto self = shared_from_this();
+
+        // Handlers run on the reactor, one after another, so the tally needs no lock.
+        workload.make(client)->async_execute(
+                    bench::http::Request::Handler()
+                    .on_response([self, &workload, due](const bench::http::Response& response)
+                    {
+                        workload.record(self->tally, due, response);
+                        self->complete();
+                    })
+                    .on_error([self](const core::net::Error&)
+                    {
+                        self->tally.requests++;
+                        self->tally.errors++;
+                        self->complete();
+                    }));
+    }
+
+    void complete()
+    {
+        std::lock_guard<std::mutex> lg(guard);
+
+        last_completion = Clock::now();
+
+        if (--in_flight == 0)
+            drained.notify_all();
+    }
+
+    // Waits for all requests to complete.
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(guard);
+        drained.wait(lock, [this]() { return in_flight == 0; });
+    }
+
+    bench::Tally tally;
+
+    std::mutex guard;
+    std::condition_variable drained;
+    std::size_t in_flight{0};
+    Clock::time_point last_completion;
+};
+
+bench::Step run_step(
+        bench::http::Client& client,
+        pthread_t reactor,
+        const bench::Workload& workload,
+        bench::Arrivals arrivals,
+        double rate,
+        const Seconds& duration,
+        std::mt19937_64& rng)
+{
+    auto outstanding = std::make_shared<Outstanding>();
+
+    auto cpu = bench::cpu_time_of(reactor) + bench::cpu_time_of(pthread_self());
+    auto start = Clock::now();
+    auto end = start + std::chrono::duration_cast<Clock::duration>(duration);
+
+    Schedule schedule{arrivals, rate, rng, start};
+
+    for (auto due = schedule.next(); due < end; due = schedule.next())
+    {
+        // Requests that are overdue go out right away, their latency
+        // includes the time they should have been sent already.
+        std::this_thread::sleep_until(due);
+        outstanding->issue(client, workload, due);
+    }
+
+    outstanding->wait();
+
+    bench::Step step;
+    step.offered_rate = rate;
+    step.tally = outstanding->tally;
+    step.elapsed = std::max(outstanding->last_completion, end) - start;
+    step.cpu = bench::cpu_time_of(reactor) + bench::cpu_time_of(pthread_self()) - cpu;
+
+    return step;
+}
+}
+
+std::vector<bench::Step> bench::ramp_up(http::Client& client, pthread_t reactor, const Workload& workload, const Ramp& ramp)
+{
+    std::vector<Step> steps;
+    std::mt19937_64 rng{ramp.seed};
+
+    // The default slack of 50µs would delay requests past their schedule.
+    prctl(PR_SET_TIMERSLACK, 1);
+
+    for (auto rate = ramp.start_rate; rate <= ramp.max_rate; rate *= ramp.factor)
+    {
+        steps.push_back(run_step(client, reactor, workload, ramp.arrivals, rate, ramp.step, rng));
+
+        const auto& tally = steps.back().tally;
+
+        if (tally.errors > 0 || tally.latencies.count() == 0 || tally.latencies.percentile(99) > ramp.p99_threshold)
+            break;
+    }
+
+    return steps;
+}
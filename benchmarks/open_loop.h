@@ -0,0 +1,77 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef BENCHMARKS_OPEN_LOOP_H_
+#define BENCHMARKS_OPEN_LOOP_H_
+
+#include "workload.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace bench
+{
+// How the send times of requests are spread out.
+enum class Arrivals
+{
+    // Requests are sent at a fixed interval.
+    constant,
+    // Intervals are drawn from an exponential distribution, as for independent users.
+    poisson
+};
+
+// Describes how the offered rate is raised from step to step.
+struct Ramp
+{
+    Arrivals arrivals{Arrivals::poisson};
+    // Offered rate of the first step, in requests per second.
+    double start_rate{100};
+    // Factor the offered rate is multiplied with for the next step.
+    double factor{1.5};
+    // The ramp ends after the step reaching this rate.
+    double max_rate{1e6};
+    // Time every step offers its rate for.
+    Seconds step{2};
+    // The ramp ends after the first step with a p99 above the threshold.
+    Seconds p99_threshold{0.1};
+    // Seeds the random intervals of Poisson arrivals.
+    std::uint64_t seed{42};
+};
+
+// The measurements at a single offered rate.
+struct Step
+{
+    double offered_rate;
+    Tally tally;
+    // Time from the start of the step until the last response arrived.
+    Seconds elapsed{0};
+    // CPU time spent by the client, excluding the threads serving requests.
+    Seconds cpu{0};
+};
+
+// Sends requests at the offered rate of every step, independent of how fast
+// responses arrive, and measures latencies from the time a request was scheduled
+// to be sent. Thus, stalls of the client or the server show up in the latencies of
+// all requests that were due while stalled, avoiding coordinated omission.
+//
+// The offered rate is raised until the p99 exceeds the threshold, requests fail or
+// the maximum rate has been offered. Requests are issued from the calling thread,
+// completions are handled by the client running on reactor.
+std::vector<Step> ramp_up(http::Client& client, pthread_t reactor, const Workload& workload, const Ramp& ramp);
+}
+
+#endif // BENCHMARKS_OPEN_LOOP_H_
@@ -0,0 +1,144 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "workload.h"
+
+#include "httpbin.h"
+
+#include <time.h>
+
+#include <stdexcept>
+
+void bench::Tally::merge(const Tally& rhs)
+{
+    latencies.merge(rhs.latencies);
+    requests += rhs.requests;
+    errors += rhs.errors;
+    bytes += rhs.bytes;
+    created += rhs.created;
+    executed += rhs.executed;
+}
+
+std::string bench::Scenario::name() const
+{
+    return std::string{name_of(method)} + "/" + size_to_string(body_size) + "/c" + std::to_string(concurrency) +
+            (keep_alive ? "/keep-alive" : "/fresh") + (mode == Mode::async ? "/async" : "/sync");
+}
+
+std::string bench::Scenario::workload_name() const
+{
+    return std::string{name_of(method)} + "/" + size_to_string(body_size) + (keep_alive ? "/keep-alive" : "/fresh");
+}
+
+std::shared_ptr<bench::http::Request> bench::Workload::make(http::Client& client) const
+{
+    auto configuration = http::Request::Configuration::from_uri_as_string(uri);
+
+    if (not scenario.keep_alive)
+        configuration.header.set("Connection", "close");
+
+    switch (scenario.method)
+    {
+    case http::Method::get: return client.get(configuration);
+    case http::Method::head: return client.head(configuration);
+    case http::Method::post: return client.post(configuration, payload, "application/octet-stream");
+    case http::Method::put: return client.put(configuration, payload);
+    case http::Method::del: return client.del(configuration);
+    }
+
+    throw std::logic_error("Unknown method.");
+}
+
+void bench::Workload::record(Tally& tally, const Clock::time_point& started, const http::Response& response) const
+{
+    tally.requests++;
+
+    if (response.status != http::Status::ok)
+    {
+        tally.errors++;
+        return;
+    }
+
+    tally.latencies.record(Clock::now() - started);
+    tally.bytes += response.body.size() + payload->size();
+}
+
+bench::Workload bench::workload_for(const Scenario& scenario, const std::string& host)
+{
+    std::string resource;
+
+    switch (scenario.method)
+    {
+    case http::Method::get:
+    case http::Method::head:
+        resource = httpbin::resources::bytes(scenario.body_size);
+        break;
+    case http::Method::post:
+    case http::Method::put:
+        // Uploads end up in a sink, such that the response does not echo the body.
+        resource = httpbin::resources::status(200);
+        break;
+    case http::Method::del:
+        resource = httpbin::resources::del();
+        break;
+    }
+
+    auto upload = scenario.method == http::Method::post || scenario.method == http::Method::put;
+
+    return Workload
+    {
+        scenario,
+        host + resource,
+        std::make_shared<const std::string>(upload ? scenario.body_size : 0, 'x')
+    };
+}
+
+const char* bench::name_of(http::Method method)
+{
+    switch (method)
+    {
+    case http::Method::get: return "get";
+    case http::Method::head: return "head";
+    case http::Method::post: return "post";
+    case http::Method::put: return "put";
+    case http::Method::del: return "delete";
+    }
+
+    return "unknown";
+}
+
+std::string bench::size_to_string(std::size_t size)
+{
+    if (size >= MiB && size % MiB == 0)
+        return std::to_string(size / MiB) + "MiB";
+    if (size >= KiB && size % KiB == 0)
+        return std::to_string(size / KiB) + "KiB";
+
+    return std::to_string(size) + "B";
+}
+
+bench::Seconds bench::cpu_time_of(pthread_t thread)
+{
+    clockid_t clock;
+    timespec ts;
+
+    if (pthread_getcpuclockid(thread, &clock) != 0 || clock_gettime(clock, &ts) != 0)
+        throw std::runtime_error("Could not query the CPU time of a thread.");
+
+    return Seconds{ts.tv_sec + ts.tv_nsec / 1e9};
+}
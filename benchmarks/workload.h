@@ -0,0 +1,118 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef BENCHMARKS_WORKLOAD_H_
+#define BENCHMARKS_WORKLOAD_H_
+
+#include "allocations.h"
+
+#include <core/net/http/client.h>
+#include <core/net/http/histogram.h>
+#include <core/net/http/method.h>
+#include <core/net/http/request.h>
+#include <core/net/http/response.h>
+
+#include <pthread.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace bench
+{
+namespace http = core::net::http;
+
+typedef std::chrono::steady_clock Clock;
+typedef std::chrono::duration<double> Seconds;
+
+constexpr const std::size_t KiB{1024};
+constexpr const std::size_t MiB{1024 * KiB};
+
+// Whether requests block the calling thread or are carried out by the reactor.
+enum class Mode
+{
+    sync,
+    async
+};
+
+// A combination of request type and load, measured in isolation.
+struct Scenario
+{
+    http::Method method;
+    // Size of the response body for GET and HEAD, of the request body for POST and PUT.
+    std::size_t body_size;
+    // Number of requests in flight at any point in time.
+    std::size_t concurrency;
+    // If false, every request sends Connection: close and pays for connection setup.
+    bool keep_alive;
+    Mode mode;
+
+    // Returns the name of the scenario, e.g., get/1KiB/c10/keep-alive/async.
+    std::string name() const;
+    // Returns the name of the requests of the scenario, e.g., get/1KiB/keep-alive.
+    std::string workload_name() const;
+};
+
+// The outcome of requests, accumulated by a single thread.
+struct Tally
+{
+    void merge(const Tally& rhs);
+
+    http::Histogram latencies;
+    std::uint64_t requests{0};
+    std::uint64_t errors{0};
+    std::uint64_t bytes{0};
+
+    // Allocations on the issuing thread while creating requests, e.g., by Client::get,
+    // and while executing them, i.e., by Request::async_execute or Request::execute.
+    Allocations created{};
+    Allocations executed{};
+};
+
+// Creates the requests of a scenario.
+struct Workload
+{
+    std::shared_ptr<http::Request> make(http::Client& client) const;
+
+    // Accounts for a completed request, with its latency measured from the given point in time.
+    void record(Tally& tally, const Clock::time_point& started, const http::Response& response) const;
+
+    Scenario scenario;
+    std::string uri;
+    // Shared by all requests, such that uploads do not copy it.
+    std::shared_ptr<const std::string> payload;
+};
+
+// Returns the workload of scenario, against the httpbin instance at host.
+Workload workload_for(const Scenario& scenario, const std::string& host);
+
+const char* name_of(http::Method method);
+
+// Returns size in a human-readable form, e.g., 64KiB.
+std::string size_to_string(std::size_t size);
+
+// Returns the CPU time consumed by thread so far.
+Seconds cpu_time_of(pthread_t thread);
+
+inline double in_microseconds(const Seconds& seconds)
+{
+    return seconds.count() * 1e6;
+}
+}
+
+#endif // BENCHMARKS_WORKLOAD_H_
@@ -0,0 +1,117 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_BASE64_H_
+#define CORE_NET_BASE64_H_
+
+#include <core/net/error.h>
+#include <core/net/visibility.h>
+
+#include <cstddef>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+/**
+ * @brief Base64 encoding and decoding as specified in RFC 4648.
+ *
+ * The implementation selects vectorized kernels matching the capabilities
+ * of the CPU at runtime and falls back to a table-driven scalar
+ * implementation everywhere else.
+ */
+namespace base64
+{
+/** @brief The alphabets defined in RFC 4648. */
+enum class Alphabet
+{
+    /** Section 4, using '+' and '/' for the values 62 and 63. */
+    standard,
+    /** Section 5, using '-' and '_', suitable for URLs and file names. */
+    url_safe
+};
+
+/** @brief Summarizes all errors raised when decoding base64 text. */
+struct CORE_NET_DLL_PUBLIC Errors
+{
+    Errors() = delete;
+
+    /**
+     * @brief Thrown if the text to decode is not valid base64, i.e., it contains a
+     * symbol outside of the alphabet, misplaced padding, a truncated quantum or
+     * non-zero trailing bits.
+     */
+    struct Malformed : public core::net::Error
+    {
+        Malformed(const std::string& what, const core::Location& loc);
+    };
+};
+
+/**
+ * @brief Encodes the given data.
+ * @param data The binary data to encode.
+ * @param alphabet The alphabet to encode with.
+ * @param padded Whether to complete the final quantum with '='.
+ * @return The encoded text.
+ */
+CORE_NET_DLL_PUBLIC std::string encode(
+        const std::string& data,
+        Alphabet alphabet = Alphabet::standard,
+        bool padded = true);
+
+/**
+ * @brief Encodes size bytes of data, appending the text to out.
+ *
+ * out is grown exactly once, making this overload suitable for
+ * assembling larger documents in a reused buffer.
+ */
+CORE_NET_DLL_PUBLIC void encode(
+        const char* data,
+        std::size_t size,
+        std::string& out,
+        Alphabet alphabet = Alphabet::standard,
+        bool padded = true);
+
+/**
+ * @brief Decodes the given text.
+ *
+ * Padding is optional, but validated if present.
+ *
+ * @param text The base64 text to decode.
+ * @param alphabet The alphabet the text has been encoded with.
+ * @throw Errors::Malformed if text is not valid base64.
+ * @return The decoded data.
+ */
+CORE_NET_DLL_PUBLIC std::string decode(
+        const std::string& text,
+        Alphabet alphabet = Alphabet::standard);
+
+/**
+ * @brief Decodes size bytes of text, appending the data to out.
+ * @throw Errors::Malformed if text is not valid base64, leaving out unchanged.
+ */
+CORE_NET_DLL_PUBLIC void decode(
+        const char* text,
+        std::size_t size,
+        std::string& out,
+        Alphabet alphabet = Alphabet::standard);
+}
+}
+}
+
+#endif // CORE_NET_BASE64_H_
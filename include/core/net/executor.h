@@ -0,0 +1,81 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_EXECUTOR_H_
+#define CORE_NET_EXECUTOR_H_
+
+#include <core/net/visibility.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace core
+{
+namespace net
+{
+/**
+ * @brief The Executor class abstracts the execution of tasks off the calling thread,
+ * e.g., by a pool of threads or by the event loop of an application.
+ */
+class CORE_NET_DLL_PUBLIC Executor
+{
+public:
+    /** @brief A unit of work. */
+    typedef std::function<void()> Task;
+
+    Executor(const Executor&) = delete;
+    virtual ~Executor() = default;
+
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Schedules task for execution and returns without waiting for it.
+     *
+     * Has to be safe to call from any thread and must never execute task inline.
+     * Exceptions escaping task are swallowed by the executors provided by this library.
+     */
+    virtual void post(const Task& task) = 0;
+
+protected:
+    Executor() = default;
+};
+
+/**
+ * @brief Creates an executor running tasks on a fixed number of threads.
+ *
+ * Every thread works off a queue of its own and steals from the queues of the
+ * other threads when it runs out of tasks, hence tasks are not necessarily started
+ * in order of submission. Destroying the executor waits for all tasks that have
+ * been posted so far to complete.
+ *
+ * @param threads The number of threads, at least 1.
+ * @throw std::invalid_argument if threads is 0.
+ */
+CORE_NET_DLL_PUBLIC std::shared_ptr<Executor> make_thread_pool_executor(std::size_t threads);
+
+/**
+ * @brief Returns an executor shared by the whole process, with one thread per core.
+ *
+ * The executor is created on first use and is a good fit for
+ * http::Client::Configuration::callbacks.
+ */
+CORE_NET_DLL_PUBLIC std::shared_ptr<Executor> default_executor();
+}
+}
+
+#endif // CORE_NET_EXECUTOR_H_
@@ -19,14 +19,22 @@
 #ifndef CORE_NET_HTTP_CLIENT_H_
 #define CORE_NET_HTTP_CLIENT_H_
 
+#include <core/net/executor.h>
 #include <core/net/visibility.h>
 
+#include <core/net/http/form.h>
+#include <core/net/http/histogram.h>
 #include <core/net/http/method.h>
 #include <core/net/http/request.h>
 
 #include <chrono>
+#include <cstdint>
+#include <functional>
 #include <iosfwd>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace core
 {
@@ -73,6 +81,8 @@ public:
             Seconds mean{Seconds::max()};
             /** Variance in duration that was encountered. */
             Seconds variance{Seconds::max()};
+            /** Distribution of durations, for querying percentiles like the p99. */
+            Histogram histogram{};
         };
 
         /** Time it took from the start until the name resolving was completed. */
@@ -93,6 +103,364 @@ public:
         Statistics total{};
     };
 
+    /** @brief Describes a user callback that blocked the reactor for longer than configured. */
+    struct SlowCallback
+    {
+        /** @brief Enumerates the callbacks invoked on the reactor. */
+        enum class Kind
+        {
+            /** A StreamingRequest::DataHandler receiving a chunk of the body. */
+            data,
+            /** A Request::ProgressHandler. */
+            progress,
+            /** A Request::ResponseHandler. */
+            response,
+            /** An error handler. */
+            error
+        };
+
+        /** The kind of callback. */
+        Kind kind{Kind::data};
+        /** Time the callback blocked the reactor. */
+        std::chrono::duration<double> duration{0};
+        /** The effective URI of the transfer the callback was invoked for. */
+        std::string uri;
+    };
+
+    /** @brief Marks a step in the life of a request, as reported to an Observer. */
+    struct TraceEvent
+    {
+        /** @brief Enumerates the steps, in the order they are passed. */
+        enum class Kind
+        {
+            /** The request has been created. */
+            created,
+            /** The request has been handed to the transfer engine for execution. */
+            queued,
+            /** Resolving the host name started. */
+            name_look_up_started,
+            /** Resolving the host name finished. */
+            name_look_up_finished,
+            /** The connection to the remote end has been established. */
+            connected,
+            /** The TLS handshake finished. */
+            tls_established,
+            /** The first byte of the response arrived. */
+            first_byte,
+            /** A chunk of the body arrived, only reported if enabled in Configuration::tracing. */
+            chunk,
+            /** The transfer completed with a response. */
+            completed,
+            /** The transfer failed. */
+            errored,
+            /** The request let go of its transfer and will not report any further events. */
+            released
+        };
+
+        /** The step passed. */
+        Kind kind{Kind::created};
+        /** The point in time the step has been passed at. */
+        std::chrono::steady_clock::time_point when;
+        /** Identifies the request, unique per client. */
+        std::uint64_t request{0};
+        /** Identifies the handle carrying out the transfer, may be reused once released. */
+        std::uint64_t handle{0};
+        /** The size of the chunk in bytes, 0 for all other kinds. */
+        std::size_t size{0};
+    };
+
+    /**
+     * @brief Receives the TraceEvents of all requests of a client, see Configuration::tracing.
+     *
+     * Events are reported on the thread passing the step, i.e., the reactor for asynchronous
+     * requests and the calling thread for synchronous ones. Steps of connection setup are
+     * reported once the connection is ready, stamped with the time they were passed at. They
+     * are skipped if the request is sent over a connection that has been kept alive.
+     */
+    class Observer
+    {
+    public:
+        virtual ~Observer() = default;
+
+        /** @brief Invoked for every event, should return quickly and must not throw. */
+        virtual void on_event(const TraceEvent& event) = 0;
+    };
+
+    /** @brief Summarizes the options for creating a client instance. */
+    struct Configuration
+    {
+        /**
+         * Options for caching responses in memory, see RFC 7234. A single response is
+         * kept per URI: a response varying on header fields of the request, see Vary,
+         * only answers requests with the same values, and replaces the response
+         * stored for any other values.
+         */
+        struct
+        {
+            /**
+             * Upper bound in bytes on the responses kept in the cache. Least
+             * recently used responses are evicted to stay below the bound.
+             * Caching in memory is disabled if 0.
+             */
+            std::size_t capacity
+            {
+                0
+            };
+
+            /**
+             * Options for persisting responses on disk, such that they survive
+             * restarts of the process. Responses with bodies of at least threshold
+             * bytes go to disk, smaller ones are kept in memory if capacity is
+             * not 0. Cached bodies are read from disk in chunks when serving them,
+             * each chunk being handed to the DataHandler as soon as it is read. As for
+             * responses received from the network, the body is accumulated in
+             * Response::body as well, so serving it takes memory for the whole body.
+             * Responses are written to disk in the background, never delaying their
+             * delivery. Responses read from disk stay there if the threshold is raised.
+             */
+            struct
+            {
+                /**
+                 * Directory holding the cache, created if it does not exist. It is
+                 * locked for use by a single client, creating a client for a directory
+                 * that is in use throws std::system_error. Caching to disk is disabled if empty.
+                 */
+                std::string directory;
+
+                /**
+                 * Upper bound in bytes on the responses kept on disk. Least recently used
+                 * responses are evicted to stay below the bound, and the space they occupied
+                 * is reclaimed in the background. Caching to disk is disabled if 0.
+                 */
+                std::uint64_t capacity
+                {
+                    0
+                };
+
+                /** Minimum size in bytes of a response body to be kept on disk. */
+                std::uint64_t threshold
+                {
+                    64 * 1024
+                };
+            } disk;
+        } cache;
+
+        /** Options for sharing transfers between identical requests. */
+        struct
+        {
+            /**
+             * If true, GET and HEAD requests for the same URI with identical header
+             * fields that are executed while one of them is in flight share its
+             * transfer: they receive all of its chunks and its response or error.
+             * Requests relying on an authentication handler are never shared, and
+             * neither are requests with a timeout or a speed limit, which carry out a
+             * transfer of their own. Only the request carrying out a shared transfer
+             * reports its progress, the progress handlers of the requests sharing it
+             * are never invoked, so these cannot abort it either. Pausing a request
+             * that shares the transfer of another one has no effect.
+             */
+            bool enabled
+            {
+                false
+            };
+
+            /**
+             * Upper bound in bytes on the chunks a shared transfer keeps around to replay
+             * them to requests joining late. Once a transfer received more, identical
+             * requests carry out a transfer of their own instead of joining it.
+             */
+            std::size_t replay_limit
+            {
+                1024 * 1024
+            };
+        } coalescing;
+
+        /** Options for collecting metrics, see endpoint_metrics(). */
+        struct
+        {
+            /**
+             * Upper bound on the number of endpoints, i.e., combinations of origin
+             * and route, that metrics are broken down by. Requests to endpoints beyond
+             * the bound are accounted for in a single overflow series. Every endpoint
+             * occupies roughly 110KiB. Breaking down metrics is disabled if 0.
+             */
+            std::size_t endpoints
+            {
+                0
+            };
+        } metrics;
+
+        /** Options for monitoring the health of the reactor, see reactor_statistics(). */
+        struct
+        {
+            /**
+             * Interval of the probe that measures the lag of the event loop, i.e.,
+             * how late a timer fires compared to its schedule. Disabled if 0.
+             */
+            std::chrono::milliseconds probe_interval
+            {
+                0
+            };
+
+            /**
+             * User callbacks invoked on the reactor that take longer than the threshold are
+             * counted as slow and reported to on_slow_callback. Disabled if 0.
+             */
+            std::chrono::microseconds slow_callback_threshold
+            {
+                0
+            };
+
+            /**
+             * Invoked on the reactor right after a slow callback returned. It blocks
+             * the reactor itself, so it should hand off the report and return quickly.
+             */
+            std::function<void(const SlowCallback&)> on_slow_callback;
+        } reactor;
+
+        /** Options for invoking the callbacks of asynchronous requests. */
+        struct
+        {
+            /**
+             * If set, responses and errors are delivered on the executor instead of the
+             * reactor, such that network I/O carries on while handlers run. Callbacks of
+             * a single request are delivered in order, one after another. Progress handlers
+             * always run on the reactor, as their result steers the transfer.
+             * core::net::default_executor() spreads handlers across all cores.
+             */
+            std::shared_ptr<core::net::Executor> executor;
+
+            /**
+             * If true, chunks handed to a StreamingRequest::DataHandler are delivered on the
+             * executor, too. Chunks are buffered until delivered, the transfer does not wait.
+             */
+            bool chunks
+            {
+                false
+            };
+        } callbacks;
+
+        /** Options for tracing requests. */
+        struct
+        {
+            /**
+             * Receives the events of all requests if set. Tracing has no
+             * overhead apart from checking for an observer if not set.
+             */
+            std::shared_ptr<Observer> observer;
+
+            /** If true, arriving chunks of the body are reported, too. */
+            bool chunks
+            {
+                false
+            };
+        } tracing;
+    };
+
+    /** @brief Summarizes the requests to a single endpoint, see Configuration::metrics. */
+    struct EndpointMetrics
+    {
+        /** Scheme, host and port that requests ended up at, e.g., "https://example.com:443". */
+        std::string origin;
+        /** Route label of the requests, see Request::Configuration::route. */
+        std::string route;
+        /** True for the series covering all endpoints beyond the bound, with empty origin and route. */
+        bool overflow{false};
+
+        /** Number of completed requests, including failed ones. */
+        std::uint64_t requests{0};
+
+        /** Number of responses by class of status code. */
+        struct
+        {
+            std::uint64_t informational{0};
+            std::uint64_t success{0};
+            std::uint64_t redirection{0};
+            std::uint64_t client_error{0};
+            std::uint64_t server_error{0};
+        } responses;
+
+        /** Number of requests that failed without a response, keyed by CURLcode. */
+        std::map<int, std::uint64_t> errors;
+
+        /** Number of bytes sent, including request lines and headers. */
+        std::uint64_t bytes_sent{0};
+        /** Number of bytes received, including status lines and headers. */
+        std::uint64_t bytes_received{0};
+
+        /** Timing statistics over the requests to the endpoint. */
+        Timings timings;
+    };
+
+    /** @brief Summarizes the transfers carried out by a client. */
+    struct TransferStatistics
+    {
+        /** Number of transfers currently carried out. */
+        std::uint64_t in_flight{0};
+        /** Number of completed transfers, including failed ones. */
+        std::uint64_t completed{0};
+        /** Number of connections opened to carry out transfers. */
+        std::uint64_t connections_opened{0};
+        /** Number of transfers carried out on a connection kept alive from a previous transfer. */
+        std::uint64_t connections_reused{0};
+        /**
+         * Share of transfers carried out on a kept-alive connection, out of all connections
+         * used for transfers, in [0, 1]. The main signal for tuning pool sizes and keep-alive.
+         */
+        double connection_reuse_ratio{0};
+        /**
+         * Number of transfers that opened a connection without resolving the name of the host,
+         * as it was still present in the DNS cache. libcurl does not report cache hits, they are
+         * derived from the hosts resolved within the lifetime of cache entries.
+         */
+        std::uint64_t dns_cache_hits{0};
+        /** Number of bytes sent, including request lines and headers. */
+        std::uint64_t bytes_sent{0};
+        /** Number of bytes received, including status lines and headers. */
+        std::uint64_t bytes_received{0};
+        /** Number of transfers that failed without a response, keyed by CURLcode. */
+        std::map<int, std::uint64_t> errors;
+    };
+
+    /**
+     * @brief Summarizes the health of the reactor carrying out the transfers of a client.
+     *
+     * User callbacks run inline on the reactor, so a slow handler stalls every transfer.
+     * Synchronous requests run their callbacks on the calling thread and are not covered.
+     */
+    struct ReactorStatistics
+    {
+        /** Delay of the probe behind its schedule, empty unless enabled in Configuration::reactor. */
+        Histogram loop_lag{};
+        /** Time spent in user callbacks on the reactor, per transfer. */
+        Histogram callbacks{};
+        /** Number of user callbacks that took longer than Configuration::reactor.slow_callback_threshold. */
+        std::uint64_t slow_callbacks{0};
+        /** Number of tasks currently queued for execution on the reactor. */
+        std::uint64_t queued_tasks{0};
+        /** Number of tasks queued for execution on the reactor so far. */
+        std::uint64_t dispatched_tasks{0};
+        /** Number of sockets currently watched by the reactor. */
+        std::uint64_t active_sockets{0};
+    };
+
+    /** @brief Summarizes the performance of the response cache of a client. */
+    struct CacheStatistics
+    {
+        /** Number of requests answered from the cache, including revalidated responses. */
+        std::uint64_t hits{0};
+        /** Number of requests that had to be answered by the origin server. */
+        std::uint64_t misses{0};
+        /** Number of stale responses that the origin server confirmed with a 304. */
+        std::uint64_t revalidations{0};
+        /** Number of responses evicted to make room for others. */
+        std::uint64_t evictions{0};
+        /** Number of responses currently in the cache. */
+        std::size_t entries{0};
+        /** Number of bytes currently occupied by the cache. */
+        std::size_t size{0};
+    };
+
     Client(const Client&) = delete;
     virtual ~Client() = default;
 
@@ -107,12 +475,51 @@ public:
     /** @brief Base64-encodes the given string. */
     virtual std::string base64_encode(const std::string& s) const = 0;
 
-    /** @brief Base64-decodes the given string. */
+    /**
+     * @brief Base64-decodes the given string.
+     *
+     * Input is validated strictly, see core::net::base64::decode. In particular, text
+     * with symbols outside of the alphabet, misplaced padding or non-zero trailing bits
+     * is rejected, whereas earlier versions of this library decoded it leniently.
+     *
+     * @throw core::net::base64::Errors::Malformed if s is not valid base64.
+     */
     virtual std::string base64_decode(const std::string& s) const = 0;
 
     /** @brief Queries timing statistics over all requests that have been executed by this client. */
     virtual Timings timings() = 0;
 
+    /**
+     * @brief Queries timing statistics like timings() and starts over with empty statistics,
+     * such that every request is accounted for in exactly one snapshot.
+     */
+    Timings reset_timings();
+
+    /**
+     * @brief Queries metrics broken down by endpoint, empty unless enabled in Configuration::metrics.
+     * Counters are cumulative over the lifetime of the client.
+     */
+    std::vector<EndpointMetrics> endpoint_metrics();
+
+    /** @brief Queries counters over all transfers carried out by this client. */
+    TransferStatistics transfer_statistics();
+
+    /** @brief Queries statistics about the health of the reactor of this client. */
+    ReactorStatistics reactor_statistics();
+
+    /** @brief Queries statistics about the response cache of this client. */
+    CacheStatistics cache_statistics();
+
+    /**
+     * @brief Renders all metrics of this client in the OpenMetrics text format.
+     *
+     * Covers transfer statistics, the reactor, the cache, timing histograms of all
+     * transfer phases and, if enabled, the metrics broken down by endpoint. Histograms
+     * are rendered with a fixed set of bucket bounds from 100µs to 60s. The output
+     * ends with "# EOF", such that it can be handed out to scrapers as is.
+     */
+    void write_metrics(std::ostream& out);
+
     /** @brief Execute the client and any impl-specific thread-pool or runtime. */
     virtual void run() = 0;
 
@@ -182,12 +589,82 @@ public:
      */
     std::shared_ptr<Request> del(const Request::Configuration& configuration);
 
+    /**
+     * @brief post is a convenience method for issuing a POST request for the given URI.
+     *
+     * The request takes ownership of the payload and hands it to the network
+     * layer without copying it.
+     *
+     * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+     * @param configuration The configuration to issue a post request for.
+     * @param payload The data to be transmitted as part of the POST request.
+     * @param type The content-type of the data.
+     * @return An executable instance of class Request.
+     */
+    std::shared_ptr<Request> post(const Request::Configuration& configuration, std::string&& payload, const std::string& type);
+
+    /**
+     * @brief post is a convenience method for issuing a POST request for the given URI.
+     *
+     * The request shares ownership of the immutable payload and hands it to the
+     * network layer without copying it.
+     *
+     * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+     * @param configuration The configuration to issue a post request for.
+     * @param payload The data to be transmitted as part of the POST request.
+     * @param type The content-type of the data.
+     * @return An executable instance of class Request.
+     */
+    std::shared_ptr<Request> post(const Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload, const std::string& type);
+
+    /**
+     * @brief put is a convenience method for issuing a PUT request for the given URI.
+     *
+     * The request takes ownership of the payload and uploads it straight from
+     * the buffer, without an intermediate stream.
+     *
+     * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+     * @param configuration The configuration to issue a put request for.
+     * @param payload The data to be transmitted as part of the PUT request.
+     * @return An executable instance of class Request.
+     */
+    std::shared_ptr<Request> put(const Request::Configuration& configuration, std::string&& payload);
+
+    /**
+     * @brief put is a convenience method for issuing a PUT request for the given URI.
+     *
+     * The request shares ownership of the immutable payload and uploads it
+     * straight from the buffer, without an intermediate stream.
+     *
+     * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+     * @param configuration The configuration to issue a put request for.
+     * @param payload The data to be transmitted as part of the PUT request.
+     * @return An executable instance of class Request.
+     */
+    std::shared_ptr<Request> put(const Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload);
+
+    /**
+     * @brief post_form is a convenience method for issuing a POST request for the given URI, with the body of form.
+     *
+     * The body is generated while uploading it, such that neither fields nor
+     * files end up in memory as a whole.
+     *
+     * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+     * @param configuration The configuration to issue a post request for.
+     * @param form The fields and files to be transmitted as part of the POST request.
+     * @return An executable instance of class Request.
+     */
+    std::shared_ptr<Request> post_form(const Request::Configuration& configuration, const Form& form);
+
 protected:
     Client() = default;
 };
 
 /** @brief Dispatches to the default implementation and returns a client instance. */
 CORE_NET_DLL_PUBLIC std::shared_ptr<Client> make_client();
+
+/** @brief Dispatches to the default implementation and returns a client instance set up according to configuration. */
+CORE_NET_DLL_PUBLIC std::shared_ptr<Client> make_client(const Client::Configuration& configuration);
 }
 }
 }
@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_EVENT_SOURCE_H_
+#define CORE_NET_HTTP_EVENT_SOURCE_H_
+
+#include <core/net/error.h>
+#include <core/net/visibility.h>
+
+#include <core/net/http/status.h>
+
+#include <string>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+/**
+ * @brief A subscription to a stream of server-sent events, see StreamingClient::open_event_source.
+ *
+ * Reconnects whenever the connection is closed or fails, after the
+ * reconnection time requested by the stream has passed, and asks for
+ * the events following the last one received via the Last-Event-ID header.
+ */
+class CORE_NET_DLL_PUBLIC EventSource
+{
+public:
+    /** @brief Summarizes all errors reported by an event source. */
+    struct Errors
+    {
+        Errors() = delete;
+
+        /**
+         * @brief Reported if the server answered with a status other than 200,
+         * after which the event source does not reconnect anymore.
+         */
+        struct ConnectionFailed : public core::net::Error
+        {
+            ConnectionFailed(Status status, const core::Location& loc);
+
+            /** The status the server answered with. */
+            Status status;
+        };
+    };
+
+    EventSource(const EventSource&) = delete;
+    virtual ~EventSource() = default;
+
+    EventSource& operator=(const EventSource&) = delete;
+
+    /**
+     * @brief Stops receiving events and reconnecting.
+     *
+     * Safe to call from any thread, including from within the handlers.
+     * No events are reported once close() returns.
+     */
+    virtual void close() = 0;
+
+    /** @brief The ID of the last event received, empty if none carried an ID. */
+    virtual std::string last_event_id() const = 0;
+
+protected:
+    EventSource() = default;
+};
+}
+}
+}
+
+#endif // CORE_NET_HTTP_EVENT_SOURCE_H_
@@ -0,0 +1,109 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_EVENT_STREAM_H_
+#define CORE_NET_HTTP_EVENT_STREAM_H_
+
+#include <core/net/visibility.h>
+
+#include <core/net/http/streaming_request.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+/**
+ * @brief Turns the chunks of a text/event-stream body into server-sent events.
+ *
+ * Parses the event stream format as specified by the HTML Living Standard,
+ * section 9.2, incrementally: every byte is looked at once, no matter how the
+ * body is split up into chunks, and buffers are reused across events.
+ * \code{.cpp}
+ * core::net::http::EventStream events{[](const core::net::http::EventStream::Event& event)
+ * {
+ *     std::cout << event.type << ": " << event.data << std::endl;
+ * }};
+ * auto response = client->streaming_get(configuration)->execute(progress_handler, events.to_data_handler());
+ * \endcode
+ *
+ * Copies of an EventStream share their state. Instances are not thread-safe.
+ */
+class CORE_NET_DLL_PUBLIC EventStream
+{
+public:
+    /** @brief A single server-sent event. */
+    struct Event
+    {
+        /** The last event ID, i.e., the value of the most recent id field. */
+        std::string id;
+        /** The value of the event field, "message" if missing. */
+        std::string type;
+        /** The values of all data fields, joined with line feeds. */
+        std::string data;
+        /** The reconnection time in effect, as last set by a retry field. */
+        std::chrono::milliseconds retry;
+    };
+
+    /** @brief Invoked for every event, the event is only valid for the duration of the call. */
+    typedef std::function<void(const Event&)> Handler;
+
+    /** @brief The reconnection time in effect until the stream sets one. */
+    static constexpr const std::chrono::milliseconds::rep default_reconnection_time_in_ms = 3000;
+
+    /** @brief Creates a new instance handing events to handler. */
+    explicit EventStream(const Handler& handler);
+
+    /** @brief Parses size bytes of data, invoking the handler for every event completed by them. */
+    void feed(const char* data, std::size_t size);
+
+    /** @brief Parses the given chunk, invoking the handler for every event completed by it. */
+    void feed(const std::string& chunk);
+
+    /** @brief Returns a data handler feeding chunks to this instance. */
+    StreamingRequest::DataHandler to_data_handler() const;
+
+    /**
+     * @brief Prepares for the body of another response, e.g., when reconnecting.
+     *
+     * Discards an event the previous body ended in the middle of, but keeps the
+     * last event ID and the reconnection time.
+     */
+    void reset();
+
+    /** @brief The last event ID, to be sent as Last-Event-ID header when reconnecting. */
+    const std::string& last_event_id() const;
+
+    /** @brief The time to wait before reconnecting. */
+    std::chrono::milliseconds reconnection_time() const;
+
+private:
+    struct Private;
+    std::shared_ptr<Private> d;
+};
+}
+}
+}
+
+#endif // CORE_NET_HTTP_EVENT_STREAM_H_
@@ -0,0 +1,148 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_FORM_H_
+#define CORE_NET_HTTP_FORM_H_
+
+#include <core/net/error.h>
+#include <core/net/visibility.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+/**
+ * @brief The body of an HTML form, generated while it is being uploaded.
+ *
+ * In contrast to Client::post_form, neither fields nor files are rendered to
+ * an in-memory buffer up front. Instead, each read() hands out the next slice
+ * of the body, encoding fields one at a time and streaming files from disk.
+ * The size of the body is known in advance, though, such that requests carry
+ * a Content-Length header:
+ * \code{.cpp}
+ * auto form = core::net::http::Form{core::net::http::Form::Encoding::multipart}
+ *         .add("title", "Holiday")
+ *         .add_file("picture", "/tmp/beach.jpg", "image/jpeg");
+ * auto request = client->post_form(configuration, form);
+ * \endcode
+ *
+ * Copies of a Form share their fields until either of them is modified.
+ */
+class CORE_NET_DLL_PUBLIC Form
+{
+public:
+    /** @brief Summarizes all errors raised when assembling a form. */
+    struct Errors
+    {
+        Errors() = delete;
+
+        /** @brief Thrown if a file added to a form cannot be accessed. */
+        struct InaccessibleFile : public core::net::Error
+        {
+            InaccessibleFile(const std::string& path, const core::Location& loc);
+        };
+
+        /** @brief Thrown when adding a file to a form that is not multipart-encoded. */
+        struct FilesRequireMultipart : public core::net::Error
+        {
+            FilesRequireMultipart(const core::Location& loc);
+        };
+    };
+
+    /** @brief The format of the body. */
+    enum class Encoding
+    {
+        /** application/x-www-form-urlencoded, fields only. */
+        url_encoded,
+        /** multipart/form-data as specified in RFC 7578, fields and files. */
+        multipart
+    };
+
+    /** @brief Function type filling dest with at most size bytes of the body, returning 0 at its end. */
+    typedef std::function<std::size_t(void* dest, std::size_t size)> Reader;
+
+    /**
+     * @brief Creates a form from any range of key-value pairs.
+     *
+     * Works for std::map, std::multimap, std::unordered_map and
+     * std::vector<std::pair<std::string, std::string>> alike, keeping
+     * the order of the range.
+     */
+    template<typename Pairs>
+    static Form from(const Pairs& pairs, Encoding encoding = Encoding::url_encoded)
+    {
+        Form form{encoding};
+        for (const auto& pair : pairs)
+            form.add(pair.first, pair.second);
+        return form;
+    }
+
+    /** @brief Creates an empty form, using a random boundary for multipart bodies. */
+    explicit Form(Encoding encoding = Encoding::url_encoded);
+
+    /** @brief The format of the body. */
+    Encoding encoding() const;
+
+    /** @brief Appends a field. */
+    Form& add(const std::string& name, const std::string& value);
+
+    /**
+     * @brief Appends a file, to be read from disk while uploading.
+     * @param name The name of the field.
+     * @param path The file to upload. Its size is determined right away.
+     * @param type The content type announced for the file.
+     * @param filename The filename announced for the file, defaults to the last component of path.
+     * @throw Errors::FilesRequireMultipart if the form is url-encoded.
+     * @throw Errors::InaccessibleFile if path does not refer to a regular file.
+     */
+    Form& add_file(const std::string& name,
+                   const std::string& path,
+                   const std::string& type = "application/octet-stream",
+                   const std::string& filename = std::string());
+
+    /** @brief The value of the Content-Type header, including the boundary for multipart bodies. */
+    std::string content_type() const;
+
+    /** @brief The size of the body in bytes, to be announced as Content-Length. */
+    std::uint64_t size() const;
+
+    /**
+     * @brief Returns a function handing out the body from its beginning.
+     *
+     * Every call returns an independent reader, e.g., for retrying an upload.
+     * A reader throws std::runtime_error if a file cannot be read or is
+     * shorter than it was when added to the form.
+     */
+    Reader reader() const;
+
+private:
+    struct Private;
+    std::shared_ptr<Private> d;
+};
+}
+}
+}
+
+#endif // CORE_NET_HTTP_FORM_H_
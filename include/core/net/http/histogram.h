@@ -0,0 +1,120 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_HISTOGRAM_H_
+#define CORE_NET_HTTP_HISTOGRAM_H_
+
+#include <core/net/visibility.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+class ConcurrentHistogram;
+}
+
+/**
+ * @brief The Histogram class records the distribution of durations.
+ *
+ * Durations are counted in log-linear buckets: Each power of two of microseconds
+ * is split into 64 buckets of equal width, such that percentiles are reported with
+ * a relative error below 1.6%, independent of the magnitude of the durations. Durations
+ * beyond 2^40 microseconds (roughly 12 days) are counted in the last bucket. Minimum,
+ * maximum, mean and variance are tracked exactly.
+ */
+class CORE_NET_DLL_PUBLIC Histogram
+{
+public:
+    typedef std::chrono::duration<double> Seconds;
+
+    /** @brief Creates an empty histogram. */
+    Histogram();
+
+    /** @brief Records a single duration, negative durations are recorded as 0. */
+    void record(const Seconds& duration);
+
+    /** @brief Adds all durations recorded by other to this histogram. */
+    void merge(const Histogram& other);
+
+    /** @brief Drops all durations recorded so far. */
+    void reset();
+
+    /** @brief Returns the number of recorded durations. */
+    std::uint64_t count() const;
+
+    /** @brief Returns the minimum recorded duration, or Seconds::max() if empty. */
+    Seconds min() const;
+
+    /** @brief Returns the maximum recorded duration, or Seconds::max() if empty. */
+    Seconds max() const;
+
+    /** @brief Returns the mean of the recorded durations, or Seconds::max() if empty. */
+    Seconds mean() const;
+
+    /** @brief Returns the variance of the recorded durations, or Seconds::max() if empty. */
+    Seconds variance() const;
+
+    /** @brief Returns the sum of all recorded durations. */
+    Seconds sum() const;
+
+    /**
+     * @brief Returns the duration below or at which the given percentage of durations fall.
+     * @param percentage The percentage in [0, 100], e.g., 99.9 for the p999.
+     * @return The upper bound of the bucket holding the percentile, never larger than max().
+     * Seconds::max() if the histogram is empty.
+     */
+    Seconds percentile(double percentage) const;
+
+    /**
+     * @brief Invokes enumerator for every non-empty bucket, in ascending order.
+     *
+     * The enumerator receives the upper bound of a bucket and the number of durations
+     * recorded in it. Useful for exporting the histogram with cumulative counts.
+     */
+    void enumerate(const std::function<void(const Seconds& upper_bound, std::uint64_t count)>& enumerator) const;
+
+private:
+    /// @cond
+    friend class impl::ConcurrentHistogram;
+
+    // Returns the number of buckets of every histogram.
+    static std::size_t bucket_count();
+    // Returns the index of the bucket counting duration.
+    static std::size_t index_for(const Seconds& duration);
+
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t total;
+    double minimum;
+    double maximum;
+    double sum_of_durations;
+    double sum_of_squares;
+    /// @endcond
+};
+}
+}
+}
+
+#endif // CORE_NET_HTTP_HISTOGRAM_H_
@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_NDJSON_STREAM_H_
+#define CORE_NET_HTTP_NDJSON_STREAM_H_
+
+#include <core/net/visibility.h>
+
+#include <core/net/http/streaming_request.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+/**
+ * @brief Turns the chunks of a newline-delimited body, e.g., NDJSON, into records.
+ *
+ * Records are split at line feeds, dropping a trailing carriage return and
+ * skipping empty lines. Records contained in a single chunk are handed out
+ * without copying them, others are assembled in a buffer that is reused.
+ * \code{.cpp}
+ * core::net::http::NdjsonStream records{[](const char* data, std::size_t size)
+ * {
+ *     Json::Value record;
+ *     Json::Reader{}.parse(data, data + size, record);
+ * }};
+ * auto response = client->streaming_get(configuration)->execute(progress_handler, records.to_data_handler());
+ * records.finish();
+ * \endcode
+ *
+ * Copies of an NdjsonStream share their state. Instances are not thread-safe.
+ */
+class CORE_NET_DLL_PUBLIC NdjsonStream
+{
+public:
+    /** @brief Invoked for every record, the data is only valid for the duration of the call. */
+    typedef std::function<void(const char* data, std::size_t size)> Handler;
+
+    /** @brief Creates a new instance handing records to handler. */
+    explicit NdjsonStream(const Handler& handler);
+
+    /** @brief Splits size bytes of data, invoking the handler for every record completed by them. */
+    void feed(const char* data, std::size_t size);
+
+    /** @brief Splits the given chunk, invoking the handler for every record completed by it. */
+    void feed(const std::string& chunk);
+
+    /** @brief Returns a data handler feeding chunks to this instance. */
+    StreamingRequest::DataHandler to_data_handler() const;
+
+    /** @brief Hands out the last record if the body did not end with a line feed. */
+    void finish();
+
+private:
+    struct Private;
+    std::shared_ptr<Private> d;
+};
+}
+}
+}
+
+#endif // CORE_NET_HTTP_NDJSON_STREAM_H_
@@ -51,6 +51,16 @@ public:
         done ///< Execution of the request has finished.
     };
 
+    /**
+     * @brief The Compression enum describes the content-codings that request bodies can be compressed with.
+     */
+    enum class Compression
+    {
+        none, ///< The request body is transmitted as is.
+        gzip, ///< The request body is compressed with gzip and sent with Content-Encoding: gzip.
+        deflate ///< The request body is compressed with zlib and sent with Content-Encoding: deflate.
+    };
+
     /**
      * @brief The Errors struct collects the Request-specific exceptions and error modes.
      */
@@ -205,6 +215,20 @@ public:
             };
         } ssl;
 
+        /** Options for transmitting the body of a request. */
+        struct
+        {
+            /**
+             * Compress the body on the fly while uploading it. As the size of
+             * the compressed body is not known in advance, it is transmitted
+             * with Transfer-Encoding: chunked.
+             */
+            Compression compression
+            {
+                Compression::none
+            };
+        } upload;
+
         /** Encapsulates proxy and http authentication handlers. */
         struct
         {
@@ -213,6 +237,13 @@ public:
             /** Invoked for querying user credentials to authenticate proxy accesses. */
             AuthenicationHandler for_proxy;
         } authentication_handler;
+
+        /**
+         * Optional label grouping requests in the metrics of a client, e.g.,
+         * "/users/{id}" for all requests to the users endpoint. Keep the number
+         * of distinct labels small, never put ids or query strings in here.
+         */
+        std::string route;
     };
 
     Request(const Request&) = delete;
@@ -243,6 +274,11 @@ public:
 
     /**
      * @brief Asynchronously executes the request, reporting errors, progress and completion to the given handlers.
+     *
+     * Handlers run on the thread running the client. Response and error handlers may
+     * execute further requests of the same client right away, progress handlers must
+     * not, and have to hand that off to another thread instead.
+     *
      * @param handler The handlers to called for events happening during execution of the request.
      * @return The response to the request.
      */
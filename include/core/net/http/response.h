@@ -23,6 +23,8 @@
 #include <core/net/http/header.h>
 #include <core/net/http/status.h>
 
+#include <chrono>
+#include <cstdint>
 #include <map>
 #include <sstream>
 #include <string>
@@ -43,12 +45,64 @@ struct CORE_NET_DLL_PUBLIC Response
     /** @brief The body of the response is a string. */
     typedef std::string Body;
 
+    /**
+     * @brief Summarizes how the transfer yielding a response was carried out.
+     *
+     * Left at its defaults for responses served from the cache without contacting
+     * the origin server. Coalesced requests share the transfer of the leading request.
+     */
+    struct Transfer
+    {
+        typedef std::chrono::duration<double> Seconds;
+
+        /** @brief An address and port of a connection. */
+        struct Endpoint
+        {
+            /** Numeric IPv4 or IPv6 address, empty if not known. */
+            std::string address;
+            /** Port number, 0 if not known. */
+            std::uint16_t port{0};
+        };
+
+        /** Time it took from the start until the name resolving was completed. */
+        Seconds name_look_up{0};
+        /** Time it took from the finished name lookup until the connect to the remote host (or proxy) was completed. */
+        Seconds connect{0};
+        /** Time it took from the connect until the SSL/SSH connect/handshake to the remote host was completed. */
+        Seconds app_connect{0};
+        /** Time it took from app_connect until the file transfer was just about to begin. */
+        Seconds pre_transfer{0};
+        /** Time it took from pre-transfer until the first byte was received. */
+        Seconds start_transfer{0};
+        /** Time the transfer took in total, including redirects. */
+        Seconds total{0};
+        /** Time spent on redirects before the final transfer started. */
+        Seconds redirect{0};
+
+        /** Number of redirects that were followed. */
+        std::uint32_t redirects{0};
+        /** Number of connections opened, 0 if the transfer was carried out on kept-alive connections only. */
+        std::uint32_t connects{0};
+        /** True if the transfer was carried out on a connection kept alive from a previous transfer. */
+        bool reused{false};
+
+        /** The negotiated version of HTTP, e.g., "1.1" or "2", empty if not known. */
+        std::string http_version;
+
+        /** The local end of the last connection used for the transfer. */
+        Endpoint local;
+        /** The remote end of the last connection used for the transfer. */
+        Endpoint remote;
+    };
+
     /** @brief The HTTP status as sent by the server. */
     Status status{Status::bad_request};
     /** @brief The header fields of the response. */
     Header header{};
     /** @brief The body of the response. */
     Body body{};
+    /** @brief Describes the transfer that yielded the response. */
+    Transfer transfer{};
 };
 }
 }
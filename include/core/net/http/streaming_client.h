@@ -20,6 +20,8 @@
 #define CORE_NET_HTTP_STREAMING_CLIENT_H_
 
 #include <core/net/http/client.h>
+#include <core/net/http/event_source.h>
+#include <core/net/http/event_stream.h>
 
 #include <core/net/http/streaming_request.h>
 
@@ -29,9 +31,30 @@ namespace net
 {
 namespace http
 {
-class StreamingClient : public Client
+class CORE_NET_DLL_PUBLIC StreamingClient : public Client
 {
 public:
+    /**
+     * @brief Producer hands out a request body of unknown size, see streaming_post_chunked.
+     *
+     * The data area pointed at by \a dest should be filled up with at most \a size number of bytes.
+     * Returns the number of bytes written, end_of_body or no_data_yet.
+     */
+    typedef std::function<std::size_t(void* dest, std::size_t size)> Producer;
+
+    /** @brief Returned by a Producer once the body is complete. */
+    static constexpr const std::size_t end_of_body = 0;
+
+    /**
+     * @brief Returned by a Producer without data at hand.
+     *
+     * For requests started with async_execute, the upload is paused until
+     * StreamingRequest::resume() is called on the request, which is safe to do
+     * from any thread and even before the producer returns. The producer is
+     * invoked again afterwards. Requests run by execute() have no one to resume
+     * them and fail instead.
+     */
+    static constexpr const std::size_t no_data_yet = static_cast<std::size_t>(-1);
 
     virtual ~StreamingClient() = default;
 
@@ -119,10 +142,97 @@ public:
     * @return An executable instance of class Request.
     */
     virtual std::shared_ptr<StreamingRequest> streaming_del(const Request::Configuration& configuration) = 0;
+
+    /**
+    * @brief streaming_post is a convenience method for issuing a POST request for the given URI.
+    * The request takes ownership of the payload and hands it to the network layer without copying it.
+    * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+    * @param configuration The configuration to issue a post request for.
+    * @param payload The data to be transmitted as part of the POST request.
+    * @param type The content-type of the data.
+    * @return An executable instance of class Request.
+    */
+    std::shared_ptr<StreamingRequest> streaming_post(const Request::Configuration& configuration, std::string&& payload, const std::string& type);
+
+    /**
+    * @brief streaming_post is a convenience method for issuing a POST request for the given URI.
+    * The request shares ownership of the immutable payload and hands it to the network layer without copying it.
+    * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+    * @param configuration The configuration to issue a post request for.
+    * @param payload The data to be transmitted as part of the POST request.
+    * @param type The content-type of the data.
+    * @return An executable instance of class Request.
+    */
+    std::shared_ptr<StreamingRequest> streaming_post(const Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload, const std::string& type);
+
+    /**
+    * @brief streaming_put is a convenience method for issuing a PUT request for the given URI.
+    * The request takes ownership of the payload and uploads it straight from the buffer.
+    * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+    * @param configuration The configuration to issue a put request for.
+    * @param payload The data to be transmitted as part of the PUT request.
+    * @return An executable instance of class Request.
+    */
+    std::shared_ptr<StreamingRequest> streaming_put(const Request::Configuration& configuration, std::string&& payload);
+
+    /**
+    * @brief streaming_put is a convenience method for issuing a PUT request for the given URI.
+    * The request shares ownership of the immutable payload and uploads it straight from the buffer.
+    * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+    * @param configuration The configuration to issue a put request for.
+    * @param payload The data to be transmitted as part of the PUT request.
+    * @return An executable instance of class Request.
+    */
+    std::shared_ptr<StreamingRequest> streaming_put(const Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload);
+
+    /**
+    * @brief streaming_post_form is a convenience method for issuing a POST request for the given URI, with the body of form.
+    * The body is generated while uploading it, such that neither fields nor files end up in memory as a whole.
+    * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+    * @param configuration The configuration to issue a post request for.
+    * @param form The fields and files to be transmitted as part of the POST request.
+    * @return An executable instance of class Request.
+    */
+    std::shared_ptr<StreamingRequest> streaming_post_form(const Request::Configuration& configuration, const Form& form);
+
+    /**
+    * @brief streaming_post_chunked issues a POST request for the given URI, with a body of unknown size.
+    * The body is sent with chunked transfer-encoding as the producer hands it out, without ever being buffered as a whole.
+    * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+    * @param configuration The configuration to issue a post request for.
+    * @param producer The function handing out the body, invoked from the thread running the client or, for execute(), the calling thread.
+    * @param type The content-type of the data.
+    * @return An executable instance of class Request.
+    */
+    std::shared_ptr<StreamingRequest> streaming_post_chunked(const Request::Configuration& configuration, const Producer& producer, const std::string& type);
+
+    /**
+    * @brief streaming_put_chunked issues a PUT request for the given URI, with a body of unknown size.
+    * The body is sent with chunked transfer-encoding as the producer hands it out, without ever being buffered as a whole.
+    * @throw Errors::HttpMethodNotSupported if the underlying implementation does not support the provided HTTP method.
+    * @param configuration The configuration to issue a put request for.
+    * @param producer The function handing out the body, invoked from the thread running the client or, for execute(), the calling thread.
+    * @return An executable instance of class Request.
+    */
+    std::shared_ptr<StreamingRequest> streaming_put_chunked(const Request::Configuration& configuration, const Producer& producer);
+
+    /**
+    * @brief open_event_source subscribes to the server-sent events of the given URI.
+    * Issues GET requests asking for text/event-stream, reconnecting as specified by the HTML Living Standard
+    * until the server answers with a status other than 200 or the subscription is closed. Requires the client to be running.
+    * @param configuration The configuration to issue get requests for.
+    * @param on_event Invoked for every event received.
+    * @param on_error Invoked for failed connections, both the ones that are retried and the final one.
+    * @return The subscription, which is closed once the last reference to it goes away.
+    */
+    std::shared_ptr<EventSource> open_event_source(const Request::Configuration& configuration, const EventStream::Handler& on_event, const Request::ErrorHandler& on_error);
 };
 
 /** @brief Dispatches to the default implementation and returns a streaming client instance. */
 CORE_NET_DLL_PUBLIC std::shared_ptr<StreamingClient> make_streaming_client();
+
+/** @brief Dispatches to the default implementation and returns a streaming client instance set up according to configuration. */
+CORE_NET_DLL_PUBLIC std::shared_ptr<StreamingClient> make_streaming_client(const Client::Configuration& configuration);
 }
 }
 }
@@ -48,6 +48,10 @@ public:
 
     /**
      * @brief Asynchronously executes the request, reporting errors, progress and completion to the given handlers.
+     *
+     * As for Request::async_execute, only response and error handlers may execute
+     * further requests of the same client right away, data handlers must not.
+     *
      * @param handler The handlers to called for events happening during execution of the request.
      * @param dh The data handler receiving chunks of data while executing the request.
      * @return The response to the request.
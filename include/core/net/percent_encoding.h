@@ -0,0 +1,110 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_PERCENT_ENCODING_H_
+#define CORE_NET_PERCENT_ENCODING_H_
+
+#include <core/net/visibility.h>
+
+#include <cstddef>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+/**
+ * @brief Percent-encoding as specified in RFC 3986, section 2.1.
+ *
+ * Unlike curl_escape and friends, the functions in this namespace neither
+ * require a curl handle nor allocate intermediate buffers. Runs of bytes
+ * that do not need escaping are copied by vectorized kernels selected at
+ * runtime.
+ */
+namespace percent_encoding
+{
+/** @brief The set of bytes left untouched when encoding, depending on where the result ends up. */
+enum class Component
+{
+    /**
+     * Only the unreserved characters ALPHA, DIGIT, '-', '.', '_' and '~'
+     * stay as they are, matching curl_escape.
+     */
+    unreserved,
+    /**
+     * A single segment of a path, leaving all of pchar untouched
+     * and escaping '/', '?' and '#'.
+     */
+    path_segment,
+    /**
+     * A key or value of a query, leaving '/', '?', ':' and '@' untouched
+     * and escaping the delimiters '&', '=', '+' and '#'.
+     */
+    query,
+    /**
+     * A key or value of an application/x-www-form-urlencoded body, leaving
+     * ALPHA, DIGIT, '*', '-', '.' and '_' untouched and encoding ' ' as '+'.
+     */
+    form
+};
+
+/**
+ * @brief Percent-encodes the given data.
+ * @param data The bytes to encode.
+ * @param component Determines the bytes left untouched.
+ * @return The encoded text, using upper-case hex digits.
+ */
+CORE_NET_DLL_PUBLIC std::string encode(
+        const std::string& data,
+        Component component = Component::unreserved);
+
+/**
+ * @brief Percent-encodes size bytes of data, appending the text to out.
+ *
+ * Allows for assembling URIs and form bodies in a single buffer.
+ */
+CORE_NET_DLL_PUBLIC void encode(
+        const char* data,
+        std::size_t size,
+        std::string& out,
+        Component component = Component::unreserved);
+
+/**
+ * @brief Decodes the given percent-encoded text.
+ *
+ * '%' not followed by two hex digits is passed through verbatim,
+ * matching curl_easy_unescape.
+ *
+ * @param text The text to decode.
+ * @param component Component::form additionally decodes '+' to ' '.
+ * @return The decoded bytes.
+ */
+CORE_NET_DLL_PUBLIC std::string decode(
+        const std::string& text,
+        Component component = Component::unreserved);
+
+/** @brief Decodes size bytes of percent-encoded text, appending the bytes to out. */
+CORE_NET_DLL_PUBLIC void decode(
+        const char* text,
+        std::size_t size,
+        std::string& out,
+        Component component = Component::unreserved);
+}
+}
+}
+
+#endif // CORE_NET_PERCENT_ENCODING_H_
@@ -0,0 +1,153 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_URL_H_
+#define CORE_NET_URL_H_
+
+#include <core/net/error.h>
+#include <core/net/visibility.h>
+
+#include <cstddef>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+/**
+ * @brief An absolute URI, held in a single buffer and parsed into components once.
+ *
+ * Components are tracked as offsets into the buffer, which makes appending
+ * path segments and query parameters cheap and rendering free:
+ * \code{.cpp}
+ * auto url = core::net::Url::parse("https://api.example.com/v1?lang=en");
+ * url.append_path_segment("search").append_query_parameter("q", "caf\xC3\xA9 & cr\xC3\xA8me");
+ * // https://api.example.com/v1/search?lang=en&q=caf%C3%A9%20%26%20cr%C3%A8me
+ * auto configuration = core::net::http::Request::Configuration::from_uri_as_string(url.str());
+ * \endcode
+ *
+ * Reusing an instance via assign() keeps its buffer around, such that
+ * building URLs in a loop does not allocate once the buffer has grown.
+ */
+class CORE_NET_DLL_PUBLIC Url
+{
+public:
+    /** @brief Summarizes all errors raised when parsing a URL. */
+    struct Errors
+    {
+        Errors() = delete;
+
+        /**
+         * @brief Thrown if text is not an absolute URI as specified in RFC 3986,
+         * i.e., it lacks a scheme, contains characters not allowed in a URI or
+         * has a malformed authority.
+         */
+        struct Malformed : public core::net::Error
+        {
+            Malformed(const std::string& what, const core::Location& loc);
+        };
+    };
+
+    /**
+     * @brief Parses the given text.
+     * @throw Errors::Malformed if text is not an absolute URI.
+     */
+    static Url parse(const std::string& text);
+
+    /** @brief Creates an empty instance, to be filled in by assign(). */
+    Url();
+
+    /**
+     * @brief Parses text into this instance, reusing its buffer.
+     * @throw Errors::Malformed if text is not an absolute URI, leaving this instance unchanged.
+     */
+    void assign(const std::string& text);
+
+    /** @brief The scheme, e.g., "https". */
+    std::string scheme() const;
+
+    /** @brief The authority, i.e., userinfo, host and port, empty if absent. */
+    std::string authority() const;
+
+    /** @brief The user information preceding '@' in the authority, empty if absent. */
+    std::string userinfo() const;
+
+    /** @brief The host, including the brackets of IPv6 literals. */
+    std::string host() const;
+
+    /** @brief The port following ':' in the authority, empty if absent. */
+    std::string port() const;
+
+    /** @brief The path, percent-encoded as it appears in the URL. */
+    std::string path() const;
+
+    /** @brief The query without the leading '?', percent-encoded as it appears in the URL. */
+    std::string query() const;
+
+    /** @brief The fragment without the leading '#', percent-encoded as it appears in the URL. */
+    std::string fragment() const;
+
+    /**
+     * @brief Appends '/' and the percent-encoded segment to the path.
+     * @return A reference to this instance, for chaining.
+     */
+    Url& append_path_segment(const std::string& segment);
+
+    /**
+     * @brief Appends the percent-encoded key-value pair to the query.
+     * @return A reference to this instance, for chaining.
+     */
+    Url& append_query_parameter(const std::string& key, const std::string& value);
+
+    /** @brief The complete URL. */
+    const std::string& str() const;
+
+    /** @brief The complete URL as a NUL-terminated string, as handed to curl. */
+    const char* c_str() const;
+
+private:
+    /// @cond
+    // Half-open range of a component in buffer.
+    struct Range
+    {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    std::string substr(const Range& range) const;
+    // Moves the bytes appended to buffer from position from on to offset,
+    // leaving it to the caller to adjust the ranges behind offset.
+    void move_appended_to(std::size_t offset, std::size_t from);
+
+    std::string buffer;
+    Range scheme_;
+    Range authority_;
+    Range userinfo_;
+    Range host_;
+    Range port_;
+    Range path_;
+    // Exclude the leading '?' and '#', if present.
+    Range query_;
+    Range fragment_;
+    bool has_query;
+    bool has_fragment;
+    /// @endcond
+};
+}
+}
+
+#endif // CORE_NET_URL_H_
@@ -0,0 +1,52 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/base64.h>
+
+#include "impl/base64.h"
+
+namespace base64 = core::net::base64;
+
+base64::Errors::Malformed::Malformed(const std::string& what, const core::Location& loc)
+    : core::net::Error(what, loc)
+{
+}
+
+std::string base64::encode(const std::string& data, base64::Alphabet alphabet, bool padded)
+{
+    std::string result;
+    encode(data.data(), data.size(), result, alphabet, padded);
+    return result;
+}
+
+void base64::encode(const char* data, std::size_t size, std::string& out, base64::Alphabet alphabet, bool padded)
+{
+    impl::base64::encode(data, size, out, alphabet, padded, impl::best_supported_isa());
+}
+
+std::string base64::decode(const std::string& text, base64::Alphabet alphabet)
+{
+    std::string result;
+    decode(text.data(), text.size(), result, alphabet);
+    return result;
+}
+
+void base64::decode(const char* text, std::size_t size, std::string& out, base64::Alphabet alphabet)
+{
+    impl::base64::decode(text, size, out, alphabet, impl::best_supported_isa());
+}
@@ -0,0 +1,261 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/executor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace net = core::net;
+
+namespace
+{
+// A pool of threads that each work off a queue of their own. Tasks posted
+// by a worker go to its own queue, tasks posted from elsewhere are spread
+// across all queues. A worker running out of tasks steals from the front of
+// the other queues before it parks, such that no thread idles while tasks are
+// waiting in the queue of a busy one.
+class ThreadPool : public net::Executor
+{
+public:
+    ThreadPool(std::size_t threads) : state(std::make_shared<State>(threads))
+    {
+        workers.reserve(threads);
+
+        for (std::size_t i = 0; i < threads; i++)
+        {
+            auto state = this->state;
+            workers.emplace_back([state, i]() { state->work(i); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        state->stop();
+
+        for (auto& worker : workers)
+        {
+            // The last reference to the pool might be dropped by one of its own tasks,
+            // that worker finishes up on its own, holding on to the state it needs.
+            if (worker.get_id() == std::this_thread::get_id())
+                worker.detach();
+            else
+                worker.join();
+        }
+    }
+
+    void post(const Task& task) override
+    {
+        state->post(task);
+    }
+
+private:
+    // State shared with the workers.
+    struct State
+    {
+        struct Queue
+        {
+            std::mutex guard;
+            std::deque<Task> tasks;
+        };
+
+        State(std::size_t threads) : queues(threads)
+        {
+        }
+
+        void post(const Task& task)
+        {
+            auto& queue = queues[queue_for_caller()];
+
+            {
+                std::lock_guard<std::mutex> lg(queue.guard);
+                queue.tasks.push_back(task);
+            }
+
+            // Both counters are only ever modified by sequentially consistent read-modify-write
+            // operations: either a parking worker sees the task, or we see the worker parking.
+            pending.fetch_add(1);
+
+            if (parked.load() > 0)
+            {
+                {
+                    std::lock_guard<std::mutex> lg(parking.guard);
+                    parking.generation++;
+                }
+
+                parking.wake_up.notify_one();
+            }
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lg(parking.guard);
+                parking.stopped = true;
+                parking.generation++;
+            }
+
+            parking.wake_up.notify_all();
+        }
+
+        // Runs tasks until the pool is stopped and no tasks are left.
+        void work(std::size_t index)
+        {
+            current() = Worker{this, index};
+
+            while (true)
+            {
+                Task task;
+
+                if (pop(index, task) || steal(index, task))
+                {
+                    pending.fetch_sub(1);
+
+                    try
+                    {
+                        task();
+                    } catch (...)
+                    {
+                    }
+
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> ul(parking.guard);
+
+                if (parking.stopped && pending.load() == 0)
+                    return;
+
+                parked.fetch_add(1);
+
+                // A task might have been posted since we last looked.
+                if (pending.load() == 0)
+                {
+                    auto generation = parking.generation;
+                    parking.wake_up.wait(ul, [this, generation]() { return parking.generation != generation; });
+                }
+
+                parked.fetch_sub(1);
+            }
+        }
+
+        // Takes the task posted last to the queue of the worker at index.
+        bool pop(std::size_t index, Task& task)
+        {
+            auto& queue = queues[index];
+            std::lock_guard<std::mutex> lg(queue.guard);
+
+            if (queue.tasks.empty())
+                return false;
+
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+
+            return true;
+        }
+
+        // Takes the oldest task from the queue of any other worker.
+        bool steal(std::size_t index, Task& task)
+        {
+            for (std::size_t i = 1; i < queues.size(); i++)
+            {
+                auto& queue = queues[(index + i) % queues.size()];
+                std::lock_guard<std::mutex> lg(queue.guard);
+
+                if (queue.tasks.empty())
+                    continue;
+
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+
+                return true;
+            }
+
+            return false;
+        }
+
+        // Workers post to their own queue, everybody else round-robin.
+        std::size_t queue_for_caller()
+        {
+            auto worker = current();
+
+            if (worker.state == this)
+                return worker.index;
+
+            return next.fetch_add(1, std::memory_order_relaxed) % queues.size();
+        }
+
+        // Identifies the pool and queue of the calling thread, if it is a worker.
+        struct Worker
+        {
+            State* state;
+            std::size_t index;
+        };
+
+        static Worker& current()
+        {
+            static thread_local Worker worker{nullptr, 0};
+            return worker;
+        }
+
+        std::vector<Queue> queues;
+        std::atomic<std::size_t> next{0};
+
+        // Number of tasks posted but not yet taken from a queue.
+        std::atomic<std::size_t> pending{0};
+        // Number of workers that are about to park or are parked.
+        std::atomic<std::size_t> parked{0};
+
+        struct
+        {
+            std::mutex guard;
+            std::condition_variable wake_up;
+            std::uint64_t generation{0};
+            bool stopped{false};
+        } parking;
+    };
+
+    std::shared_ptr<State> state;
+    std::vector<std::thread> workers;
+};
+}
+
+std::shared_ptr<net::Executor> net::make_thread_pool_executor(std::size_t threads)
+{
+    if (threads == 0)
+        throw std::invalid_argument("A thread pool needs at least one thread.");
+
+    return std::make_shared<ThreadPool>(threads);
+}
+
+std::shared_ptr<net::Executor> net::default_executor()
+{
+    static const std::shared_ptr<net::Executor> executor
+    {
+        make_thread_pool_executor(std::max(1u, std::thread::hardware_concurrency()))
+    };
+
+    return executor;
+}
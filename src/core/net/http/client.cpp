@@ -18,7 +18,9 @@
  */
 
 #include "impl/curl/client.h"
+#include "impl/form.h"
 
+#include <core/net/percent_encoding.h>
 #include <core/net/uri.h>
 #include <core/net/http/client.h>
 #include <core/net/http/content_type.h>
@@ -27,6 +29,38 @@
 
 namespace net = core::net;
 namespace http = net::http;
+namespace pe = net::percent_encoding;
+
+namespace
+{
+http::impl::curl::Client& curl_client_for(http::Client* client)
+{
+    auto curl_client = dynamic_cast<http::impl::curl::Client*>(client);
+    if (curl_client)
+    {
+        return *curl_client;
+    }
+    throw std::runtime_error("bad cast for curl client");
+}
+
+// Uploads payload through the virtual istream-based overloads of implementations
+// other than ours. The stream lives as long as the returned request is referenced.
+template<typename R>
+std::shared_ptr<R> uploaded_from_stream(const std::string& payload, const std::function<std::shared_ptr<R>(std::istream&)>& issue)
+{
+    struct Holder
+    {
+        std::istringstream stream;
+        std::shared_ptr<R> request;
+    };
+
+    auto holder = std::make_shared<Holder>();
+    holder->stream.str(payload);
+    holder->request = issue(holder->stream);
+
+    return std::shared_ptr<R>(holder, holder->request.get());
+}
+}
 
 http::Client::Errors::HttpMethodNotSupported::HttpMethodNotSupported(
         http::Method method,
@@ -41,76 +75,221 @@ std::shared_ptr<http::Request> http::Client::post_form(
         const http::Request::Configuration& configuration,
         const std::map<std::string, std::string>& values)
 {
-    std::stringstream ss;
-    bool first{true};
-
-    for (const auto& pair : values)
-    {
-        ss << (first ? "" : "&") << url_escape(pair.first) << "=" << url_escape(pair.second);
-        first = false;
-    }
-
-    return post(configuration, ss.str(), http::ContentType::x_www_form_urlencoded);
+    // Binding to a const reference dispatches to the virtual overload, which
+    // implementations other than ours provide as well.
+    const std::string body = http::impl::form_body_for(values);
+    return post(configuration, body, http::ContentType::x_www_form_urlencoded);
 }
 
 std::string http::Client::uri_to_string(const core::net::Uri& uri) const
 {
-    std::ostringstream s;
-
     // Start with the host of the URI
-    s << uri.host;
+    std::string s{uri.host};
 
     // Append each of the components of the path
     for (const std::string& part : uri.path)
     {
-        s << "/" << url_escape(part);
+        s.push_back('/');
+        pe::encode(part.data(), part.size(), s, pe::Component::path_segment);
     }
 
     // Append the parameters
     bool first = true;
     for (const std::pair<std::string, std::string>& query_parameter : uri.query_parameters)
     {
-        if (first)
-        {
-            // The first parameter needs a ?
-            s << "?";
-            first = false;
-        }
-        else
-        {
-            // The rest are separated with a &
-            s << "&";
-        }
+        // The first parameter needs a ?, the rest are separated with a &
+        s.push_back(first ? '?' : '&');
+        first = false;
 
         // URL escape the parameters
-        s << url_escape(query_parameter.first) << "=" << url_escape(query_parameter.second);
+        pe::encode(query_parameter.first.data(), query_parameter.first.size(), s, pe::Component::query);
+        s.push_back('=');
+        pe::encode(query_parameter.second.data(), query_parameter.second.size(), s, pe::Component::query);
     }
 
     // We're done
-    return s.str();
+    return s;
 }
 
 //TODO: Keep abi compatibility in vivid/xenial. 
-//Should be virtual function for the following two methods and move them to impl/curl/client.cpp.
+//Should be virtual functions for the following methods and move them to impl/curl/client.cpp.
 std::shared_ptr<http::Request> http::Client::post(
         const http::Request::Configuration& configuration, std::istream& payload, 
         std::size_t size)
 {
-    auto *curl_client = dynamic_cast<http::impl::curl::Client*>(this);
-    if (curl_client)
-    {
-        return curl_client->post(configuration, payload, size);
-    }
-    throw std::runtime_error("bad cast for curl client");
+    return curl_client_for(this).post(configuration, payload, size);
 }
 
 std::shared_ptr<http::Request> http::Client::del(
         const http::Request::Configuration& configuration)
 {
-    auto *curl_client = dynamic_cast<http::impl::curl::Client*>(this);
-    if (curl_client)
+    return curl_client_for(this).del(configuration);
+}
+
+std::shared_ptr<http::Request> http::Client::post(
+        const http::Request::Configuration& configuration,
+        std::string&& payload,
+        const std::string& type)
+{
+    // Temporaries and literals end up here, so implementations other
+    // than ours are served by their virtual overload.
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->post(configuration, std::move(payload), type);
+
+    return post(configuration, static_cast<const std::string&>(payload), type);
+}
+
+std::shared_ptr<http::Request> http::Client::post(
+        const http::Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload,
+        const std::string& type)
+{
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->post(configuration, payload, type);
+
+    return post(configuration, *payload, type);
+}
+
+std::shared_ptr<http::Request> http::Client::post_form(
+        const http::Request::Configuration& configuration,
+        const http::Form& form)
+{
+    return curl_client_for(this).post_form(configuration, form);
+}
+
+std::shared_ptr<http::Request> http::Client::put(
+        const http::Request::Configuration& configuration,
+        std::string&& payload)
+{
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->put(configuration, std::move(payload));
+
+    return uploaded_from_stream<http::Request>(payload, [this, &configuration, &payload](std::istream& in)
     {
-        return curl_client->del(configuration);
-    }
-    throw std::runtime_error("bad cast for curl client");
+        return put(configuration, in, payload.size());
+    });
+}
+
+std::shared_ptr<http::Request> http::Client::put(
+        const http::Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload)
+{
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->put(configuration, payload);
+
+    return uploaded_from_stream<http::Request>(*payload, [this, &configuration, &payload](std::istream& in)
+    {
+        return put(configuration, in, payload->size());
+    });
+}
+
+http::Client::Timings http::Client::reset_timings()
+{
+    return curl_client_for(this).reset_timings();
+}
+
+std::vector<http::Client::EndpointMetrics> http::Client::endpoint_metrics()
+{
+    return curl_client_for(this).endpoint_metrics();
+}
+
+http::Client::TransferStatistics http::Client::transfer_statistics()
+{
+    return curl_client_for(this).transfer_statistics();
+}
+
+http::Client::ReactorStatistics http::Client::reactor_statistics()
+{
+    return curl_client_for(this).reactor_statistics();
+}
+
+http::Client::CacheStatistics http::Client::cache_statistics()
+{
+    return curl_client_for(this).cache_statistics();
+}
+
+void http::Client::write_metrics(std::ostream& out)
+{
+    curl_client_for(this).write_metrics(out);
+}
+
+std::shared_ptr<http::StreamingRequest> http::StreamingClient::streaming_post(
+        const http::Request::Configuration& configuration,
+        std::string&& payload,
+        const std::string& type)
+{
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->streaming_post(configuration, std::move(payload), type);
+
+    return streaming_post(configuration, static_cast<const std::string&>(payload), type);
+}
+
+std::shared_ptr<http::StreamingRequest> http::StreamingClient::streaming_post(
+        const http::Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload,
+        const std::string& type)
+{
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->streaming_post(configuration, payload, type);
+
+    return streaming_post(configuration, *payload, type);
+}
+
+std::shared_ptr<http::StreamingRequest> http::StreamingClient::streaming_post_form(
+        const http::Request::Configuration& configuration,
+        const http::Form& form)
+{
+    return curl_client_for(this).streaming_post_form(configuration, form);
+}
+
+constexpr const std::size_t http::StreamingClient::end_of_body;
+constexpr const std::size_t http::StreamingClient::no_data_yet;
+
+std::shared_ptr<http::StreamingRequest> http::StreamingClient::streaming_post_chunked(
+        const http::Request::Configuration& configuration,
+        const http::StreamingClient::Producer& producer,
+        const std::string& type)
+{
+    return curl_client_for(this).streaming_post_chunked(configuration, producer, type);
+}
+
+std::shared_ptr<http::StreamingRequest> http::StreamingClient::streaming_put_chunked(
+        const http::Request::Configuration& configuration,
+        const http::StreamingClient::Producer& producer)
+{
+    return curl_client_for(this).streaming_put_chunked(configuration, producer);
+}
+
+std::shared_ptr<http::EventSource> http::StreamingClient::open_event_source(
+        const http::Request::Configuration& configuration,
+        const http::EventStream::Handler& on_event,
+        const http::Request::ErrorHandler& on_error)
+{
+    return curl_client_for(this).open_event_source(configuration, on_event, on_error);
+}
+
+std::shared_ptr<http::StreamingRequest> http::StreamingClient::streaming_put(
+        const http::Request::Configuration& configuration,
+        std::string&& payload)
+{
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->streaming_put(configuration, std::move(payload));
+
+    return uploaded_from_stream<http::StreamingRequest>(payload, [this, &configuration, &payload](std::istream& in)
+    {
+        return streaming_put(configuration, in, payload.size());
+    });
+}
+
+std::shared_ptr<http::StreamingRequest> http::StreamingClient::streaming_put(
+        const http::Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload)
+{
+    if (auto curl_client = dynamic_cast<http::impl::curl::Client*>(this))
+        return curl_client->streaming_put(configuration, payload);
+
+    return uploaded_from_stream<http::StreamingRequest>(*payload, [this, &configuration, &payload](std::istream& in)
+    {
+        return streaming_put(configuration, in, payload->size());
+    });
 }
@@ -0,0 +1,261 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/http/event_stream.h>
+
+#include "../impl/cpu.h"
+#include "../impl/line_break.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace http = core::net::http;
+
+namespace
+{
+constexpr const char* byte_order_mark{"\xEF\xBB\xBF"};
+
+bool equals(const char* field, std::size_t size, const char* name)
+{
+    return size == std::strlen(name) && std::memcmp(field, name, size) == 0;
+}
+
+bool is_number(const char* value, std::size_t size)
+{
+    return size > 0 && std::all_of(value, value + size, [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Parses the digits in value, saturating instead of overflowing, as
+// feed() runs inside callbacks that must not throw.
+std::chrono::milliseconds milliseconds_of(const char* value, std::size_t size)
+{
+    typedef std::chrono::milliseconds::rep Rep;
+    static constexpr Rep max{std::numeric_limits<Rep>::max()};
+
+    Rep result{0};
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        Rep digit = value[i] - '0';
+
+        if (result > (max - digit) / 10)
+            return std::chrono::milliseconds{max};
+
+        result = result * 10 + digit;
+    }
+
+    return std::chrono::milliseconds{result};
+}
+}
+
+struct http::EventStream::Private
+{
+    Private(const Handler& handler)
+        : handler(handler),
+          isa(core::net::impl::best_supported_isa()),
+          retry(default_reconnection_time_in_ms)
+    {
+    }
+
+    void feed(const char* p, std::size_t size)
+    {
+        auto end = p + size;
+
+        // A CR at the end of the previous chunk might be followed by its LF.
+        if (p != end && skip_lf)
+        {
+            if (*p == '\n')
+                p++;
+            skip_lf = false;
+        }
+
+        while (p != end)
+        {
+            auto n = core::net::impl::find_line_break(p, end - p, isa);
+
+            if (p + n == end)
+            {
+                line.append(p, n);
+                return;
+            }
+
+            // Lines within a chunk are processed right where they are.
+            if (line.empty())
+                process(p, n);
+            else
+            {
+                line.append(p, n);
+                process(line.data(), line.size());
+                line.clear();
+            }
+
+            p += n;
+            if (*p++ == '\r')
+            {
+                if (p == end)
+                    skip_lf = true;
+                else if (*p == '\n')
+                    p++;
+            }
+        }
+    }
+
+    void process(const char* l, std::size_t size)
+    {
+        if (first_line)
+        {
+            first_line = false;
+            if (size >= 3 && std::memcmp(l, byte_order_mark, 3) == 0)
+            {
+                l += 3; size -= 3;
+            }
+        }
+
+        if (size == 0)
+        {
+            dispatch();
+            return;
+        }
+
+        // Comments start with a colon.
+        if (l[0] == ':')
+            return;
+
+        auto colon = static_cast<const char*>(std::memchr(l, ':', size));
+        auto field_size = colon ? colon - l : size;
+        auto value = colon ? colon + 1 : l + size;
+        auto end = l + size;
+
+        if (value != end && *value == ' ')
+            value++;
+
+        auto value_size = static_cast<std::size_t>(end - value);
+
+        if (equals(l, field_size, "data"))
+        {
+            data.append(value, value_size);
+            data.push_back('\n');
+        } else if (equals(l, field_size, "event"))
+            type.assign(value, value_size);
+        else if (equals(l, field_size, "id"))
+        {
+            if (not std::memchr(value, '\0', value_size))
+                id.assign(value, value_size);
+        } else if (equals(l, field_size, "retry"))
+        {
+            if (is_number(value, value_size))
+                retry = milliseconds_of(value, value_size);
+        }
+    }
+
+    void dispatch()
+    {
+        last_event_id = id;
+
+        if (data.empty())
+        {
+            type.clear();
+            return;
+        }
+
+        // The last data field adds a line feed too many.
+        data.pop_back();
+
+        // Swapping hands the data to the event without copying it, and
+        // keeps the buffer of the previous event around for the next one.
+        event.id = last_event_id;
+        event.type = type.empty() ? "message" : type;
+        event.data.swap(data);
+        event.retry = retry;
+
+        data.clear();
+        type.clear();
+
+        if (handler)
+            handler(event);
+    }
+
+    void reset()
+    {
+        line.clear();
+        skip_lf = false;
+        first_line = true;
+        data.clear();
+        type.clear();
+        id = last_event_id;
+    }
+
+    Handler handler;
+    core::net::impl::Isa isa;
+
+    // The beginning of a line continued by the next chunk.
+    std::string line;
+    bool skip_lf{false};
+    bool first_line{true};
+
+    // The buffers of the event being received.
+    std::string data;
+    std::string type;
+    std::string id;
+
+    std::string last_event_id;
+    std::chrono::milliseconds retry;
+
+    Event event;
+};
+
+constexpr const std::chrono::milliseconds::rep http::EventStream::default_reconnection_time_in_ms;
+
+http::EventStream::EventStream(const Handler& handler) : d(new Private(handler))
+{
+}
+
+void http::EventStream::feed(const char* data, std::size_t size)
+{
+    d->feed(data, size);
+}
+
+void http::EventStream::feed(const std::string& chunk)
+{
+    d->feed(chunk.data(), chunk.size());
+}
+
+http::StreamingRequest::DataHandler http::EventStream::to_data_handler() const
+{
+    auto d = this->d;
+    return [d](const std::string& chunk)
+    {
+        d->feed(chunk.data(), chunk.size());
+    };
+}
+
+void http::EventStream::reset()
+{
+    d->reset();
+}
+
+const std::string& http::EventStream::last_event_id() const
+{
+    return d->last_event_id;
+}
+
+std::chrono::milliseconds http::EventStream::reconnection_time() const
+{
+    return d->retry;
+}
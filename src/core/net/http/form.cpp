@@ -0,0 +1,379 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/http/form.h>
+
+#include <core/net/percent_encoding.h>
+
+#include "../impl/cpu.h"
+#include "../impl/percent_encoding.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace http = core::net::http;
+namespace pe = core::net::percent_encoding;
+
+namespace
+{
+// Length of the random part of a multipart boundary.
+constexpr const std::size_t boundary_length{32};
+
+// Url-encoded values are encoded in slices of this size, keeping
+// the staging buffer of a reader small for large values.
+constexpr const std::size_t encoding_slice{16 * 1024};
+
+constexpr const char* crlf{"\r\n"};
+
+std::string random_boundary()
+{
+    static constexpr const char alphabet[]{"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ"};
+
+    std::random_device device;
+    std::mt19937 generator{device()};
+    std::uniform_int_distribution<std::size_t> index{0, sizeof(alphabet) - 2};
+
+    std::string result{"net-cpp-"};
+    for (std::size_t i = 0; i < boundary_length; i++)
+        result.push_back(alphabet[index(generator)]);
+
+    return result;
+}
+
+// Escapes a name or filename for inclusion in a quoted-string
+// the way browsers do, see RFC 7578, section 4.2.
+std::string quoted(const std::string& s)
+{
+    std::string result{"\""};
+    for (auto c : s)
+    {
+        switch (c)
+        {
+        case '"': result += "%22"; break;
+        case '\r': result += "%0D"; break;
+        case '\n': result += "%0A"; break;
+        default: result.push_back(c); break;
+        }
+    }
+    result.push_back('"');
+    return result;
+}
+
+std::string basename_of(const std::string& path)
+{
+    auto slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+std::size_t encoded_size_of(const std::string& s)
+{
+    return core::net::impl::percent_encoding::encoded_size(
+                s.data(), s.size(), pe::Component::form, core::net::impl::best_supported_isa());
+}
+
+// Closes a file descriptor when going out of scope.
+struct File
+{
+    explicit File(const std::string& path) : fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC))
+    {
+        if (fd < 0)
+            throw std::system_error(errno, std::system_category(), "Could not open " + path);
+    }
+
+    File(const File&) = delete;
+
+    ~File()
+    {
+        ::close(fd);
+    }
+
+    File& operator=(const File&) = delete;
+
+    int fd;
+};
+}
+
+struct http::Form::Private
+{
+    struct Field
+    {
+        std::string name;
+        // The value of a field or the path of a file.
+        std::string value;
+        bool is_file;
+        std::uint64_t file_size;
+        // The part header of a multipart body, rendered when adding the field.
+        std::string part_header;
+    };
+
+    // Hands out the body of a form, one field at a time.
+    class Reader
+    {
+    public:
+        Reader(const std::shared_ptr<const Private>& form) : form(form)
+        {
+        }
+
+        std::size_t read(char* dest, std::size_t size)
+        {
+            std::size_t written{0};
+
+            while (written < size)
+            {
+                if (staged < staging.size())
+                {
+                    auto n = std::min(size - written, staging.size() - staged);
+                    std::memcpy(dest + written, staging.data() + staged, n);
+                    staged += n; written += n;
+                    continue;
+                }
+
+                if (value && value_offset < value->size())
+                {
+                    if (form->encoding == Encoding::url_encoded)
+                    {
+                        auto n = std::min(encoding_slice, value->size() - value_offset);
+                        stage_begin();
+                        pe::encode(value->data() + value_offset, n, staging, pe::Component::form);
+                        value_offset += n;
+                        continue;
+                    }
+
+                    auto n = std::min(size - written, value->size() - value_offset);
+                    std::memcpy(dest + written, value->data() + value_offset, n);
+                    value_offset += n; written += n;
+                    continue;
+                }
+
+                if (file && file_remaining > 0)
+                {
+                    auto n = std::min<std::uint64_t>(size - written, file_remaining);
+                    auto rc = ::read(file->fd, dest + written, n);
+
+                    if (rc < 0 && errno == EINTR)
+                        continue;
+                    if (rc < 0)
+                        throw std::system_error(errno, std::system_category(), "Could not read " + value_path);
+                    if (rc == 0)
+                        throw std::runtime_error("File shrunk while uploading: " + value_path);
+
+                    file_remaining -= rc; written += rc;
+                    continue;
+                }
+
+                if (not advance())
+                    break;
+            }
+
+            return written;
+        }
+
+    private:
+        void stage_begin()
+        {
+            staging.clear();
+            staged = 0;
+        }
+
+        // Moves on to the next field, staging everything in front of its value.
+        // Returns false once the body is complete.
+        bool advance()
+        {
+            value = nullptr;
+            file.reset();
+            stage_begin();
+
+            if (finished)
+                return false;
+
+            const auto multipart = form->encoding == Encoding::multipart;
+
+            if (next == form->fields.size())
+            {
+                finished = true;
+
+                if (multipart)
+                {
+                    if (next > 0)
+                        staging += crlf;
+                    staging += "--" + form->boundary + "--" + crlf;
+                }
+
+                return not staging.empty();
+            }
+
+            const auto& field = form->fields[next];
+
+            if (multipart)
+            {
+                // The line break in front of a delimiter belongs to the delimiter.
+                if (next > 0)
+                    staging += crlf;
+                staging += field.part_header;
+            } else
+            {
+                if (next > 0)
+                    staging.push_back('&');
+                pe::encode(field.name.data(), field.name.size(), staging, pe::Component::form);
+                staging.push_back('=');
+            }
+
+            if (field.is_file)
+            {
+                file.reset(new File(field.value));
+                file_remaining = field.file_size;
+                value_path = field.value;
+            } else
+            {
+                value = &field.value;
+                value_offset = 0;
+            }
+
+            next++;
+            return true;
+        }
+
+        std::shared_ptr<const Private> form;
+        std::size_t next{0};
+        bool finished{false};
+
+        std::string staging;
+        std::size_t staged{0};
+
+        const std::string* value{nullptr};
+        std::size_t value_offset{0};
+
+        std::unique_ptr<File> file;
+        std::uint64_t file_remaining{0};
+        std::string value_path;
+    };
+
+    Encoding encoding;
+    std::string boundary;
+    std::vector<Field> fields;
+    std::uint64_t size;
+};
+
+http::Form::Errors::InaccessibleFile::InaccessibleFile(const std::string& path, const core::Location& loc)
+    : core::net::Error("Cannot access file for uploading: " + path, loc)
+{
+}
+
+http::Form::Errors::FilesRequireMultipart::FilesRequireMultipart(const core::Location& loc)
+    : core::net::Error("Files can only be added to multipart forms.", loc)
+{
+}
+
+http::Form::Form(Encoding encoding) : d(new Private{encoding, std::string(), {}, 0})
+{
+    if (encoding == Encoding::multipart)
+    {
+        d->boundary = random_boundary();
+        // The close delimiter, every part adds its header, content and
+        // the line break in front of the following delimiter.
+        d->size = 2 + d->boundary.size() + 4;
+    }
+}
+
+http::Form::Encoding http::Form::encoding() const
+{
+    return d->encoding;
+}
+
+http::Form& http::Form::add(const std::string& name, const std::string& value)
+{
+    // Readers handed out before keep seeing the fields as they were.
+    if (d.use_count() > 1)
+        d = std::make_shared<Private>(*d);
+
+    Private::Field field{name, value, false, 0, std::string()};
+
+    if (d->encoding == Encoding::multipart)
+    {
+        field.part_header = "--" + d->boundary + crlf
+                + "Content-Disposition: form-data; name=" + quoted(name) + crlf
+                + crlf;
+
+        d->size += field.part_header.size() + value.size() + 2;
+    } else
+    {
+        d->size += (d->fields.empty() ? 0 : 1) + encoded_size_of(name) + 1 + encoded_size_of(value);
+    }
+
+    d->fields.push_back(std::move(field));
+    return *this;
+}
+
+http::Form& http::Form::add_file(
+        const std::string& name,
+        const std::string& path,
+        const std::string& type,
+        const std::string& filename)
+{
+    if (d->encoding != Encoding::multipart)
+        throw Errors::FilesRequireMultipart(CORE_FROM_HERE());
+
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0 || not S_ISREG(st.st_mode) || ::access(path.c_str(), R_OK) != 0)
+        throw Errors::InaccessibleFile(path, CORE_FROM_HERE());
+
+    if (d.use_count() > 1)
+        d = std::make_shared<Private>(*d);
+
+    Private::Field field{name, path, true, static_cast<std::uint64_t>(st.st_size), std::string()};
+    field.part_header = "--" + d->boundary + crlf
+            + "Content-Disposition: form-data; name=" + quoted(name)
+            + "; filename=" + quoted(filename.empty() ? basename_of(path) : filename) + crlf
+            + "Content-Type: " + type + crlf
+            + crlf;
+
+    d->size += field.part_header.size() + field.file_size + 2;
+    d->fields.push_back(std::move(field));
+    return *this;
+}
+
+std::string http::Form::content_type() const
+{
+    if (d->encoding == Encoding::multipart)
+        return "multipart/form-data; boundary=" + d->boundary;
+
+    return "application/x-www-form-urlencoded";
+}
+
+std::uint64_t http::Form::size() const
+{
+    return d->size;
+}
+
+http::Form::Reader http::Form::reader() const
+{
+    auto reader = std::make_shared<Private::Reader>(d);
+    return [reader](void* dest, std::size_t size)
+    {
+        return reader->read(static_cast<char*>(dest), size);
+    };
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/http/histogram.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace http = core::net::http;
+
+namespace
+{
+// Durations below 2^linear_bits microseconds are counted with a resolution of 1 microsecond.
+constexpr const unsigned int linear_bits{7};
+// Every further power of two is split into 2^sub_bucket_bits buckets.
+constexpr const unsigned int sub_bucket_bits{linear_bits - 1};
+constexpr const std::uint64_t sub_bucket_count{1ull << sub_bucket_bits};
+// Durations of 2^max_bits microseconds and more end up in the last bucket.
+constexpr const unsigned int max_bits{40};
+constexpr const std::uint64_t max_value{(1ull << max_bits) - 1};
+
+constexpr const std::size_t buckets_per_histogram{(1ull << linear_bits) + (max_bits - linear_bits) * sub_bucket_count};
+
+std::size_t index_for_microseconds(std::uint64_t microseconds)
+{
+    if (microseconds < (1ull << linear_bits))
+        return microseconds;
+
+    microseconds = std::min(microseconds, max_value);
+
+    unsigned int exponent = 63 - __builtin_clzll(microseconds);
+    unsigned int shift = exponent - sub_bucket_bits;
+
+    return (1ull << linear_bits)
+            + (exponent - linear_bits) * sub_bucket_count
+            + ((microseconds >> shift) - sub_bucket_count);
+}
+
+http::Histogram::Seconds upper_bound_of(std::size_t index)
+{
+    typedef std::chrono::duration<double, std::micro> Microseconds;
+
+    if (index < (1ull << linear_bits))
+        return Microseconds{static_cast<double>(index + 1)};
+
+    auto offset = index - (1ull << linear_bits);
+    auto exponent = linear_bits + offset / sub_bucket_count;
+    auto shift = exponent - sub_bucket_bits;
+    auto sub_bucket = sub_bucket_count + offset % sub_bucket_count;
+
+    return Microseconds{static_cast<double>((sub_bucket + 1) << shift)};
+}
+}
+
+http::Histogram::Histogram()
+    : buckets(buckets_per_histogram, 0),
+      total(0),
+      minimum(Seconds::max().count()),
+      maximum(0),
+      sum_of_durations(0),
+      sum_of_squares(0)
+{
+}
+
+void http::Histogram::record(const Seconds& duration)
+{
+    auto value = std::max(0., duration.count());
+
+    buckets[index_for(duration)]++;
+    total++;
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+    sum_of_durations += value;
+    sum_of_squares += value * value;
+}
+
+std::size_t http::Histogram::bucket_count()
+{
+    return buckets_per_histogram;
+}
+
+std::size_t http::Histogram::index_for(const Seconds& duration)
+{
+    auto microseconds = std::max(0., duration.count()) * 1e6;
+
+    if (microseconds >= max_value)
+        return buckets_per_histogram - 1;
+
+    return index_for_microseconds(static_cast<std::uint64_t>(microseconds));
+}
+
+void http::Histogram::merge(const Histogram& other)
+{
+    for (std::size_t i = 0; i < buckets_per_histogram; i++)
+        buckets[i] += other.buckets[i];
+
+    total += other.total;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+    sum_of_durations += other.sum_of_durations;
+    sum_of_squares += other.sum_of_squares;
+}
+
+void http::Histogram::reset()
+{
+    *this = Histogram{};
+}
+
+std::uint64_t http::Histogram::count() const
+{
+    return total;
+}
+
+http::Histogram::Seconds http::Histogram::min() const
+{
+    return total > 0 ? Seconds{minimum} : Seconds::max();
+}
+
+http::Histogram::Seconds http::Histogram::max() const
+{
+    return total > 0 ? Seconds{maximum} : Seconds::max();
+}
+
+http::Histogram::Seconds http::Histogram::mean() const
+{
+    return total > 0 ? Seconds{sum_of_durations / total} : Seconds::max();
+}
+
+http::Histogram::Seconds http::Histogram::variance() const
+{
+    if (total == 0)
+        return Seconds::max();
+
+    auto mean = sum_of_durations / total;
+    return Seconds{std::max(0., sum_of_squares / total - mean * mean)};
+}
+
+http::Histogram::Seconds http::Histogram::sum() const
+{
+    return Seconds{sum_of_durations};
+}
+
+http::Histogram::Seconds http::Histogram::percentile(double percentage) const
+{
+    if (total == 0)
+        return Seconds::max();
+
+    auto rank = static_cast<std::uint64_t>(std::ceil(std::min(100., std::max(0., percentage)) / 100. * total));
+    rank = std::max<std::uint64_t>(rank, 1);
+
+    std::uint64_t seen{0};
+
+    for (std::size_t i = 0; i < buckets_per_histogram; i++)
+    {
+        seen += buckets[i];
+
+        if (seen >= rank)
+            return Seconds{std::min(maximum, std::max(minimum, upper_bound_of(i).count()))};
+    }
+
+    return Seconds{maximum};
+}
+
+void http::Histogram::enumerate(const std::function<void(const Seconds&, std::uint64_t)>& enumerator) const
+{
+    for (std::size_t i = 0; i < buckets_per_histogram; i++)
+        if (buckets[i] > 0)
+            enumerator(upper_bound_of(i), buckets[i]);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "cache.h"
+
+namespace cache = core::net::http::impl::cache;
+
+std::uint64_t cache::body_size_of(const cache::Entry& entry)
+{
+    if (entry.blob)
+        return entry.blob->size();
+
+    return entry.response.body.size();
+}
+
+void cache::Cache::refresh(const std::string& key, const std::shared_ptr<const cache::Entry>& entry)
+{
+    store(key, entry);
+}
+
+cache::Cache::Statistics cache::Cache::statistics() const
+{
+    Statistics result;
+
+    result.hits = hits.load();
+    result.misses = misses.load();
+    result.revalidations = revalidations.load();
+
+    return result;
+}
+
+void cache::Cache::record(cache::Cache::Outcome outcome)
+{
+    switch (outcome)
+    {
+    case Outcome::hit:
+        ++hits;
+        break;
+    case Outcome::miss:
+        ++misses;
+        break;
+    case Outcome::revalidated:
+        // A confirmed response is served from the cache, too.
+        ++revalidations;
+        ++hits;
+        break;
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CACHE_CACHE_H_
+#define CORE_NET_HTTP_IMPL_CACHE_CACHE_H_
+
+#include <core/net/http/client.h>
+#include <core/net/http/response.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace cache
+{
+// Holds the body of an entry outside of memory.
+class Blob
+{
+public:
+    Blob(const Blob&) = delete;
+    virtual ~Blob() = default;
+
+    Blob& operator=(const Blob&) = delete;
+
+    // Returns the size of the body in bytes.
+    virtual std::uint64_t size() const = 0;
+
+    // Reads at most size bytes starting at offset into dest and returns the
+    // number of bytes read. Throws std::system_error in case of issues.
+    virtual std::size_t read(std::uint64_t offset, char* dest, std::size_t size) const = 0;
+
+protected:
+    Blob() = default;
+};
+
+// A response as kept in a cache, together with the information
+// required to judge its freshness, see RFC 7234, section 4.2.
+struct Entry
+{
+    typedef std::chrono::system_clock Clock;
+
+    // The response as received from the origin server. Its body
+    // is empty if the entry keeps the body in a blob.
+    Response response;
+    // The body of the response if it is kept outside of memory.
+    std::shared_ptr<const Blob> blob;
+    // Values of the request header fields that the response varies on,
+    // keyed by the names listed in the Vary header of the response.
+    std::map<std::string, std::string> variants;
+    // Point in time when the request was issued.
+    Clock::time_point request_time;
+    // Point in time when the response was received.
+    Clock::time_point response_time;
+};
+
+// Returns the size of the body of entry in bytes.
+std::uint64_t body_size_of(const Entry& entry);
+
+// Interface of caches storing entries by key, as produced by cache::key_for.
+// Implementations have to be thread-safe.
+class Cache
+{
+public:
+    typedef http::Client::CacheStatistics Statistics;
+
+    // Summarizes the ways a cacheable request can be answered.
+    enum class Outcome
+    {
+        // A fresh response was served without contacting the origin server.
+        hit,
+        // The origin server answered with a full response.
+        miss,
+        // The origin server confirmed a stale response with a 304.
+        revalidated
+    };
+
+    Cache(const Cache&) = delete;
+    virtual ~Cache() = default;
+
+    Cache& operator=(const Cache&) = delete;
+
+    // Returns the entry stored for key, or a nullptr if there is none.
+    virtual std::shared_ptr<const Entry> lookup(const std::string& key) = 0;
+
+    // Stores entry for key, replacing any previous entry.
+    virtual void store(const std::string& key, const std::shared_ptr<const Entry>& entry) = 0;
+
+    // Stores entry for key, an entry looked up for key with updated metadata
+    // but the same body, e.g., after revalidating it. Defaults to store.
+    virtual void refresh(const std::string& key, const std::shared_ptr<const Entry>& entry);
+
+    // Removes the entry stored for key, if any.
+    virtual void remove(const std::string& key) = 0;
+
+    // Queries statistics about the cache.
+    virtual Statistics statistics() const;
+
+    // Accounts for a request answered with the given outcome.
+    void record(Outcome outcome);
+
+protected:
+    Cache() = default;
+
+private:
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+    std::atomic<std::uint64_t> revalidations{0};
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CACHE_CACHE_H_
@@ -0,0 +1,1229 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "disk_cache.h"
+
+#include <zlib.h>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace cache = core::net::http::impl::cache;
+namespace http = core::net::http;
+
+namespace
+{
+// Identifies the layout of the index file. Records are stored in native
+// byte order, so a cache directory cannot be shared across architectures.
+constexpr const char index_magic[8] = {'n', 'e', 't', '-', 'c', 'p', 'p', '\0'};
+// Bump the version for incompatible changes to the layout.
+constexpr const std::uint32_t index_version{2};
+
+constexpr const char* index_file_name{"index"};
+constexpr const char* segment_file_prefix{"segment-"};
+
+// Maximum number of entries in the index, has to be a power of 2.
+constexpr const std::uint32_t slot_count{1 << 16};
+// The index is rehashed or entries are evicted once this many slots are occupied.
+constexpr const std::uint32_t max_occupied_slots{slot_count / 4 * 3};
+constexpr const std::uint32_t no_slot{std::numeric_limits<std::uint32_t>::max()};
+
+// Identifies the start of a record in a segment file.
+constexpr const std::uint32_t record_magic{0x6e637263};
+// Records leave room for their metadata to grow by this many bytes, such
+// that revalidated entries can be updated without copying their body.
+constexpr const std::uint32_t meta_slack{256};
+
+// The active segment is rolled over once it holds this fraction of the capacity, within bounds.
+constexpr const std::uint64_t segments_per_capacity{8};
+constexpr const std::uint64_t min_segment_size{std::uint64_t{1} << 20};
+constexpr const std::uint64_t max_segment_size{std::uint64_t{256} << 20};
+
+// Segments with less live data than this fraction of their size are compacted.
+constexpr const double compaction_threshold{0.5};
+// The compactor checks for work at least this often.
+constexpr const std::chrono::seconds compaction_period{30};
+
+// Size of the chunks used for copying records.
+constexpr const std::size_t copy_buffer_size{64 * 1024};
+
+struct IndexHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t slot_count;
+    // Id of the next segment file to be created.
+    std::uint32_t next_segment;
+    std::uint32_t reserved;
+    // Logical clock tracking the recency of use of entries.
+    std::uint64_t clock;
+};
+
+enum class SlotState : std::uint32_t
+{
+    empty,
+    used,
+    // Keeps probe sequences intact until the next rehash.
+    removed
+};
+
+// An entry in the open-addressing hash table making up the index.
+struct Slot
+{
+    std::uint64_t hash;
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint64_t last_access;
+    std::uint32_t segment;
+    SlotState state;
+};
+
+// Precedes the metadata and the body of a response in a segment file.
+// The body starts meta_capacity bytes after the end of the header.
+struct RecordHeader
+{
+    std::uint32_t magic;
+    // Checksum over the metadata, bodies are only checked for their size.
+    std::uint32_t crc;
+    std::uint32_t meta_size;
+    std::uint32_t meta_capacity;
+    std::uint64_t body_size;
+};
+
+// An append-only file holding records. Instances close the file when
+// they go away, keeping it readable for blobs even if it is unlinked.
+struct Segment
+{
+    Segment(int fd, const std::string& path) : fd(fd), path(path)
+    {
+    }
+
+    ~Segment()
+    {
+        ::close(fd);
+    }
+
+    int fd;
+    std::string path;
+};
+
+std::system_error system_error_from_errno(const std::string& what)
+{
+    return std::system_error(errno, std::system_category(), what);
+}
+
+// FNV-1a, as we need hashes that are stable across processes.
+std::uint64_t hash_of(const std::string& key)
+{
+    std::uint64_t result{14695981039346656037ull};
+
+    for (unsigned char c : key)
+    {
+        result ^= c;
+        result *= 1099511628211ull;
+    }
+
+    return result;
+}
+
+std::uint32_t crc_of(const std::string& s)
+{
+    return ::crc32(::crc32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(s.data()), s.size());
+}
+
+void write_fully(int fd, const void* data, std::size_t size, std::uint64_t offset)
+{
+    auto p = static_cast<const char*>(data);
+
+    while (size > 0)
+    {
+        auto rc = ::pwrite(fd, p, size, offset);
+
+        if (rc < 0 && errno == EINTR)
+            continue;
+
+        if (rc < 0)
+            throw system_error_from_errno("Could not write to cache segment");
+
+        p += rc;
+        size -= rc;
+        offset += rc;
+    }
+}
+
+void read_fully(int fd, void* data, std::size_t size, std::uint64_t offset)
+{
+    auto p = static_cast<char*>(data);
+
+    while (size > 0)
+    {
+        auto rc = ::pread(fd, p, size, offset);
+
+        if (rc < 0 && errno == EINTR)
+            continue;
+
+        if (rc < 0)
+            throw system_error_from_errno("Could not read from cache segment");
+
+        if (rc == 0)
+            throw std::system_error(std::make_error_code(std::errc::io_error), "Cache segment is truncated");
+
+        p += rc;
+        size -= rc;
+        offset += rc;
+    }
+}
+
+void copy_range(int from, std::uint64_t from_offset, int to, std::uint64_t to_offset, std::uint64_t size)
+{
+    std::vector<char> buffer(copy_buffer_size);
+
+    while (size > 0)
+    {
+        auto chunk = static_cast<std::size_t>(std::min<std::uint64_t>(size, buffer.size()));
+
+        read_fully(from, buffer.data(), chunk, from_offset);
+        write_fully(to, buffer.data(), chunk, to_offset);
+
+        from_offset += chunk;
+        to_offset += chunk;
+        size -= chunk;
+    }
+}
+
+std::uint64_t ticks_of(const cache::Entry::Clock::time_point& tp)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+}
+
+cache::Entry::Clock::time_point time_point_of(std::uint64_t ticks)
+{
+    return cache::Entry::Clock::time_point{
+        std::chrono::duration_cast<cache::Entry::Clock::duration>(
+                    std::chrono::microseconds{static_cast<std::int64_t>(ticks)})};
+}
+
+void put(std::string& out, std::uint32_t value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put(std::string& out, std::uint64_t value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void put(std::string& out, const std::string& value)
+{
+    put(out, static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+}
+
+// Reads back the values written with put, throwing
+// std::runtime_error if the buffer is exhausted.
+class Decoder
+{
+public:
+    Decoder(const std::string& buffer)
+        : it(buffer.data()),
+          end(buffer.data() + buffer.size())
+    {
+    }
+
+    std::uint32_t u32()
+    {
+        std::uint32_t result;
+        take(&result, sizeof(result));
+        return result;
+    }
+
+    std::uint64_t u64()
+    {
+        std::uint64_t result;
+        take(&result, sizeof(result));
+        return result;
+    }
+
+    std::string string()
+    {
+        auto size = u32();
+        std::string result(size, '\0');
+        take(&result[0], size);
+        return result;
+    }
+
+private:
+    void take(void* dest, std::size_t size)
+    {
+        if (static_cast<std::size_t>(end - it) < size)
+            throw std::runtime_error("Cache record is truncated.");
+
+        std::memcpy(dest, it, size);
+        it += size;
+    }
+
+    const char* it;
+    const char* end;
+};
+
+std::string encode(const std::string& key, const cache::Entry& entry)
+{
+    std::string result;
+
+    put(result, key);
+    put(result, static_cast<std::uint32_t>(entry.response.status));
+    put(result, ticks_of(entry.request_time));
+    put(result, ticks_of(entry.response_time));
+
+    std::vector<std::pair<std::string, std::string>> fields;
+    entry.response.header.enumerate([&fields](const std::string& key, const std::set<std::string>& values)
+    {
+        for (const auto& value : values)
+            fields.emplace_back(key, value);
+    });
+
+    put(result, static_cast<std::uint32_t>(fields.size()));
+    for (const auto& field : fields)
+    {
+        put(result, field.first);
+        put(result, field.second);
+    }
+
+    put(result, static_cast<std::uint32_t>(entry.variants.size()));
+    for (const auto& variant : entry.variants)
+    {
+        put(result, variant.first);
+        put(result, variant.second);
+    }
+
+    return result;
+}
+
+void decode(const std::string& buffer, std::string& key, cache::Entry& entry)
+{
+    Decoder decoder{buffer};
+
+    key = decoder.string();
+    entry.response.status = static_cast<http::Status>(decoder.u32());
+    entry.request_time = time_point_of(decoder.u64());
+    entry.response_time = time_point_of(decoder.u64());
+
+    for (auto count = decoder.u32(); count > 0; count--)
+    {
+        auto field = decoder.string();
+        entry.response.header.add(field, decoder.string());
+    }
+
+    for (auto count = decoder.u32(); count > 0; count--)
+    {
+        auto name = decoder.string();
+        entry.variants[name] = decoder.string();
+    }
+}
+
+// Hands out the body of a record straight from its segment file.
+class SegmentBlob : public cache::Blob
+{
+public:
+    SegmentBlob(const std::shared_ptr<Segment>& segment, std::uint64_t offset, std::uint64_t size)
+        : segment(segment),
+          offset(offset),
+          length(size)
+    {
+    }
+
+    std::uint64_t size() const override
+    {
+        return length;
+    }
+
+    std::size_t read(std::uint64_t at, char* dest, std::size_t size) const override
+    {
+        if (at >= length)
+            return 0;
+
+        auto result = static_cast<std::size_t>(std::min<std::uint64_t>(size, length - at));
+        read_fully(segment->fd, dest, result, offset + at);
+
+        return result;
+    }
+
+    // Returns true if the blob reads from file, starting at at.
+    bool reads_from(const std::shared_ptr<Segment>& file, std::uint64_t at) const
+    {
+        return segment == file && offset == at;
+    }
+
+private:
+    std::shared_ptr<Segment> segment;
+    std::uint64_t offset;
+    std::uint64_t length;
+};
+
+// Reads the record in slot, throwing std::runtime_error if it is corrupt.
+// Returns a nullptr if it belongs to a different key with the same hash.
+std::shared_ptr<const cache::Entry> read_record(const std::shared_ptr<Segment>& file, const Slot& slot, const std::string& key)
+{
+    RecordHeader rh;
+    read_fully(file->fd, &rh, sizeof(rh), slot.offset);
+
+    if (rh.magic != record_magic || rh.meta_size > rh.meta_capacity ||
+        sizeof(rh) + rh.meta_capacity + rh.body_size != slot.size)
+        throw std::runtime_error("Cache record is corrupt.");
+
+    std::string meta(rh.meta_size, '\0');
+    read_fully(file->fd, &meta[0], meta.size(), slot.offset + sizeof(rh));
+
+    if (crc_of(meta) != rh.crc)
+        throw std::runtime_error("Cache record is corrupt.");
+
+    auto result = std::make_shared<cache::Entry>();
+
+    std::string stored_key;
+    decode(meta, stored_key, *result);
+
+    // Different keys might end up with the same hash.
+    if (stored_key != key)
+        return std::shared_ptr<const cache::Entry>{};
+
+    result->blob = std::make_shared<SegmentBlob>(file, slot.offset + sizeof(rh) + rh.meta_capacity, rh.body_size);
+
+    return result;
+}
+}
+
+struct cache::DiskCache::Private
+{
+    struct SegmentState
+    {
+        std::shared_ptr<Segment> file;
+        // Number of bytes written to or reserved in the segment.
+        std::uint64_t size;
+        // Number of bytes occupied by records referenced from the index.
+        std::uint64_t live;
+        // Number of records currently being written to the segment.
+        std::uint32_t pending;
+    };
+
+    // A range at the end of a segment set aside for writing a record.
+    struct Reservation
+    {
+        std::uint32_t segment;
+        std::uint64_t offset;
+        std::shared_ptr<Segment> file;
+    };
+
+    // A record handed to store, waiting to be written by the background thread.
+    struct Write
+    {
+        std::shared_ptr<const cache::Entry> entry;
+        RecordHeader rh;
+        std::string meta;
+        // Size of the whole record in bytes.
+        std::uint64_t size;
+    };
+
+    Private(const std::string& directory, std::uint64_t capacity)
+        : directory(directory),
+          capacity(capacity),
+          segment_size(std::min(max_segment_size, std::max(min_segment_size, capacity / segments_per_capacity)))
+    {
+    }
+
+    ~Private()
+    {
+        {
+            std::lock_guard<std::mutex> lg(guard);
+            stop_requested = true;
+        }
+
+        wakeup.notify_all();
+
+        if (compactor.joinable())
+            compactor.join();
+
+        if (index_map != MAP_FAILED)
+            ::munmap(index_map, index_size);
+
+        // Closing the file releases the lock on the directory, too.
+        if (index_fd >= 0)
+            ::close(index_fd);
+    }
+
+    void open()
+    {
+        if (::mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST)
+            throw system_error_from_errno("Could not create cache directory " + directory);
+
+        auto discard_segments = open_index();
+        open_segments(discard_segments);
+
+        compactor = std::thread{[this]() { run_compactor(); }};
+    }
+
+    // Maps the index into memory, creating it if it is missing or invalid.
+    // Returns true if the segments have to be discarded as a consequence.
+    bool open_index()
+    {
+        auto path = directory + "/" + index_file_name;
+
+        index_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+        if (index_fd < 0)
+            throw system_error_from_errno("Could not open cache index " + path);
+
+        if (::flock(index_fd, LOCK_EX | LOCK_NB) != 0)
+            throw system_error_from_errno("Could not lock cache directory " + directory);
+
+        index_size = sizeof(IndexHeader) + slot_count * sizeof(Slot);
+
+        struct stat st;
+        if (::fstat(index_fd, &st) != 0)
+            throw system_error_from_errno("Could not query cache index " + path);
+
+        IndexHeader h{};
+        bool valid = static_cast<std::size_t>(st.st_size) == index_size;
+
+        if (valid)
+        {
+            read_fully(index_fd, &h, sizeof(h), 0);
+            valid = std::memcmp(h.magic, index_magic, sizeof(index_magic)) == 0 &&
+                    h.version == index_version &&
+                    h.slot_count == slot_count;
+        }
+
+        if (not valid)
+        {
+            // Truncating first makes sure that all slots read as empty.
+            if (::ftruncate(index_fd, 0) != 0 || ::ftruncate(index_fd, index_size) != 0)
+                throw system_error_from_errno("Could not resize cache index " + path);
+
+            h = IndexHeader{};
+            std::memcpy(h.magic, index_magic, sizeof(index_magic));
+            h.version = index_version;
+            h.slot_count = slot_count;
+
+            write_fully(index_fd, &h, sizeof(h), 0);
+        }
+
+        index_map = ::mmap(nullptr, index_size, PROT_READ | PROT_WRITE, MAP_SHARED, index_fd, 0);
+        if (index_map == MAP_FAILED)
+            throw system_error_from_errno("Could not map cache index " + path);
+
+        header = static_cast<IndexHeader*>(index_map);
+        slots = reinterpret_cast<Slot*>(header + 1);
+
+        return not valid;
+    }
+
+    // Opens all segment files and drops slots that refer to missing data.
+    void open_segments(bool discard)
+    {
+        auto dir = ::opendir(directory.c_str());
+        if (not dir)
+            throw system_error_from_errno("Could not list cache directory " + directory);
+
+        static const std::string prefix{segment_file_prefix};
+
+        while (auto de = ::readdir(dir))
+        {
+            std::string name{de->d_name};
+
+            if (name.compare(0, prefix.size(), prefix) != 0 || name.size() == prefix.size())
+                continue;
+
+            char* end{nullptr};
+            auto id = std::strtoul(name.c_str() + prefix.size(), &end, 10);
+
+            if (*end != '\0' || id >= no_slot)
+                continue;
+
+            auto path = directory + "/" + name;
+
+            if (discard)
+            {
+                ::unlink(path.c_str());
+                continue;
+            }
+
+            auto fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd < 0)
+                continue;
+
+            auto file = std::make_shared<Segment>(fd, path);
+
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+                continue;
+
+            segments[id] = SegmentState{file, static_cast<std::uint64_t>(st.st_size), 0, 0};
+            header->next_segment = std::max<std::uint32_t>(header->next_segment, id + 1);
+        }
+
+        ::closedir(dir);
+
+        for (std::uint32_t i = 0; i < slot_count; i++)
+        {
+            auto& slot = slots[i];
+
+            if (slot.state == SlotState::removed)
+                removed++;
+
+            if (slot.state != SlotState::used)
+                continue;
+
+            auto it = segments.find(slot.segment);
+
+            if (it == segments.end() || slot.offset + slot.size > it->second.size)
+            {
+                slot.state = SlotState::removed;
+                removed++;
+                continue;
+            }
+
+            it->second.live += slot.size;
+            live += slot.size;
+            entries++;
+            recency.emplace(slot.last_access, slot.hash);
+        }
+
+        // The capacity might have been lowered since the last run.
+        evict_for(0);
+
+        // Segments are not appended to across runs, compact them as needed.
+        compaction_requested = true;
+    }
+
+    std::string path_for_segment(std::uint32_t id) const
+    {
+        return directory + "/" + segment_file_prefix + std::to_string(id);
+    }
+
+    // The following functions have to be called with guard held.
+
+    // Returns the index of the slot holding hash, or no_slot.
+    std::uint32_t find(std::uint64_t hash) const
+    {
+        for (std::uint32_t i = 0; i < slot_count; i++)
+        {
+            auto index = (hash + i) & (slot_count - 1);
+            const auto& slot = slots[index];
+
+            if (slot.state == SlotState::empty)
+                break;
+
+            if (slot.state == SlotState::used && slot.hash == hash)
+                return index;
+        }
+
+        return no_slot;
+    }
+
+    // Returns the index of an unused slot for hash.
+    std::uint32_t insert(std::uint64_t hash)
+    {
+        if (entries + removed >= max_occupied_slots && removed > 0)
+            rehash();
+
+        while (entries >= max_occupied_slots)
+            evict_one();
+
+        for (std::uint32_t i = 0; i < slot_count; i++)
+        {
+            auto index = (hash + i) & (slot_count - 1);
+
+            switch (slots[index].state)
+            {
+            case SlotState::removed:
+                removed--;
+                return index;
+            case SlotState::empty:
+                return index;
+            case SlotState::used:
+                break;
+            }
+        }
+
+        throw std::logic_error("Cache index is full.");
+    }
+
+    // Reinserts all used slots, getting rid of removed ones.
+    void rehash()
+    {
+        std::vector<Slot> used;
+
+        for (std::uint32_t i = 0; i < slot_count; i++)
+            if (slots[i].state == SlotState::used)
+                used.push_back(slots[i]);
+
+        std::memset(slots, 0, slot_count * sizeof(Slot));
+        removed = 0;
+
+        for (const auto& slot : used)
+        {
+            for (std::uint32_t i = 0; i < slot_count; i++)
+            {
+                auto index = (slot.hash + i) & (slot_count - 1);
+
+                if (slots[index].state == SlotState::empty)
+                {
+                    slots[index] = slot;
+                    break;
+                }
+            }
+        }
+    }
+
+    void release(std::uint32_t index)
+    {
+        auto& slot = slots[index];
+
+        slot.state = SlotState::removed;
+        removed++;
+        entries--;
+        live -= slot.size;
+        recency.erase(std::make_pair(slot.last_access, slot.hash));
+
+        auto it = segments.find(slot.segment);
+        if (it != segments.end())
+        {
+            it->second.live -= slot.size;
+
+            if (slot.segment != active)
+            {
+                compaction_requested = true;
+                wakeup.notify_one();
+            }
+        }
+    }
+
+    // Marks the entry in the slot at index as the most recently used one.
+    void touch(std::uint32_t index)
+    {
+        auto& slot = slots[index];
+
+        recency.erase(std::make_pair(slot.last_access, slot.hash));
+        slot.last_access = ++header->clock;
+        recency.emplace(slot.last_access, slot.hash);
+    }
+
+    void evict_one()
+    {
+        if (recency.empty())
+            return;
+
+        auto lru = find(recency.begin()->second);
+
+        if (lru == no_slot)
+        {
+            recency.erase(recency.begin());
+            return;
+        }
+
+        release(lru);
+        evictions++;
+    }
+
+    // Evicts entries until a record of size bytes fits in.
+    void evict_for(std::uint64_t size)
+    {
+        while (entries > 0 && live + size > capacity)
+            evict_one();
+    }
+
+    Reservation reserve(std::uint64_t size)
+    {
+        auto it = segments.find(active);
+
+        if (it == segments.end() || (it->second.size > 0 && it->second.size + size > segment_size))
+        {
+            auto id = header->next_segment++;
+            auto path = path_for_segment(id);
+
+            auto fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+            if (fd < 0)
+                throw system_error_from_errno("Could not create cache segment " + path);
+
+            it = segments.emplace(id, SegmentState{std::make_shared<Segment>(fd, path), 0, 0, 0}).first;
+
+            // The previously active segment might be eligible for compaction now.
+            active = id;
+            compaction_requested = true;
+            wakeup.notify_one();
+        }
+
+        Reservation result{it->first, it->second.size, it->second.file};
+
+        it->second.size += size;
+        it->second.pending++;
+
+        return result;
+    }
+
+    // Makes the record written to reservation available under hash.
+    void commit(const Reservation& reservation, std::uint64_t hash, std::uint64_t size)
+    {
+        auto& segment = segments.at(reservation.segment);
+        segment.pending--;
+
+        auto existing = find(hash);
+        if (existing != no_slot)
+            release(existing);
+
+        evict_for(size);
+
+        auto index = insert(hash);
+        slots[index] = Slot{hash, reservation.offset, size, ++header->clock, reservation.segment, SlotState::used};
+        recency.emplace(slots[index].last_access, hash);
+
+        segment.live += size;
+        live += size;
+        entries++;
+    }
+
+    // Gives up on reservation, leaving a hole in its segment.
+    void abandon(const Reservation& reservation)
+    {
+        segments.at(reservation.segment).pending--;
+    }
+
+    // Replaces the metadata of the record stored under hash in place, if blob
+    // still reads from that record and meta fits. Readers that race with the
+    // update see a checksum mismatch and retry with guard held.
+    bool update(std::uint64_t hash, const SegmentBlob& blob, const std::string& meta)
+    {
+        auto index = find(hash);
+        if (index == no_slot)
+            return false;
+
+        const auto& slot = slots[index];
+        auto file = segments.at(slot.segment).file;
+
+        try
+        {
+            RecordHeader rh;
+            read_fully(file->fd, &rh, sizeof(rh), slot.offset);
+
+            if (rh.magic != record_magic || meta.size() > rh.meta_capacity ||
+                not blob.reads_from(file, slot.offset + sizeof(rh) + rh.meta_capacity))
+                return false;
+
+            rh.crc = crc_of(meta);
+            rh.meta_size = static_cast<std::uint32_t>(meta.size());
+
+            write_fully(file->fd, meta.data(), meta.size(), slot.offset + sizeof(rh));
+            write_fully(file->fd, &rh, sizeof(rh), slot.offset);
+        } catch (const std::exception&)
+        {
+            // The record might be torn now, but replacing it takes care of that.
+            return false;
+        }
+
+        touch(index);
+        return true;
+    }
+
+    // Drops the record queued for key, if any.
+    void dequeue(const std::string& key)
+    {
+        auto it = writes.find(key);
+
+        if (it == writes.end())
+            return;
+
+        queued -= it->second.size;
+        writes.erase(it);
+    }
+
+    // Writes the record queued for key and commits it, unless it has been
+    // replaced or removed meanwhile. Drops the lock while writing.
+    void write(std::unique_lock<std::mutex>& ul, const std::string& key)
+    {
+        auto record = writes.at(key);
+
+        Reservation reservation;
+
+        try
+        {
+            reservation = reserve(record.size);
+        } catch (...)
+        {
+            // Failing to write the entry is not an error, it is just not cached.
+            dequeue(key);
+            return;
+        }
+
+        ul.unlock();
+
+        bool written{true};
+
+        try
+        {
+            auto fd = reservation.file->fd;
+            auto offset = reservation.offset;
+
+            write_fully(fd, &record.rh, sizeof(record.rh), offset);
+            offset += sizeof(record.rh);
+            write_fully(fd, record.meta.data(), record.meta.size(), offset);
+            offset += record.rh.meta_capacity;
+
+            const auto& entry = *record.entry;
+
+            if (entry.blob)
+            {
+                std::vector<char> buffer(copy_buffer_size);
+                std::uint64_t at{0};
+
+                while (at < record.rh.body_size)
+                {
+                    auto chunk = entry.blob->read(at, buffer.data(), buffer.size());
+
+                    if (chunk == 0)
+                        throw std::runtime_error("Body of cache entry is truncated.");
+
+                    write_fully(fd, buffer.data(), chunk, offset + at);
+                    at += chunk;
+                }
+            } else
+            {
+                write_fully(fd, entry.response.body.data(), entry.response.body.size(), offset);
+            }
+        } catch (const std::exception&)
+        {
+            written = false;
+        }
+
+        ul.lock();
+
+        auto it = writes.find(key);
+        bool current = it != writes.end() && it->second.entry == record.entry;
+
+        if (current)
+            dequeue(key);
+
+        if (written && current)
+            commit(reservation, hash_of(key), record.size);
+        else
+            abandon(reservation);
+    }
+
+    // Writes queued records and compacts segments in the background.
+    void run_compactor()
+    {
+        std::unique_lock<std::mutex> ul(guard);
+
+        while (true)
+        {
+            wakeup.wait_for(ul, compaction_period, [this]()
+            {
+                return stop_requested || compaction_requested || not writes.empty();
+            });
+
+            // Queued records are written even when stopping, such that they survive restarts.
+            if (not writes.empty())
+            {
+                auto key = writes.begin()->first;
+                write(ul, key);
+                continue;
+            }
+
+            if (stop_requested)
+                break;
+
+            compaction_requested = false;
+
+            std::vector<std::uint32_t> candidates;
+
+            for (const auto& pair : segments)
+            {
+                if (pair.first == active || pair.second.pending > 0)
+                    continue;
+
+                if (pair.second.live < pair.second.size * compaction_threshold)
+                    candidates.push_back(pair.first);
+            }
+
+            for (auto id : candidates)
+            {
+                if (stop_requested)
+                    break;
+
+                compact(ul, id);
+            }
+        }
+    }
+
+    // Moves the live records of a segment to the active one and deletes it.
+    // Drops the lock while copying records, such that lookups can proceed.
+    void compact(std::unique_lock<std::mutex>& ul, std::uint32_t id)
+    {
+        auto source = segments.at(id).file;
+
+        std::vector<std::uint32_t> indices;
+        for (std::uint32_t i = 0; i < slot_count; i++)
+            if (slots[i].state == SlotState::used && slots[i].segment == id)
+                indices.push_back(i);
+
+        for (auto index : indices)
+        {
+            auto slot = slots[index];
+
+            if (slot.state != SlotState::used || slot.segment != id)
+                continue;
+
+            Reservation reservation;
+
+            try
+            {
+                reservation = reserve(slot.size);
+            } catch (...)
+            {
+                // We try again later on.
+                return;
+            }
+
+            ul.unlock();
+
+            bool copied{true};
+
+            try
+            {
+                copy_range(source->fd, slot.offset, reservation.file->fd, reservation.offset, slot.size);
+            } catch (...)
+            {
+                copied = false;
+            }
+
+            ul.lock();
+
+            auto& target = segments.at(reservation.segment);
+            target.pending--;
+
+            auto& current = slots[index];
+
+            // The entry might have been replaced or removed while copying.
+            if (copied && current.state == SlotState::used && current.segment == id && current.offset == slot.offset)
+            {
+                segments.at(id).live -= slot.size;
+                target.live += slot.size;
+                current.segment = reservation.segment;
+                current.offset = reservation.offset;
+            }
+        }
+
+        auto it = segments.find(id);
+
+        if (it != segments.end() && it->second.live == 0 && it->second.pending == 0 && id != active)
+        {
+            ::unlink(it->second.file->path.c_str());
+            segments.erase(it);
+        }
+    }
+
+    const std::string directory;
+    const std::uint64_t capacity;
+    const std::uint64_t segment_size;
+
+    int index_fd{-1};
+    void* index_map{MAP_FAILED};
+    std::size_t index_size{0};
+    IndexHeader* header{nullptr};
+    Slot* slots{nullptr};
+
+    mutable std::mutex guard;
+    std::map<std::uint32_t, SegmentState> segments;
+    std::uint32_t active{no_slot};
+
+    std::uint64_t live{0};
+    std::size_t entries{0};
+    std::size_t removed{0};
+    std::uint64_t evictions{0};
+    // Last access and hash of all used slots, least recently used first.
+    std::set<std::pair<std::uint64_t, std::uint64_t>> recency;
+
+    // Records waiting to be written, by key. Lookups are answered from here until they are written.
+    std::map<std::string, Write> writes;
+    // Sum of the sizes of the records in writes.
+    std::uint64_t queued{0};
+
+    std::condition_variable wakeup;
+    bool stop_requested{false};
+    bool compaction_requested{false};
+    std::thread compactor;
+};
+
+cache::DiskCache::DiskCache(const std::string& directory, std::uint64_t capacity)
+    : d(new Private(directory, capacity))
+{
+    d->open();
+}
+
+cache::DiskCache::~DiskCache()
+{
+}
+
+std::shared_ptr<const cache::Entry> cache::DiskCache::lookup(const std::string& key)
+{
+    auto hash = hash_of(key);
+
+    Slot slot;
+    std::shared_ptr<Segment> file;
+
+    {
+        std::lock_guard<std::mutex> lg(d->guard);
+
+        auto it = d->writes.find(key);
+        if (it != d->writes.end())
+            return it->second.entry;
+
+        auto index = d->find(hash);
+        if (index == no_slot)
+            return std::shared_ptr<const cache::Entry>{};
+
+        d->touch(index);
+        slot = d->slots[index];
+        file = d->segments.at(slot.segment).file;
+    }
+
+    try
+    {
+        return read_record(file, slot, key);
+    } catch (const std::exception&)
+    {
+    }
+
+    std::lock_guard<std::mutex> lg(d->guard);
+
+    auto index = d->find(hash);
+    if (index == no_slot || d->slots[index].segment != slot.segment || d->slots[index].offset != slot.offset)
+        return std::shared_ptr<const cache::Entry>{};
+
+    // Metadata is updated in place with guard held, so we might have raced with that.
+    try
+    {
+        return read_record(file, slot, key);
+    } catch (const std::exception&)
+    {
+        // Corrupt records are dropped.
+        d->release(index);
+    }
+
+    return std::shared_ptr<const cache::Entry>{};
+}
+
+void cache::DiskCache::store(const std::string& key, const std::shared_ptr<const cache::Entry>& entry)
+{
+    auto meta = encode(key, *entry);
+
+    auto meta_size = static_cast<std::uint32_t>(meta.size());
+    RecordHeader rh{record_magic, crc_of(meta), meta_size, meta_size + meta_slack, body_size_of(*entry)};
+    std::uint64_t size = sizeof(rh) + rh.meta_capacity + rh.body_size;
+
+    if (size > d->capacity)
+    {
+        remove(key);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lg(d->guard);
+
+    d->dequeue(key);
+
+    // Bodies are kept in memory until they are written, so we bound the records waiting.
+    if (d->queued > 0 && d->queued + size > d->segment_size)
+    {
+        auto index = d->find(hash_of(key));
+        if (index != no_slot)
+            d->release(index);
+
+        return;
+    }
+
+    d->writes.emplace(key, Private::Write{entry, rh, meta, size});
+    d->queued += size;
+    d->wakeup.notify_one();
+}
+
+void cache::DiskCache::refresh(const std::string& key, const std::shared_ptr<const cache::Entry>& entry)
+{
+    if (auto blob = std::dynamic_pointer_cast<const SegmentBlob>(entry->blob))
+    {
+        auto meta = encode(key, *entry);
+
+        std::lock_guard<std::mutex> lg(d->guard);
+        if (d->update(hash_of(key), *blob, meta))
+            return;
+    }
+
+    // The record has moved or changed since, or its metadata outgrew the slack.
+    store(key, entry);
+}
+
+void cache::DiskCache::remove(const std::string& key)
+{
+    std::lock_guard<std::mutex> lg(d->guard);
+
+    d->dequeue(key);
+
+    auto index = d->find(hash_of(key));
+    if (index != no_slot)
+        d->release(index);
+}
+
+cache::Cache::Statistics cache::DiskCache::statistics() const
+{
+    auto result = Cache::statistics();
+
+    std::lock_guard<std::mutex> lg(d->guard);
+
+    result.evictions = d->evictions;
+    result.entries = d->entries;
+    result.size = d->live;
+
+    // Records waiting to be written count as if they were written already.
+    for (const auto& pair : d->writes)
+    {
+        auto index = d->find(hash_of(pair.first));
+
+        if (index == no_slot)
+            result.entries++;
+        else
+            result.size -= d->slots[index].size;
+
+        result.size += pair.second.size;
+    }
+
+    return result;
+}
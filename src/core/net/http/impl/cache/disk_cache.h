@@ -0,0 +1,80 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CACHE_DISK_CACHE_H_
+#define CORE_NET_HTTP_IMPL_CACHE_DISK_CACHE_H_
+
+#include "cache.h"
+
+#include <memory>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace cache
+{
+// Keeps entries in a directory, such that they survive restarts of the process.
+//
+// The directory contains a memory-mapped index, a hash table mapping keys
+// to records, and a set of append-only segment files holding the records.
+// Removed or replaced records leave holes in their segment, and a
+// background thread compacts segments by moving the live records of
+// mostly empty segments to the end of the active segment. Least recently
+// used entries are evicted whenever the records occupy more than capacity bytes.
+//
+// Bodies are not loaded into memory, but handed out as blobs that read
+// from the segment files. Records leave some room after their metadata,
+// such that refreshing an entry does not copy its body.
+//
+// Stored entries are written by the background thread, too, such that
+// callers never wait for their bodies to reach the disk. Until then,
+// lookups answer them from memory.
+class DiskCache : public Cache
+{
+public:
+    // Opens the cache in directory, creating it if necessary. The directory is
+    // locked for exclusive use by this instance. Throws std::system_error in
+    // case of issues, e.g., if the directory is used by another instance.
+    DiskCache(const std::string& directory, std::uint64_t capacity);
+    ~DiskCache();
+
+    // From Cache
+    std::shared_ptr<const Entry> lookup(const std::string& key) override;
+    // Queues entry for writing and returns right away. Failing to write
+    // the entry is not an error, it is just not cached.
+    void store(const std::string& key, const std::shared_ptr<const Entry>& entry) override;
+    // Rewrites the metadata of the record in place if entry was read from it.
+    void refresh(const std::string& key, const std::shared_ptr<const Entry>& entry) override;
+    void remove(const std::string& key) override;
+    Statistics statistics() const override;
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CACHE_DISK_CACHE_H_
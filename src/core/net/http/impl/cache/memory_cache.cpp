@@ -0,0 +1,115 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "memory_cache.h"
+
+namespace cache = core::net::http::impl::cache;
+
+namespace
+{
+// Approximates the number of bytes occupied by an entry stored for key.
+std::size_t size_of(const std::string& key, const cache::Entry& entry)
+{
+    std::size_t result{sizeof(cache::Entry) + key.size() + entry.response.body.size()};
+
+    entry.response.header.enumerate([&result](const std::string& key, const std::set<std::string>& values)
+    {
+        for (const auto& value : values)
+            result += key.size() + value.size();
+    });
+
+    for (const auto& variant : entry.variants)
+        result += variant.first.size() + variant.second.size();
+
+    return result;
+}
+}
+
+cache::MemoryCache::MemoryCache(std::size_t capacity)
+    : capacity(capacity)
+{
+}
+
+std::shared_ptr<const cache::Entry> cache::MemoryCache::lookup(const std::string& key)
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    auto it = index.find(key);
+
+    if (it == index.end())
+        return std::shared_ptr<const cache::Entry>{};
+
+    // Mark the item as most recently used.
+    items.splice(items.begin(), items, it->second);
+
+    return it->second->entry;
+}
+
+void cache::MemoryCache::store(const std::string& key, const std::shared_ptr<const cache::Entry>& entry)
+{
+    auto item_size = size_of(key, *entry);
+
+    std::lock_guard<std::mutex> lg(guard);
+
+    auto it = index.find(key);
+    if (it != index.end())
+        erase(it->second);
+
+    // Entries larger than the whole cache would just flush it.
+    if (item_size > capacity)
+        return;
+
+    while (size + item_size > capacity && not items.empty())
+    {
+        erase(std::prev(items.end()));
+        ++evictions;
+    }
+
+    items.push_front(Item{key, entry, item_size});
+    index[key] = items.begin();
+    size += item_size;
+}
+
+void cache::MemoryCache::remove(const std::string& key)
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    auto it = index.find(key);
+    if (it != index.end())
+        erase(it->second);
+}
+
+cache::Cache::Statistics cache::MemoryCache::statistics() const
+{
+    auto result = Cache::statistics();
+
+    std::lock_guard<std::mutex> lg(guard);
+
+    result.evictions = evictions;
+    result.entries = items.size();
+    result.size = size;
+
+    return result;
+}
+
+void cache::MemoryCache::erase(cache::MemoryCache::Items::iterator it)
+{
+    size -= it->size;
+    index.erase(it->key);
+    items.erase(it);
+}
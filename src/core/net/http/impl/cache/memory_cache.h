@@ -0,0 +1,79 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CACHE_MEMORY_CACHE_H_
+#define CORE_NET_HTTP_IMPL_CACHE_MEMORY_CACHE_H_
+
+#include "cache.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace cache
+{
+// Keeps entries in memory, evicting the least recently used
+// ones whenever the entries occupy more than capacity bytes.
+class MemoryCache : public Cache
+{
+public:
+    // Creates a new instance bounded by capacity bytes.
+    MemoryCache(std::size_t capacity);
+
+    // From Cache
+    std::shared_ptr<const Entry> lookup(const std::string& key) override;
+    void store(const std::string& key, const std::shared_ptr<const Entry>& entry) override;
+    void remove(const std::string& key) override;
+    Statistics statistics() const override;
+
+private:
+    struct Item
+    {
+        std::string key;
+        std::shared_ptr<const Entry> entry;
+        std::size_t size;
+    };
+
+    // Most recently used items go to the front.
+    typedef std::list<Item> Items;
+
+    // Erases the item that it points to. Has to be called with guard held.
+    void erase(Items::iterator it);
+
+    const std::size_t capacity;
+
+    mutable std::mutex guard;
+    Items items;
+    std::unordered_map<std::string, Items::iterator> index;
+    std::size_t size{0};
+    std::uint64_t evictions{0};
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CACHE_MEMORY_CACHE_H_
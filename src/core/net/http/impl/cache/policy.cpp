@@ -0,0 +1,460 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "policy.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace cache = core::net::http::impl::cache;
+namespace http = core::net::http;
+
+namespace
+{
+typedef cache::Entry::Clock Clock;
+typedef std::map<std::string, std::string> Directives;
+
+// Percentage of the time since the last modification that is assumed to
+// be the lifetime of a response without explicit expiration time.
+constexpr const double heuristic_fraction{0.1};
+
+std::string trim(const std::string& s)
+{
+    static constexpr const char* whitespace{" \t\r\n"};
+
+    auto begin = s.find_first_not_of(whitespace);
+    if (begin == std::string::npos)
+        return std::string{};
+
+    return s.substr(begin, s.find_last_not_of(whitespace) - begin + 1);
+}
+
+std::string to_lower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+// Splits up a comma-separated list of values, dropping empty elements.
+std::vector<std::string> split_list(const std::string& s)
+{
+    std::vector<std::string> result;
+    std::stringstream ss{s};
+
+    for (std::string element; std::getline(ss, element, ',');)
+    {
+        element = trim(element);
+        if (not element.empty())
+            result.push_back(element);
+    }
+
+    return result;
+}
+
+// Looks up the field key in header, joining multiple values with a comma.
+// Returns false if header does not contain the field.
+bool value_of(const http::Header& header, const std::string& key, std::string& value)
+{
+    auto canonical_key = http::Header::canonicalize_key(key);
+    bool found{false};
+
+    header.enumerate([&](const std::string& k, const std::set<std::string>& values)
+    {
+        if (k != canonical_key)
+            return;
+
+        found = true;
+        value.clear();
+
+        for (const auto& v : values)
+        {
+            if (not value.empty())
+                value += ", ";
+            value += v;
+        }
+    });
+
+    return found;
+}
+
+// Parses the directives from the Cache-Control field of header.
+Directives cache_control_of(const http::Header& header)
+{
+    Directives result;
+    std::string value;
+
+    if (not value_of(header, "Cache-Control", value))
+        return result;
+
+    for (const auto& directive : split_list(value))
+    {
+        auto pos = directive.find('=');
+
+        auto name = to_lower(trim(directive.substr(0, pos)));
+        auto argument = pos == std::string::npos ? std::string{} : trim(directive.substr(pos + 1));
+
+        if (argument.size() >= 2 && argument.front() == '"' && argument.back() == '"')
+            argument = argument.substr(1, argument.size() - 2);
+
+        result.emplace(name, argument);
+    }
+
+    return result;
+}
+
+// Parses delta-seconds, see RFC 7234, section 1.2.1.
+bool parse_seconds(const std::string& s, std::chrono::seconds& result)
+{
+    if (s.empty() || not std::all_of(s.begin(), s.end(), [](unsigned char c) { return std::isdigit(c); }))
+        return false;
+
+    // Values too large to be represented are treated as "infinity" by clamping them.
+    static constexpr const long long max_seconds{std::numeric_limits<int>::max()};
+    auto value = std::strtoull(s.c_str(), nullptr, 10);
+    result = std::chrono::seconds{std::min<unsigned long long>(value, max_seconds)};
+
+    return true;
+}
+
+bool seconds_of(const Directives& directives, const std::string& name, std::chrono::seconds& result)
+{
+    auto it = directives.find(name);
+    return it != directives.end() && parse_seconds(it->second, result);
+}
+
+// Parses an IMF-fixdate, independent of the current locale.
+bool parse_imf_fixdate(const std::string& s, std::tm& tm)
+{
+    static constexpr const char* months[] =
+    {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+    };
+
+    char day_name[4], month[4];
+    int consumed{0};
+
+    if (std::sscanf(s.c_str(), "%3s, %2d %3s %4d %2d:%2d:%2d GMT%n",
+                    day_name, &tm.tm_mday, month, &tm.tm_year,
+                    &tm.tm_hour, &tm.tm_min, &tm.tm_sec, &consumed) != 7)
+        return false;
+
+    if (static_cast<std::size_t>(consumed) != s.size())
+        return false;
+
+    auto it = std::find_if(std::begin(months), std::end(months), [&month](const char* m)
+    {
+        return std::strcmp(m, month) == 0;
+    });
+
+    if (it == std::end(months))
+        return false;
+
+    tm.tm_mon = it - std::begin(months);
+    tm.tm_year -= 1900;
+
+    return true;
+}
+
+// Parses an HTTP-date in any of the formats listed in RFC 7231, section 7.1.1.1.
+bool parse_http_date(const std::string& s, Clock::time_point& result)
+{
+    static constexpr const char* obsolete_formats[] =
+    {
+        "%A, %d-%b-%y %H:%M:%S GMT", // RFC 850 format
+        "%a %b %d %H:%M:%S %Y"       // ANSI C's asctime() format
+    };
+
+    std::tm tm{};
+
+    bool parsed = parse_imf_fixdate(s, tm);
+
+    for (auto format : obsolete_formats)
+    {
+        if (parsed)
+            break;
+
+        tm = std::tm{};
+        auto end = ::strptime(s.c_str(), format, &tm);
+        parsed = end && *end == '\0';
+    }
+
+    if (parsed)
+        result = Clock::from_time_t(::timegm(&tm));
+
+    return parsed;
+}
+
+bool date_of(const http::Header& header, const std::string& key, Clock::time_point& result)
+{
+    std::string value;
+    return value_of(header, key, value) && parse_http_date(value, result);
+}
+
+// Returns the value of the Date field, or the time the response
+// was received if the origin server did not send one.
+Clock::time_point date_of(const cache::Entry& entry)
+{
+    Clock::time_point result;
+
+    if (not date_of(entry.response.header, "Date", result))
+        result = entry.response_time;
+
+    return result;
+}
+
+// See RFC 7231, section 6.1.
+bool is_cacheable_by_default(http::Status status)
+{
+    switch (status)
+    {
+    case http::Status::ok:
+    case http::Status::non_authorative_info:
+    case http::Status::no_content:
+    case http::Status::multiple_choices:
+    case http::Status::moved_permanently:
+    case http::Status::not_found:
+    case http::Status::method_not_allowed:
+    case http::Status::gone:
+    case http::Status::request_uri_too_long:
+    case http::Status::not_implemented:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+// See RFC 7234, section 4.2.1.
+Clock::duration freshness_lifetime_of(const cache::Entry& entry, const Directives& directives)
+{
+    std::chrono::seconds max_age;
+    if (seconds_of(directives, "max-age", max_age))
+        return max_age;
+
+    std::string expires;
+    if (value_of(entry.response.header, "Expires", expires))
+    {
+        Clock::time_point tp;
+
+        // Invalid dates, e.g., 0, represent a time in the past.
+        if (not parse_http_date(expires, tp))
+            return Clock::duration::zero();
+
+        return std::max(Clock::duration::zero(), tp - date_of(entry));
+    }
+
+    Clock::time_point last_modified;
+    if (date_of(entry.response.header, "Last-Modified", last_modified))
+    {
+        auto since_last_modification = std::max(Clock::duration::zero(), date_of(entry) - last_modified);
+        return std::chrono::duration_cast<Clock::duration>(since_last_modification * heuristic_fraction);
+    }
+
+    return Clock::duration::zero();
+}
+
+// See RFC 7234, section 4.2.3.
+Clock::duration current_age_of(const cache::Entry& entry, const Clock::time_point& now)
+{
+    std::chrono::seconds age_value{0};
+
+    std::string age;
+    if (value_of(entry.response.header, "Age", age))
+        parse_seconds(age, age_value);
+
+    auto apparent_age = std::max(Clock::duration::zero(), entry.response_time - date_of(entry));
+    auto response_delay = entry.response_time - entry.request_time;
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = std::max(apparent_age, corrected_age_value);
+    auto resident_time = now - entry.response_time;
+
+    return corrected_initial_age + resident_time;
+}
+}
+
+bool cache::is_cacheable(http::Method method, const http::Header& header)
+{
+    if (method != http::Method::get && method != http::Method::head)
+        return false;
+
+    return not header.has("If-None-Match") &&
+           not header.has("If-Modified-Since") &&
+           not header.has("Range");
+}
+
+std::string cache::key_for(http::Method method, const std::string& uri)
+{
+    switch (method)
+    {
+    case http::Method::get: return "GET " + uri;
+    case http::Method::head: return "HEAD " + uri;
+    default: break;
+    }
+
+    throw std::logic_error("Only responses to GET and HEAD requests are cached.");
+}
+
+bool cache::is_storable(const http::Header& header, const http::Response& response)
+{
+    if (not is_cacheable_by_default(response.status))
+        return false;
+
+    if (cache_control_of(header).count("no-store") > 0)
+        return false;
+
+    auto directives = cache_control_of(response.header);
+
+    if (directives.count("no-store") > 0)
+        return false;
+
+    std::string vary;
+    if (value_of(response.header, "Vary", vary) && vary.find('*') != std::string::npos)
+        return false;
+
+    // Responses that are stale right away and cannot be validated are of no use.
+    return directives.count("max-age") > 0 ||
+           directives.count("public") > 0 ||
+           response.header.has("Expires") ||
+           response.header.has("Last-Modified") ||
+           response.header.has("ETag");
+}
+
+std::shared_ptr<cache::Entry> cache::entry_for(const http::Header& header,
+                                               const http::Response& response,
+                                               const cache::Entry::Clock::time_point& request_time,
+                                               const cache::Entry::Clock::time_point& response_time)
+{
+    auto result = std::make_shared<cache::Entry>();
+
+    result->response = response;
+    // The transfer that yielded the response is of no interest to later requests.
+    result->response.transfer = http::Response::Transfer{};
+    result->request_time = request_time;
+    result->response_time = response_time;
+
+    std::string vary;
+    if (value_of(response.header, "Vary", vary))
+    {
+        for (const auto& name : split_list(vary))
+        {
+            std::string value;
+            value_of(header, name, value);
+            result->variants[http::Header::canonicalize_key(name)] = value;
+        }
+    }
+
+    return result;
+}
+
+bool cache::matches(const cache::Entry& entry, const http::Header& header)
+{
+    for (const auto& variant : entry.variants)
+    {
+        std::string value;
+        value_of(header, variant.first, value);
+
+        if (value != variant.second)
+            return false;
+    }
+
+    return true;
+}
+
+bool cache::is_fresh(const cache::Entry& entry, const http::Header& header, const cache::Entry::Clock::time_point& now)
+{
+    auto response_directives = cache_control_of(entry.response.header);
+
+    if (response_directives.count("no-cache") > 0)
+        return false;
+
+    auto request_directives = cache_control_of(header);
+
+    if (request_directives.count("no-cache") > 0)
+        return false;
+
+    // Pragma: no-cache is only honored in the absence of Cache-Control, see RFC 7234, section 5.4.
+    if (not header.has("Cache-Control") && header.has("Pragma", "no-cache"))
+        return false;
+
+    auto lifetime = freshness_lifetime_of(entry, response_directives);
+    auto age = current_age_of(entry, now);
+
+    std::chrono::seconds limit;
+
+    if (seconds_of(request_directives, "max-age", limit) && age > limit)
+        return false;
+
+    if (seconds_of(request_directives, "min-fresh", limit) && lifetime - age < limit)
+        return false;
+
+    return lifetime > age;
+}
+
+bool cache::has_validators(const cache::Entry& entry)
+{
+    return entry.response.header.has("ETag") || entry.response.header.has("Last-Modified");
+}
+
+http::Header cache::conditional_header_for(const cache::Entry& entry)
+{
+    http::Header result;
+    std::string value;
+
+    if (value_of(entry.response.header, "ETag", value))
+        result.set("If-None-Match", value);
+
+    if (value_of(entry.response.header, "Last-Modified", value))
+        result.set("If-Modified-Since", value);
+
+    return result;
+}
+
+std::shared_ptr<cache::Entry> cache::refresh(const cache::Entry& entry,
+                                             const http::Response& not_modified,
+                                             const cache::Entry::Clock::time_point& request_time,
+                                             const cache::Entry::Clock::time_point& response_time)
+{
+    auto result = std::make_shared<cache::Entry>(entry);
+
+    result->request_time = request_time;
+    result->response_time = response_time;
+
+    // See RFC 7234, section 4.3.4: the stored header fields are replaced with
+    // the ones sent along with the 304, except for the ones describing the body.
+    not_modified.header.enumerate([&result](const std::string& key, const std::set<std::string>& values)
+    {
+        if (key == "Content-Length" || key == "Content-Encoding" || key == "Transfer-Encoding")
+            return;
+
+        result->response.header.remove(key);
+
+        for (const auto& value : values)
+            result->response.header.add(key, value);
+    });
+
+    return result;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CACHE_POLICY_H_
+#define CORE_NET_HTTP_IMPL_CACHE_POLICY_H_
+
+#include "cache.h"
+
+#include <core/net/http/header.h>
+#include <core/net/http/method.h>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace cache
+{
+// The functions in here implement the rules of RFC 7234 for a private cache.
+
+// Returns true if requests with the given method and header are answered from
+// the cache. Conditional requests set up by the caller bypass the cache.
+bool is_cacheable(http::Method method, const http::Header& header);
+
+// Returns the primary key for caching a request. Header fields listed in Vary
+// are not part of the key, so a single variant per URI is kept: storing a response
+// for one variant replaces the one for any other, and matches() tells them apart.
+std::string key_for(http::Method method, const std::string& uri);
+
+// Returns true if response to a request carrying header may be stored.
+bool is_storable(const http::Header& header, const http::Response& response);
+
+// Creates a new entry for response, recording the values of the request header
+// fields the response varies on.
+std::shared_ptr<Entry> entry_for(const http::Header& header,
+                                 const http::Response& response,
+                                 const Entry::Clock::time_point& request_time,
+                                 const Entry::Clock::time_point& response_time);
+
+// Returns true if entry can answer a request carrying header, i.e.,
+// if all request header fields the entry varies on have the same values.
+bool matches(const Entry& entry, const http::Header& header);
+
+// Returns true if entry can be served to a request carrying header at
+// the point in time now without validating it with the origin server.
+bool is_fresh(const Entry& entry, const http::Header& header, const Entry::Clock::time_point& now);
+
+// Returns true if entry carries an ETag or a Last-Modified date.
+bool has_validators(const Entry& entry);
+
+// Returns the header fields turning a request into a conditional
+// one that validates entry with the origin server.
+http::Header conditional_header_for(const Entry& entry);
+
+// Creates a new entry from entry, updated with the header fields sent
+// along with a 304 response that was received at response_time.
+std::shared_ptr<Entry> refresh(const Entry& entry,
+                               const http::Response& not_modified,
+                               const Entry::Clock::time_point& request_time,
+                               const Entry::Clock::time_point& response_time);
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CACHE_POLICY_H_
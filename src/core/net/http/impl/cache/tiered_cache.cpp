@@ -0,0 +1,86 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "tiered_cache.h"
+
+namespace cache = core::net::http::impl::cache;
+
+cache::TieredCache::TieredCache(const std::shared_ptr<cache::Cache>& memory,
+                                const std::shared_ptr<cache::Cache>& disk,
+                                std::uint64_t threshold)
+    : memory(memory),
+      disk(disk),
+      threshold(threshold)
+{
+}
+
+std::shared_ptr<const cache::Entry> cache::TieredCache::lookup(const std::string& key)
+{
+    if (auto result = memory->lookup(key))
+        return result;
+
+    return disk->lookup(key);
+}
+
+void cache::TieredCache::store(const std::string& key, const std::shared_ptr<const cache::Entry>& entry)
+{
+    // Entries coming from disk stay there, e.g., after the threshold has been raised, instead
+    // of reading their bodies into memory. They move once replaced by a response from the network.
+    if (entry->blob || body_size_of(*entry) >= threshold)
+    {
+        memory->remove(key);
+        disk->store(key, entry);
+        return;
+    }
+
+    memory->store(key, entry);
+    disk->remove(key);
+}
+
+void cache::TieredCache::refresh(const std::string& key, const std::shared_ptr<const cache::Entry>& entry)
+{
+    if (entry->blob)
+    {
+        disk->refresh(key, entry);
+        return;
+    }
+
+    store(key, entry);
+}
+
+void cache::TieredCache::remove(const std::string& key)
+{
+    memory->remove(key);
+    disk->remove(key);
+}
+
+cache::Cache::Statistics cache::TieredCache::statistics() const
+{
+    auto result = Cache::statistics();
+
+    for (const auto& tier : {memory, disk})
+    {
+        auto statistics = tier->statistics();
+
+        result.evictions += statistics.evictions;
+        result.entries += statistics.entries;
+        result.size += statistics.size;
+    }
+
+    return result;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CACHE_TIERED_CACHE_H_
+#define CORE_NET_HTTP_IMPL_CACHE_TIERED_CACHE_H_
+
+#include "cache.h"
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace cache
+{
+// Keeps entries with small bodies in memory, and ones
+// with bodies of at least threshold bytes on disk. Entries
+// read from disk are never moved to memory.
+class TieredCache : public Cache
+{
+public:
+    TieredCache(const std::shared_ptr<Cache>& memory,
+                const std::shared_ptr<Cache>& disk,
+                std::uint64_t threshold);
+
+    // From Cache
+    std::shared_ptr<const Entry> lookup(const std::string& key) override;
+    void store(const std::string& key, const std::shared_ptr<const Entry>& entry) override;
+    void refresh(const std::string& key, const std::shared_ptr<const Entry>& entry) override;
+    void remove(const std::string& key) override;
+    Statistics statistics() const override;
+
+private:
+    std::shared_ptr<Cache> memory;
+    std::shared_ptr<Cache> disk;
+    std::uint64_t threshold;
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CACHE_TIERED_CACHE_H_
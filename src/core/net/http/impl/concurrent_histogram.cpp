@@ -0,0 +1,110 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "concurrent_histogram.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace http = core::net::http;
+
+namespace
+{
+std::uint64_t bits_of(double value)
+{
+    std::uint64_t result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+double value_of(std::uint64_t bits)
+{
+    double result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// Applies op to the double kept in target, retrying until no other thread interferes.
+template<typename Op>
+void update(std::atomic<std::uint64_t>& target, Op op)
+{
+    auto expected = target.load(std::memory_order_relaxed);
+    while (not target.compare_exchange_weak(expected, bits_of(op(value_of(expected))), std::memory_order_relaxed));
+}
+
+// Returns the current value of target, replacing it with initial if reset is true.
+std::uint64_t take(std::atomic<std::uint64_t>& target, std::uint64_t initial, bool reset)
+{
+    return reset
+            ? target.exchange(initial, std::memory_order_relaxed)
+            : target.load(std::memory_order_relaxed);
+}
+
+const std::uint64_t empty_minimum{bits_of(http::Histogram::Seconds::max().count())};
+const std::uint64_t zero{bits_of(0.)};
+}
+
+http::impl::ConcurrentHistogram::ConcurrentHistogram()
+    : buckets(new std::atomic<std::uint64_t>[Histogram::bucket_count()]),
+      total(0),
+      minimum(empty_minimum),
+      maximum(zero),
+      sum_of_durations(zero),
+      sum_of_squares(zero)
+{
+    for (std::size_t i = 0; i < Histogram::bucket_count(); i++)
+        buckets[i].store(0, std::memory_order_relaxed);
+}
+
+void http::impl::ConcurrentHistogram::record(const Histogram::Seconds& duration)
+{
+    auto value = std::max(0., duration.count());
+
+    buckets[Histogram::index_for(duration)].fetch_add(1, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+
+    update(minimum, [value](double current) { return std::min(current, value); });
+    update(maximum, [value](double current) { return std::max(current, value); });
+    update(sum_of_durations, [value](double current) { return current + value; });
+    update(sum_of_squares, [value](double current) { return current + value * value; });
+}
+
+void http::impl::ConcurrentHistogram::collect(Histogram& histogram, bool reset)
+{
+    // The total is merely a hint that there is something to collect: relaxed
+    // operations do not order it with the buckets, and durations recorded while
+    // resetting might be counted in one but not the other. Summing up the buckets
+    // we take keeps the total of histogram consistent with its buckets.
+    auto hint = take(total, 0, reset);
+
+    if (hint > 0 || reset)
+    {
+        // Collecting straight into histogram spares us a temporary and a pass over its buckets.
+        for (std::size_t i = 0; i < Histogram::bucket_count(); i++)
+        {
+            auto count = take(buckets[i], 0, reset);
+            histogram.buckets[i] += count;
+            histogram.total += count;
+        }
+    }
+
+    histogram.minimum = std::min(histogram.minimum, value_of(take(minimum, empty_minimum, reset)));
+    histogram.maximum = std::max(histogram.maximum, value_of(take(maximum, zero, reset)));
+    histogram.sum_of_durations += value_of(take(sum_of_durations, zero, reset));
+    histogram.sum_of_squares += value_of(take(sum_of_squares, zero, reset));
+}
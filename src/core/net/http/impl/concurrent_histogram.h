@@ -0,0 +1,68 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CONCURRENT_HISTOGRAM_H_
+#define CORE_NET_HTTP_IMPL_CONCURRENT_HISTOGRAM_H_
+
+#include <core/net/http/histogram.h>
+
+#include <atomic>
+#include <memory>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+// A histogram with the bucket layout of http::Histogram that can be recorded
+// to and collected from concurrently without locking. Recording is wait-free
+// apart from updating minimum, maximum and sums, which retry on contention.
+class ConcurrentHistogram
+{
+public:
+    ConcurrentHistogram();
+
+    ConcurrentHistogram(const ConcurrentHistogram&) = delete;
+    ConcurrentHistogram& operator=(const ConcurrentHistogram&) = delete;
+
+    // Records a single duration.
+    void record(const Histogram::Seconds& duration);
+
+    // Adds all durations recorded so far to histogram, and drops them if reset
+    // is true. Durations recorded while collecting might only partially show up
+    // in the summary of histogram, they are never lost from its buckets though.
+    void collect(Histogram& histogram, bool reset);
+
+private:
+    std::unique_ptr<std::atomic<std::uint64_t>[]> buckets;
+    // Number of durations recorded, only used to skip collecting the buckets of idle histograms.
+    std::atomic<std::uint64_t> total;
+    // Doubles are kept as their bit patterns, as there are no atomic operations for them.
+    std::atomic<std::uint64_t> minimum;
+    std::atomic<std::uint64_t> maximum;
+    std::atomic<std::uint64_t> sum_of_durations;
+    std::atomic<std::uint64_t> sum_of_squares;
+};
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CONCURRENT_HISTOGRAM_H_
@@ -0,0 +1,362 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "cached_request.h"
+#include "request.h"
+
+#include "../cache/policy.h"
+
+#include <core/net/percent_encoding.h>
+
+namespace http = core::net::http;
+namespace cache = core::net::http::impl::cache;
+
+namespace
+{
+// Size of the chunks that bodies kept in blobs are handed out in.
+constexpr const std::size_t chunk_size{64 * 1024};
+
+// Reads the next chunk of the body of entry, starting at offset. Returns false at the end of the body.
+bool read_chunk(const cache::Entry& entry, std::uint64_t offset, std::string& chunk)
+{
+    if (offset >= entry.blob->size())
+        return false;
+
+    chunk.resize(chunk_size);
+    auto size = entry.blob->read(offset, &chunk[0], chunk.size());
+
+    if (size == 0)
+        throw std::runtime_error("Body of cache entry is truncated.");
+
+    chunk.resize(size);
+    return true;
+}
+
+// Streams the body of an entry kept in a blob to a data handler,
+// one chunk per iteration of the reactor, as if it came from the network.
+// Like the network path, the body accumulates in the response handed out.
+class BodyStream : public std::enable_shared_from_this<BodyStream>
+{
+public:
+    BodyStream(::curl::multi::Handle multi,
+               const std::shared_ptr<const cache::Entry>& entry,
+               const http::Request::Handler& handler,
+               const http::StreamingRequest::DataHandler& dh)
+        : multi(multi),
+          entry(entry),
+          handler(handler),
+          dh(dh),
+          response(entry->response)
+    {
+    }
+
+    void next()
+    {
+        try
+        {
+            if (read_chunk(*entry, response.body.size(), chunk))
+            {
+                dh(chunk);
+                response.body.append(chunk);
+
+                auto thiz = shared_from_this();
+                multi.dispatch([thiz]() { thiz->next(); });
+
+                return;
+            }
+        } catch (const std::exception& e)
+        {
+            if (handler.on_error())
+                handler.on_error()(http::Error(e.what(), CORE_FROM_HERE()));
+
+            return;
+        }
+
+        if (handler.on_response())
+            handler.on_response()(response);
+    }
+
+private:
+    ::curl::multi::Handle multi;
+    std::shared_ptr<const cache::Entry> entry;
+    http::Request::Handler handler;
+    http::StreamingRequest::DataHandler dh;
+    http::Response response;
+    std::string chunk;
+};
+}
+
+http::impl::curl::CachedRequest::CachedRequest(::curl::multi::Handle multi,
+                                               const std::shared_ptr<cache::Cache>& cache,
+                                               const std::string& key,
+                                               const http::Header& header,
+                                               const Factory& factory)
+    : multi(multi),
+      cache(cache),
+      key(key),
+      header(header),
+      factory(factory),
+      started(false),
+      served_from_cache(false)
+{
+}
+
+http::Request::State http::impl::curl::CachedRequest::state()
+{
+    if (served_from_cache.load())
+        return http::Request::State::done;
+
+    std::lock_guard<std::mutex> lg(guard);
+
+    if (request)
+        return request->state();
+
+    return started.load() ? http::Request::State::active : http::Request::State::ready;
+}
+
+void http::impl::curl::CachedRequest::set_timeout(const std::chrono::milliseconds& timeout)
+{
+    configure([timeout](curl::Request& request) { request.set_timeout(timeout); });
+}
+
+http::Response http::impl::curl::CachedRequest::execute(const http::Request::ProgressHandler& ph)
+{
+    return execute(ph, [](const std::string&){});
+}
+
+http::Response http::impl::curl::CachedRequest::execute(const http::Request::ProgressHandler& ph,
+                                                        const http::StreamingRequest::DataHandler& dh)
+{
+    std::shared_ptr<const cache::Entry> stale;
+    auto fresh = prepare(stale);
+
+    if (fresh)
+    {
+        try
+        {
+            return serve(*fresh, dh);
+        } catch (const std::exception& e)
+        {
+            throw http::Error(e.what(), CORE_FROM_HERE());
+        }
+    }
+
+    auto request_time = cache::Entry::Clock::now();
+    auto response = network()->execute(ph, dh);
+
+    try
+    {
+        return complete(stale, request_time, response, dh);
+    } catch (const std::exception& e)
+    {
+        throw http::Error(e.what(), CORE_FROM_HERE());
+    }
+}
+
+void http::impl::curl::CachedRequest::async_execute(const http::Request::Handler& handler)
+{
+    async_execute(handler, [](const std::string&){});
+}
+
+void http::impl::curl::CachedRequest::async_execute(const http::Request::Handler& handler,
+                                                    const http::StreamingRequest::DataHandler& dh)
+{
+    std::shared_ptr<const cache::Entry> stale;
+    auto fresh = prepare(stale);
+
+    if (fresh && fresh->blob)
+    {
+        auto stream = std::make_shared<BodyStream>(multi, fresh, handler, dh);
+        multi.dispatch([stream]() { stream->next(); });
+
+        return;
+    }
+
+    if (fresh)
+    {
+        // Delivered on the reactor like any other response, never before async_execute returns.
+        multi.dispatch([fresh, handler, dh]()
+        {
+            dh(fresh->response.body);
+
+            if (handler.on_response())
+                handler.on_response()(fresh->response);
+        });
+
+        return;
+    }
+
+    auto thiz = shared_from_this();
+    auto request_time = cache::Entry::Clock::now();
+
+    auto wrapped = handler;
+    wrapped.on_response([thiz, stale, request_time, handler, dh](const http::Response& response)
+    {
+        http::Response result;
+
+        try
+        {
+            result = thiz->complete(stale, request_time, response, dh);
+        } catch (const std::exception& e)
+        {
+            if (handler.on_error())
+                handler.on_error()(http::Error(e.what(), CORE_FROM_HERE()));
+
+            return;
+        }
+
+        if (handler.on_response())
+            handler.on_response()(result);
+    });
+
+    network()->async_execute(wrapped, dh);
+}
+
+std::string http::impl::curl::CachedRequest::url_escape(const std::string& s)
+{
+    return core::net::percent_encoding::encode(s);
+}
+
+std::string http::impl::curl::CachedRequest::url_unescape(const std::string& s)
+{
+    return core::net::percent_encoding::decode(s);
+}
+
+void http::impl::curl::CachedRequest::pause()
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    if (request)
+        request->pause();
+}
+
+void http::impl::curl::CachedRequest::resume()
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    if (request)
+        request->resume();
+}
+
+void http::impl::curl::CachedRequest::abort_request_if(std::uint64_t limit, const std::chrono::seconds& time)
+{
+    configure([limit, time](curl::Request& request) { request.abort_request_if(limit, time); });
+}
+
+void http::impl::curl::CachedRequest::configure(const std::function<void(curl::Request&)>& option)
+{
+    if (started.load())
+        throw http::Request::Errors::AlreadyActive{CORE_FROM_HERE()};
+
+    std::lock_guard<std::mutex> lg(guard);
+    options.push_back(option);
+}
+
+std::shared_ptr<http::impl::curl::Request> http::impl::curl::CachedRequest::network()
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    if (request)
+        return request;
+
+    request = factory();
+
+    for (const auto& option : options)
+        option(*request);
+
+    return request;
+}
+
+http::Response http::impl::curl::CachedRequest::serve(const cache::Entry& entry,
+                                                      const http::StreamingRequest::DataHandler& dh)
+{
+    if (not entry.blob)
+    {
+        dh(entry.response.body);
+        return entry.response;
+    }
+
+    auto result = entry.response;
+    result.body.reserve(entry.blob->size());
+
+    std::string chunk;
+
+    while (read_chunk(entry, result.body.size(), chunk))
+    {
+        dh(chunk);
+        result.body.append(chunk);
+    }
+
+    return result;
+}
+
+std::shared_ptr<const cache::Entry> http::impl::curl::CachedRequest::prepare(std::shared_ptr<const cache::Entry>& stale)
+{
+    if (started.exchange(true))
+        throw http::Request::Errors::AlreadyActive{CORE_FROM_HERE()};
+
+    auto entry = cache->lookup(key);
+
+    if (not entry || not cache::matches(*entry, header))
+        return std::shared_ptr<const cache::Entry>{};
+
+    if (cache::is_fresh(*entry, header, cache::Entry::Clock::now()))
+    {
+        served_from_cache.store(true);
+        cache->record(cache::Cache::Outcome::hit);
+        return entry;
+    }
+
+    if (cache::has_validators(*entry))
+    {
+        network()->add_header(cache::conditional_header_for(*entry));
+        stale = entry;
+    }
+
+    return std::shared_ptr<const cache::Entry>{};
+}
+
+http::Response http::impl::curl::CachedRequest::complete(const std::shared_ptr<const cache::Entry>& stale,
+                                                         const cache::Entry::Clock::time_point& request_time,
+                                                         const http::Response& response,
+                                                         const http::StreamingRequest::DataHandler& dh)
+{
+    auto response_time = cache::Entry::Clock::now();
+
+    if (stale && response.status == http::Status::not_modified)
+    {
+        auto entry = cache::refresh(*stale, response, request_time, response_time);
+        cache->refresh(key, entry);
+        cache->record(cache::Cache::Outcome::revalidated);
+
+        // The 304 does not carry a body, so we hand out the cached one.
+        auto result = serve(*entry, dh);
+        result.transfer = response.transfer;
+
+        return result;
+    }
+
+    cache->record(cache::Cache::Outcome::miss);
+
+    if (cache::is_storable(header, response))
+        cache->store(key, cache::entry_for(header, response, request_time, response_time));
+    else if (stale)
+        cache->remove(key);
+
+    return response;
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_CACHED_REQUEST_H_
+#define CORE_NET_HTTP_IMPL_CURL_CACHED_REQUEST_H_
+
+#include <core/net/http/streaming_request.h>
+
+#include "../cache/cache.h"
+
+#include "curl.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace curl
+{
+class Request;
+
+// Answers a GET or HEAD request from a cache whenever possible, and
+// dispatches to a curl request otherwise, which is only created then.
+// Fresh responses are served without ever touching curl: bodies kept in memory are handed out
+// synchronously, bodies kept in blobs are streamed in chunks, on the
+// reactor of multi for asynchronous requests. Stale responses are validated
+// with the origin server, and a 304 response is answered from the cache.
+class CachedRequest : public core::net::http::StreamingRequest,
+                      public std::enable_shared_from_this<CachedRequest>
+{
+public:
+    // Function type creating the request that carries out the transfer.
+    typedef std::function<std::shared_ptr<curl::Request>()> Factory;
+
+    // Creates a new instance answering the request, carrying the given header
+    // fields, from cache under key, falling back to a request created by factory.
+    CachedRequest(::curl::multi::Handle multi,
+                  const std::shared_ptr<cache::Cache>& cache,
+                  const std::string& key,
+                  const Header& header,
+                  const Factory& factory);
+
+    // From core::net::http::StreamingRequest
+    State state() override;
+    void set_timeout(const std::chrono::milliseconds& timeout) override;
+    Response execute(const Request::ProgressHandler& ph) override;
+    Response execute(const Request::ProgressHandler& ph, const StreamingRequest::DataHandler& dh) override;
+    void async_execute(const Request::Handler& handler) override;
+    void async_execute(const Request::Handler& handler, const StreamingRequest::DataHandler& dh) override;
+    std::string url_escape(const std::string& s) override;
+    std::string url_unescape(const std::string& s) override;
+    void pause() override;
+    void resume() override;
+    void abort_request_if(std::uint64_t limit, const std::chrono::seconds& time) override;
+
+private:
+    // Returns a fresh entry that can be served right away, or a nullptr. In
+    // the latter case, the request is turned into a conditional one if a
+    // stale entry can be validated, which is then stored in stale.
+    std::shared_ptr<const cache::Entry> prepare(std::shared_ptr<const cache::Entry>& stale);
+
+    // Hands the body of entry to dh and returns the response
+    // stored in entry, including its body.
+    static Response serve(const cache::Entry& entry, const StreamingRequest::DataHandler& dh);
+
+    // Updates the cache with the response received from the origin server and
+    // returns the response that should be handed to the caller.
+    Response complete(const std::shared_ptr<const cache::Entry>& stale,
+                      const cache::Entry::Clock::time_point& request_time,
+                      const Response& response,
+                      const StreamingRequest::DataHandler& dh);
+
+    // Remembers option to be applied to the request carrying out the transfer.
+    void configure(const std::function<void(curl::Request&)>& option);
+
+    // Returns the request carrying out the transfer, creating it with all options applied.
+    std::shared_ptr<curl::Request> network();
+
+    ::curl::multi::Handle multi;
+    std::shared_ptr<cache::Cache> cache;
+    std::string key;
+    Header header;
+    Factory factory;
+
+    // Set once the request has been executed.
+    std::atomic<bool> started;
+    // Set once the request has been answered from the cache.
+    std::atomic<bool> served_from_cache;
+
+    std::mutex guard;
+    std::vector<std::function<void(curl::Request&)>> options;
+    // Only set if the request could not be answered from the cache alone.
+    std::shared_ptr<curl::Request> request;
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_CACHED_REQUEST_H_
@@ -18,80 +18,243 @@
  */
 
 #include "client.h"
+#include "cached_request.h"
+#include "coalesced_request.h"
 #include "curl.h"
+#include "event_source.h"
+#include "offloaded_request.h"
 #include "request.h"
 
+#include "../cache/disk_cache.h"
+#include "../cache/memory_cache.h"
+#include "../cache/policy.h"
+#include "../cache/tiered_cache.h"
+
+#include "../deflater.h"
+#include "../form.h"
+#include "../open_metrics.h"
+
+#include <core/net/base64.h>
+#include <core/net/percent_encoding.h>
 #include <core/net/http/content_type.h>
 #include <core/net/http/method.h>
 
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
-#include <boost/archive/iterators/ostream_iterator.hpp>
+#include <cstdio>
+#include <cstring>
 
 namespace net = core::net;
 namespace http = core::net::http;
-namespace bai = boost::archive::iterators;
 
 namespace
 {
-const std::string BASE64_PADDING[] = { "", "==", "=" };
+bool compresses_upload(const http::Request::Configuration& configuration)
+{
+    return configuration.upload.compression != http::Request::Compression::none;
 }
 
-http::impl::curl::Client::Client()
+// Returns the header of a request whose body is compressed on the fly. As the
+// size of the compressed body is not known in advance, we go for chunked encoding.
+http::Header compressed_upload_header(const http::Request::Configuration& configuration)
 {
-    multi.set_option(::curl::multi::Option::pipelining, ::curl::easy::enable);
+    auto header = configuration.header;
+    header.set("Content-Encoding", http::impl::Deflater::content_encoding(configuration.upload.compression));
+    header.set("Transfer-Encoding", "chunked");
+    return header;
 }
 
-std::string http::impl::curl::Client::url_escape(const std::string& s) const
+// Returns header announcing the type of the body, unless it does so already.
+http::Header typed(http::Header header, const std::string& ct)
 {
-    return ::curl::native::escape(s);
+    if (not ct.empty() && not header.has("Content-Type"))
+        header.set("Content-Type", ct);
+
+    return header;
 }
 
-std::string http::impl::curl::Client::base64_encode(const std::string& s) const
+// Reads compressed data from deflater as the read callback of a curl easy handle would.
+std::size_t read_from(http::impl::Deflater& deflater, void* dest, std::size_t size)
 {
-    std::stringstream os;
+    try
+    {
+        auto result = deflater.read(dest, size);
 
-    // convert binary values to base64 characters
-    typedef bai::base64_from_binary
-    // retrieve 6 bit integers from a sequence of 8 bit bytes
-    <bai::transform_width<const char *, 6, 8> > base64_enc;
+        if (result == http::impl::Deflater::would_block)
+            return (size_t)::curl::Code::readfunc_pause;
 
-    std::copy(base64_enc(s.c_str()), base64_enc(s.c_str() + s.size()),
-            std::ostream_iterator<char>(os));
+        return result;
+    } catch (...)
+    {
+        //Just ignoring errors here.
+    }
 
-    os << BASE64_PADDING[s.size() % 3];
+    //stop the current operation immediately
+    return (size_t)::curl::Code::no_readfunc_abort;
+}
 
-    return os.str();
+// Adapts a deflater to the read callback of a curl easy handle.
+::curl::easy::Handle::OnReadData read_compressed(const std::shared_ptr<http::impl::Deflater>& deflater)
+{
+    return [deflater](void* dest, std::size_t size, std::size_t nmemb)
+    {
+        return read_from(*deflater, dest, size * nmemb);
+    };
 }
 
-std::string http::impl::curl::Client::base64_decode(const std::string& s) const
+// Returns a deflater pulling its input from payload.
+std::shared_ptr<http::impl::Deflater> deflater_for(const http::Request::Configuration& configuration, std::istream& payload)
+{
+    return std::make_shared<http::impl::Deflater>(configuration.upload.compression, [&payload](char* dest, std::size_t size)
+    {
+        // In contrast to readsome, read only comes up short at the end of the stream.
+        payload.read(dest, size);
+        return static_cast<std::size_t>(payload.gcount());
+    });
+}
+
+// Returns a deflater pulling its input from readdata_callback.
+std::shared_ptr<http::impl::Deflater> deflater_for(const http::Request::Configuration& configuration,
+                                                   const std::function<size_t(void *dest, std::size_t buf_size)>& readdata_callback)
 {
-    std::stringstream os;
+    return std::make_shared<http::impl::Deflater>(configuration.upload.compression, [readdata_callback](char* dest, std::size_t size)
+    {
+        if (not readdata_callback)
+            throw std::runtime_error("Missing callback for reading request body.");
+
+        auto result = readdata_callback(dest, size);
 
-    typedef bai::transform_width<bai::binary_from_base64<const char *>, 8, 6> base64_dec;
+        if (result == http::StreamingClient::no_data_yet)
+            return http::impl::Deflater::would_block;
 
-    unsigned int size = s.size();
+        // Anything larger than the buffer, e.g., CURL_READFUNC_ABORT, aborts the upload.
+        if (result > size)
+            throw std::runtime_error("Reading request body was aborted.");
+
+        return result;
+    });
+}
 
-    // Remove the padding characters
-    // See: https://svn.boost.org/trac/boost/ticket/5629
-    if (size && s[size - 1] == '=')
+// Adapts a producer of a body of unknown size to the read callback of a curl easy handle.
+::curl::easy::Handle::OnReadData read_produced(const http::StreamingClient::Producer& producer)
+{
+    return [producer](void* dest, std::size_t size, std::size_t nmemb)
     {
-        --size;
-        if (size && s[size - 1] == '=')
+        try
+        {
+            auto result = producer(dest, size * nmemb);
+
+            if (result == http::StreamingClient::no_data_yet)
+                return (size_t)::curl::Code::readfunc_pause;
+
+            // Anything larger than the buffer, e.g., CURL_READFUNC_ABORT, aborts the upload.
+            if (result <= size * nmemb)
+                return result;
+        } catch (...)
         {
-            --size;
+            //Just ignoring errors here.
         }
-    }
-    if (size == 0)
+
+        //stop the current operation immediately
+        return (size_t)::curl::Code::no_readfunc_abort;
+    };
+}
+
+// Sets up a GET or HEAD request with the given configuration.
+std::shared_ptr<http::impl::curl::Request> request_for(::curl::multi::Handle multi,
+                                                       http::Method method,
+                                                       const http::Request::Configuration& configuration)
+{
+    ::curl::easy::Handle handle;
+    handle.method(method)
+          .url(configuration.uri.c_str())
+          .route(configuration.route)
+          .header(configuration.header);
+
+    handle.set_option(::curl::Option::ssl_verify_host,
+                      configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
+    handle.set_option(::curl::Option::ssl_verify_peer,
+                      configuration.ssl.verify_peer ? ::curl::easy::enable : ::curl::easy::disable);
+
+    if (configuration.authentication_handler.for_http)
     {
-        return std::string();
+        auto credentials = configuration.authentication_handler.for_http(configuration.uri);
+        handle.http_credentials(credentials.username, credentials.password);
     }
 
-    std::copy(base64_dec(s.data()), base64_dec(s.data() + size),
-            std::ostream_iterator<char>(os));
+    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+}
+
+// Answers a request with the given configuration from cache if caching is
+// enabled and applicable to the request, returns a plain curl request otherwise.
+std::shared_ptr<http::StreamingRequest> cached(const std::shared_ptr<http::impl::cache::Cache>& cache,
+                                               ::curl::multi::Handle multi,
+                                               http::Method method,
+                                               const http::Request::Configuration& configuration)
+{
+    auto factory = [multi, method, configuration]()
+    {
+        return request_for(multi, method, configuration);
+    };
 
-    return os.str();
+    if (not cache || not http::impl::cache::is_cacheable(method, configuration.header))
+        return factory();
+
+    // The curl request is only set up if the cache cannot answer on its own.
+    return std::make_shared<http::impl::curl::CachedRequest>(
+                multi, cache, http::impl::cache::key_for(method, configuration.uri), configuration.header, factory);
+}
+}
+
+http::impl::curl::Client::Client()
+{
+    multi.set_option(::curl::multi::Option::pipelining, ::curl::easy::enable);
+}
+
+http::impl::curl::Client::Client(const http::Client::Configuration& configuration)
+    : Client()
+{
+    std::shared_ptr<cache::Cache> memory, disk;
+
+    if (configuration.cache.capacity > 0)
+        memory = std::make_shared<cache::MemoryCache>(configuration.cache.capacity);
+
+    if (not configuration.cache.disk.directory.empty() && configuration.cache.disk.capacity > 0)
+        disk = std::make_shared<cache::DiskCache>(configuration.cache.disk.directory, configuration.cache.disk.capacity);
+
+    if (memory && disk)
+        cache = std::make_shared<cache::TieredCache>(memory, disk, configuration.cache.disk.threshold);
+    else
+        cache = memory ? memory : disk;
+
+    if (configuration.coalescing.enabled)
+        coalescer = std::make_shared<Coalescer>(configuration.coalescing.replay_limit);
+
+    if (configuration.metrics.endpoints > 0)
+        multi.track_endpoints(configuration.metrics.endpoints);
+
+    multi.monitor_reactor(configuration.reactor.probe_interval,
+                          configuration.reactor.slow_callback_threshold,
+                          configuration.reactor.on_slow_callback);
+
+    if (configuration.tracing.observer)
+        multi.trace(configuration.tracing.observer, configuration.tracing.chunks);
+
+    executor = configuration.callbacks.executor;
+    offload_chunks = configuration.callbacks.chunks;
+}
+
+std::string http::impl::curl::Client::url_escape(const std::string& s) const
+{
+    return core::net::percent_encoding::encode(s);
+}
+
+std::string http::impl::curl::Client::base64_encode(const std::string& s) const
+{
+    return core::net::base64::encode(s);
+}
+
+std::string http::impl::curl::Client::base64_decode(const std::string& s) const
+{
+    return core::net::base64::decode(s);
 }
 
 core::net::http::Client::Timings http::impl::curl::Client::timings()
@@ -99,6 +262,47 @@ core::net::http::Client::Timings http::impl::curl::Client::timings()
     return multi.timings();
 }
 
+core::net::http::Client::Timings http::impl::curl::Client::reset_timings()
+{
+    return multi.reset_timings();
+}
+
+std::vector<core::net::http::Client::EndpointMetrics> http::impl::curl::Client::endpoint_metrics()
+{
+    return multi.endpoint_metrics();
+}
+
+core::net::http::Client::TransferStatistics http::impl::curl::Client::transfer_statistics()
+{
+    return multi.transfer_statistics();
+}
+
+core::net::http::Client::ReactorStatistics http::impl::curl::Client::reactor_statistics()
+{
+    return multi.reactor_statistics();
+}
+
+core::net::http::Client::CacheStatistics http::impl::curl::Client::cache_statistics()
+{
+    if (not cache)
+        return core::net::http::Client::CacheStatistics{};
+
+    return cache->statistics();
+}
+
+void http::impl::curl::Client::write_metrics(std::ostream& out)
+{
+    http::impl::ClientMetrics metrics;
+
+    metrics.transfers = transfer_statistics();
+    metrics.reactor = reactor_statistics();
+    metrics.cache = cache_statistics();
+    metrics.timings = timings();
+    metrics.endpoints = endpoint_metrics();
+
+    http::impl::write_open_metrics(out, metrics);
+}
+
 void http::impl::curl::Client::run()
 {
     multi.run();
@@ -109,14 +313,28 @@ void http::impl::curl::Client::stop()
     multi.stop();
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::head_impl(const http::Request::Configuration& configuration)
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::post_impl(
+        const Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload,
+        const std::string& ct)
 {
     ::curl::easy::Handle handle;
-    handle.method(http::Method::head)
+    handle.method(http::Method::post)
             .url(configuration.uri.c_str())
-            .header(configuration.header);
+            .route(configuration.route);
+
+    if (compresses_upload(configuration))
+    {
+        handle.header(typed(compressed_upload_header(configuration), ct))
+                .on_read_data(read_compressed(std::make_shared<http::impl::Deflater>(configuration.upload.compression, payload)));
+        handle.set_option(::curl::Option::post_field_size, ::curl::easy::unknown_size);
+    } else
+    {
+        // The handle keeps the payload alive, no need for curl to copy it.
+        handle.header(typed(configuration.header, ct))
+                .post_data(payload, ct);
+    }
 
-    //const long value = configuration.ssl.verify_host ? ::curl::easy::enable : ::curl::easy::disable;
     handle.set_option(::curl::Option::ssl_verify_host,
                       configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
     handle.set_option(::curl::Option::ssl_verify_peer,
@@ -128,15 +346,37 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::head_impl(c
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::get_impl(const http::Request::Configuration& configuration)
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::post_impl(
+        const Request::Configuration& configuration,
+        std::istream& payload,
+        std::size_t size)
 {
     ::curl::easy::Handle handle;
-    handle.method(http::Method::get)
-          .url(configuration.uri.c_str())
-          .header(configuration.header);
+    handle.method(http::Method::post)
+            .url(configuration.uri.c_str())
+            .route(configuration.route);
+
+    if (compresses_upload(configuration))
+    {
+        handle.header(compressed_upload_header(configuration))
+                .on_read_data(read_compressed(deflater_for(configuration, payload)));
+        handle.set_option(::curl::Option::post_field_size, ::curl::easy::unknown_size);
+    } else
+    {
+        handle.header(configuration.header)
+                .on_read_data([&payload, size](void* dest, std::size_t in_size, std::size_t nmemb)
+                {
+                    //use internal buffer size(in_size *nmemb) instread of size passed by parameter
+                    //to avoid client crashing when sending large chuck of data via POST method
+                    auto result = payload.readsome(static_cast<char *>(dest), in_size * nmemb);
+                    return result;
+                }, size);
+
+        handle.set_option(::curl::Option::post_field_size, size);
+    }
 
     handle.set_option(::curl::Option::ssl_verify_host,
                       configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
@@ -149,19 +389,78 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::get_impl(co
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::post_impl(
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::post_impl(
         const Request::Configuration& configuration,
-        const std::string& payload,
-        const std::string& ct)
+        std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback,
+        std::size_t size,
+        const std::string& ct,
+        const std::function<void()>& rewind)
 {
     ::curl::easy::Handle handle;
     handle.method(http::Method::post)
             .url(configuration.uri.c_str())
-            .header(configuration.header)
-            .post_data(payload.c_str(), ct);
+            .route(configuration.route);
+
+    if (compresses_upload(configuration))
+    {
+        // Rewinding starts over with a fresh deflater, as the current one cannot take back what it compressed.
+        auto deflater = std::make_shared<std::shared_ptr<http::impl::Deflater>>(deflater_for(configuration, readdata_callback));
+
+        handle.header(typed(compressed_upload_header(configuration), ct))
+                .on_read_data([deflater](void* dest, std::size_t in_size, std::size_t nmemb)
+                {
+                    return read_from(**deflater, dest, in_size * nmemb);
+                });
+        handle.set_option(::curl::Option::post_field_size, ::curl::easy::unknown_size);
+
+        if (rewind)
+        {
+            handle.on_seek([deflater, configuration, readdata_callback, rewind](std::int64_t offset, int origin)
+            {
+                if (offset != 0 || origin != SEEK_SET)
+                    return false;
+
+                rewind();
+                *deflater = deflater_for(configuration, readdata_callback);
+                return true;
+            });
+        }
+    } else
+    {
+        handle.header(typed(configuration.header, ct))
+                .on_read_data([readdata_callback, size](void* dest, std::size_t in_size, std::size_t nmemb)
+                {
+                    if(readdata_callback) {
+                        try
+                        {
+                            return readdata_callback(dest, in_size * nmemb);
+                        } catch (...)
+                        {
+                            //Just ignoring errors here.
+                        }
+                    }
+
+                    //stop the current operation immediately
+                    return (size_t)::curl::Code::no_readfunc_abort;
+                }, size);
+
+        handle.set_option(::curl::Option::post_field_size, size);
+
+        if (rewind)
+        {
+            handle.on_seek([rewind](std::int64_t offset, int origin)
+            {
+                if (offset != 0 || origin != SEEK_SET)
+                    return false;
+
+                rewind();
+                return true;
+            });
+        }
+    }
 
     handle.set_option(::curl::Option::ssl_verify_host,
                       configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
@@ -174,27 +473,39 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::post_impl(
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::post_impl(
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::chunked_impl(
+        http::Method method,
         const Request::Configuration& configuration,
-        std::istream& payload,
-        std::size_t size)
+        const Producer& producer,
+        const std::string& ct)
 {
+    if (not producer)
+        throw std::logic_error("Missing producer for request body.");
+
     ::curl::easy::Handle handle;
-    handle.method(http::Method::post)
+    handle.method(method)
             .url(configuration.uri.c_str())
-            .header(configuration.header)
-            .on_read_data([&payload, size](void* dest, std::size_t in_size, std::size_t nmemb)
-            {
-                //use internal buffer size(in_size *nmemb) instread of size passed by parameter
-                //to avoid client crashing when sending large chuck of data via POST method
-                auto result = payload.readsome(static_cast<char *>(dest), in_size * nmemb);
-                return result;            
-            }, size);   
-    
-    handle.set_option(::curl::Option::post_field_size, size);
+            .route(configuration.route);
+
+    if (compresses_upload(configuration))
+    {
+        handle.header(typed(compressed_upload_header(configuration), ct))
+                .on_read_data(read_compressed(deflater_for(configuration, producer)));
+    } else
+    {
+        auto header = typed(configuration.header, ct);
+        header.set("Transfer-Encoding", "chunked");
+
+        handle.header(header)
+                .on_read_data(read_produced(producer));
+    }
+
+    if (method == http::Method::post)
+        handle.set_option(::curl::Option::post_field_size, ::curl::easy::unknown_size);
+
     handle.set_option(::curl::Option::ssl_verify_host,
                       configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
     handle.set_option(::curl::Option::ssl_verify_peer,
@@ -206,35 +517,35 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::post_impl(
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::post_impl(
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::put_impl(
         const Request::Configuration& configuration,
-        std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback,
+        std::istream& payload,
         std::size_t size)
 {
     ::curl::easy::Handle handle;
-    handle.method(http::Method::post)
+    handle.method(http::Method::put)
             .url(configuration.uri.c_str())
-            .header(configuration.header)
-            .on_read_data([readdata_callback, size](void* dest, std::size_t in_size, std::size_t nmemb)
-            {
-                if(readdata_callback) {
-                    try 
-                    {
-                        return readdata_callback(dest, in_size * nmemb);
-                    } catch (...) 
-                    {
-                        //Just ignoring errors here.
-                    }
-                }
+            .route(configuration.route);
+
+    if (compresses_upload(configuration))
+    {
+        handle.header(compressed_upload_header(configuration))
+                .on_read_data(read_compressed(deflater_for(configuration, payload)));
+    } else
+    {
+        handle.header(configuration.header)
+                .on_read_data([&payload, size](void* dest, std::size_t in_size, std::size_t nmemb)
+                {
+                    //use internal buffer size(in_size *nmemb) instread of size passed by parameter
+                    //to avoid client crashing when sending large chuck of data via PUT method
+                    auto result = payload.readsome(static_cast<char*>(dest), in_size * nmemb);
+                    return result;
+                }, size);
+    }
 
-                //stop the current operation immediately
-                return (size_t)::curl::Code::no_readfunc_abort;
-            }, size);    
-    
-    handle.set_option(::curl::Option::post_field_size, size);
     handle.set_option(::curl::Option::ssl_verify_host,
                       configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
     handle.set_option(::curl::Option::ssl_verify_peer,
@@ -246,25 +557,42 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::post_impl(
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::put_impl(
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::put_impl(
         const Request::Configuration& configuration,
-        std::istream& payload,
+        std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback,
         std::size_t size)
 {
     ::curl::easy::Handle handle;
     handle.method(http::Method::put)
             .url(configuration.uri.c_str())
-            .header(configuration.header)
-            .on_read_data([&payload, size](void* dest, std::size_t in_size, std::size_t nmemb)
-            {
-                //use internal buffer size(in_size *nmemb) instread of size passed by parameter
-                //to avoid client crashing when sending large chuck of data via PUT method
-                auto result = payload.readsome(static_cast<char*>(dest), in_size * nmemb);
-                return result;
-            }, size);
+            .route(configuration.route);
+
+    if (compresses_upload(configuration))
+    {
+        handle.header(compressed_upload_header(configuration))
+                .on_read_data(read_compressed(deflater_for(configuration, readdata_callback)));
+    } else
+    {
+        handle.header(configuration.header)
+                .on_read_data([readdata_callback, size](void* dest, std::size_t in_size, std::size_t nmemb)
+                {
+                    if(readdata_callback) {
+                        try
+                        {
+                            return readdata_callback(dest, in_size * nmemb);
+                        } catch (...)
+                        {
+                            //Just ignoring errors here.
+                        }
+                    }
+
+                    //stop the current operation immediately
+                    return (size_t)::curl::Code::no_readfunc_abort;
+                }, size);
+    }
 
     handle.set_option(::curl::Option::ssl_verify_host,
                       configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
@@ -277,33 +605,35 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::put_impl(
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::put_impl(
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::put_impl(
         const Request::Configuration& configuration,
-        std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback,
-        std::size_t size)
+        const std::shared_ptr<const std::string>& payload)
 {
     ::curl::easy::Handle handle;
     handle.method(http::Method::put)
             .url(configuration.uri.c_str())
-            .header(configuration.header)
-            .on_read_data([readdata_callback, size](void* dest, std::size_t in_size, std::size_t nmemb)
-            {
-                if(readdata_callback) {
-                    try 
-                    {
-                        return readdata_callback(dest, in_size * nmemb);
-                    } catch (...) 
-                    {
-                        //Just ignoring errors here.
-                    }
-                }
+            .route(configuration.route);
 
-                //stop the current operation immediately
-                return (size_t)::curl::Code::no_readfunc_abort;
-            }, size);
+    if (compresses_upload(configuration))
+    {
+        handle.header(compressed_upload_header(configuration))
+                .on_read_data(read_compressed(std::make_shared<http::impl::Deflater>(configuration.upload.compression, payload)));
+    } else
+    {
+        // Uploads straight from the buffer that the handler keeps alive.
+        auto offset = std::make_shared<std::size_t>(0);
+        handle.header(configuration.header)
+                .on_read_data([payload, offset](void* dest, std::size_t in_size, std::size_t nmemb)
+                {
+                    auto result = std::min(in_size * nmemb, payload->size() - *offset);
+                    std::memcpy(dest, payload->data() + *offset, result);
+                    *offset += result;
+                    return result;
+                }, payload->size());
+    }
 
     handle.set_option(::curl::Option::ssl_verify_host,
                       configuration.ssl.verify_host ? ::curl::easy::enable_ssl_host_verification : ::curl::easy::disable);
@@ -316,14 +646,15 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::put_impl(
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
 }
 
-std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::del_impl(const http::Request::Configuration& configuration)
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::del_impl(const http::Request::Configuration& configuration)
 {
     ::curl::easy::Handle handle;
     handle.method(http::Method::del)
           .url(configuration.uri.c_str())
+          .route(configuration.route)
           .header(configuration.header);
 
     handle.set_option(::curl::Option::ssl_verify_host,
@@ -337,17 +668,45 @@ std::shared_ptr<http::impl::curl::Request> http::impl::curl::Client::del_impl(co
         handle.http_credentials(credentials.username, credentials.password);
     }
 
-    return std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}};
+    return offloaded(std::shared_ptr<http::impl::curl::Request>{new http::impl::curl::Request{multi, handle}});
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::safe(
+        http::Method method,
+        const http::Request::Configuration& configuration)
+{
+    // Requests might outlive the client, so we hand copies of the state they rely on.
+    auto multi = this->multi;
+    auto cache = this->cache;
+
+    auto factory = [multi, cache, method, configuration]()
+    {
+        return cached(cache, multi, method, configuration);
+    };
+
+    if (not coalescer || not Coalescer::is_coalescable(method, configuration))
+        return offloaded(factory());
+
+    return offloaded(std::make_shared<http::impl::curl::CoalescedRequest>(
+                coalescer, Coalescer::key_for(method, configuration), factory));
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::offloaded(const std::shared_ptr<http::StreamingRequest>& request)
+{
+    if (not executor)
+        return request;
+
+    return std::make_shared<http::impl::curl::OffloadedRequest>(request, executor, offload_chunks);
 }
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_get(const http::Request::Configuration& configuration)
 {
-    return get_impl(configuration);
+    return safe(http::Method::get, configuration);
 }
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_head(const http::Request::Configuration& configuration)
 {
-    return head_impl(configuration);
+    return safe(http::Method::head, configuration);
 }
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_put(const http::Request::Configuration& configuration, std::istream& payload, std::size_t size)
@@ -357,21 +716,12 @@ std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_put(
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post(const http::Request::Configuration& configuration, const std::string& payload, const std::string& type)
 {
-    return post_impl(configuration, payload, type);
+    return post_impl(configuration, std::make_shared<std::string>(payload), type);
 }
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post_form(const http::Request::Configuration& configuration, const std::map<std::string, std::string>& values)
 {
-    std::stringstream ss;
-    bool first{true};
-
-    for (const auto& pair : values)
-    {
-        ss << (first ? "" : "&") << url_escape(pair.first) << "=" << url_escape(pair.second);
-        first = false;
-    }
-
-    return post_impl(configuration, ss.str(), http::ContentType::x_www_form_urlencoded);
+    return post_impl(configuration, std::make_shared<std::string>(http::impl::form_body_for(values)), http::ContentType::x_www_form_urlencoded);
 }
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post(const http::Request::Configuration& configuration, std::istream& payload, std::size_t   size)
@@ -381,7 +731,7 @@ std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post(const http::Request::Configuration& configuration, std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback, std::size_t size)
 {
-    return post_impl(configuration, readdata_callback, size);
+    return post_impl(configuration, readdata_callback, size, std::string(), std::function<void()>());
 }
 
 std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_put(const http::Request::Configuration& configuration, std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback, std::size_t size)
@@ -396,12 +746,12 @@ std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_del(
 
 std::shared_ptr<http::Request> http::impl::curl::Client::head(const http::Request::Configuration& configuration)
 {
-    return head_impl(configuration);
+    return safe(http::Method::head, configuration);
 }
 
 std::shared_ptr<http::Request> http::impl::curl::Client::get(const http::Request::Configuration& configuration)
 {
-    return get_impl(configuration);
+    return safe(http::Method::get, configuration);
 }
 
 std::shared_ptr<http::Request> http::impl::curl::Client::post(
@@ -409,7 +759,7 @@ std::shared_ptr<http::Request> http::impl::curl::Client::post(
         const std::string& payload,
         const std::string& ct)
 {
-    return post_impl(configuration, payload, ct);
+    return post_impl(configuration, std::make_shared<std::string>(payload), ct);
 }
 
 std::shared_ptr<http::Request> http::impl::curl::Client::post(
@@ -420,6 +770,133 @@ std::shared_ptr<http::Request> http::impl::curl::Client::post(
     return post_impl(configuration, payload, size);
 }
 
+std::shared_ptr<http::Request> http::impl::curl::Client::post(
+        const Request::Configuration& configuration,
+        std::string&& payload,
+        const std::string& ct)
+{
+    return post_impl(configuration, std::make_shared<std::string>(std::move(payload)), ct);
+}
+
+std::shared_ptr<http::Request> http::impl::curl::Client::post(
+        const Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload,
+        const std::string& ct)
+{
+    return post_impl(configuration, payload, ct);
+}
+
+std::shared_ptr<http::Request> http::impl::curl::Client::put(
+        const Request::Configuration& configuration,
+        std::string&& payload)
+{
+    return put_impl(configuration, std::make_shared<std::string>(std::move(payload)));
+}
+
+std::shared_ptr<http::Request> http::impl::curl::Client::put(
+        const Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload)
+{
+    return put_impl(configuration, payload);
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post(
+        const Request::Configuration& configuration,
+        std::string&& payload,
+        const std::string& ct)
+{
+    return post_impl(configuration, std::make_shared<std::string>(std::move(payload)), ct);
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post(
+        const Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload,
+        const std::string& ct)
+{
+    return post_impl(configuration, payload, ct);
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post_chunked(
+        const Request::Configuration& configuration,
+        const Producer& producer,
+        const std::string& ct)
+{
+    return chunked_impl(http::Method::post, configuration, producer, ct);
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_put_chunked(
+        const Request::Configuration& configuration,
+        const Producer& producer)
+{
+    return chunked_impl(http::Method::put, configuration, producer, std::string());
+}
+
+std::shared_ptr<http::EventSource> http::impl::curl::Client::open_event_source(
+        const Request::Configuration& configuration,
+        const http::EventStream::Handler& on_event,
+        const http::Request::ErrorHandler& on_error)
+{
+    // The subscription might outlive the client, so we hand copies of the state requests rely on.
+    // Event streams are neither cached nor coalesced, as every connection resumes at a different event.
+    auto multi = this->multi;
+    auto executor = this->executor;
+    auto offload_chunks = this->offload_chunks;
+
+    auto factory = [multi, executor, offload_chunks](const Request::Configuration& configuration) -> std::shared_ptr<http::StreamingRequest>
+    {
+        auto request = request_for(multi, http::Method::get, configuration);
+        // Events are handed out as they arrive, the body of a subscription only ever grows.
+        request->discard_body();
+
+        if (not executor)
+            return request;
+
+        return std::make_shared<http::impl::curl::OffloadedRequest>(request, executor, offload_chunks);
+    };
+
+    return http::impl::curl::EventSource::open(multi, configuration, factory, on_event, on_error);
+}
+
+std::shared_ptr<http::Request> http::impl::curl::Client::post_form(
+        const Request::Configuration& configuration,
+        const http::Form& form)
+{
+    return streaming_post_form(configuration, form);
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_post_form(
+        const Request::Configuration& configuration,
+        const http::Form& form)
+{
+    // Curl rewinds the body, e.g., to answer an authentication challenge,
+    // which we serve by handing out the form from its beginning again.
+    auto reader = std::make_shared<http::Form::Reader>(form.reader());
+    auto read = [reader](void* dest, std::size_t size)
+    {
+        return (*reader)(dest, size);
+    };
+    auto rewind = [reader, form]()
+    {
+        *reader = form.reader();
+    };
+
+    return post_impl(configuration, read, form.size(), form.content_type(), rewind);
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_put(
+        const Request::Configuration& configuration,
+        std::string&& payload)
+{
+    return put_impl(configuration, std::make_shared<std::string>(std::move(payload)));
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::Client::streaming_put(
+        const Request::Configuration& configuration,
+        const std::shared_ptr<const std::string>& payload)
+{
+    return put_impl(configuration, payload);
+}
+
 std::shared_ptr<http::Request> http::impl::curl::Client::del(
         const Request::Configuration& configuration)
 {
@@ -443,3 +920,13 @@ std::shared_ptr<http::StreamingClient> http::make_streaming_client()
 {
     return std::make_shared<http::impl::curl::Client>();
 }
+
+std::shared_ptr<http::Client> http::make_client(const http::Client::Configuration& configuration)
+{
+    return std::make_shared<http::impl::curl::Client>(configuration);
+}
+
+std::shared_ptr<http::StreamingClient> http::make_streaming_client(const http::Client::Configuration& configuration)
+{
+    return std::make_shared<http::impl::curl::Client>(configuration);
+}
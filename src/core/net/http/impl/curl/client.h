@@ -23,6 +23,8 @@
 
 #include "curl.h"
 
+#include "../cache/cache.h"
+
 namespace core
 {
 namespace net
@@ -33,12 +35,15 @@ namespace impl
 {
 namespace curl
 {
+class Coalescer;
 class Request;
 
 class Client : public core::net::http::StreamingClient
 {
 public:
     Client();
+    // Creates a new instance set up according to configuration.
+    explicit Client(const core::net::http::Client::Configuration& configuration);
 
     // From core::net::http::Client
 
@@ -50,6 +55,18 @@ public:
 
     core::net::http::Client::Timings timings() override;
 
+    core::net::http::Client::Timings reset_timings();
+
+    std::vector<core::net::http::Client::EndpointMetrics> endpoint_metrics();
+
+    core::net::http::Client::TransferStatistics transfer_statistics();
+
+    core::net::http::Client::ReactorStatistics reactor_statistics();
+
+    core::net::http::Client::CacheStatistics cache_statistics();
+
+    void write_metrics(std::ostream& out);
+
     void run() override;
 
     void stop() override;
@@ -72,16 +89,45 @@ public:
     std::shared_ptr<http::StreamingRequest> streaming_put(const http::Request::Configuration& configuration, std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback, std::size_t size) override;
     std::shared_ptr<http::StreamingRequest> streaming_del(const http::Request::Configuration& configuration) override;
 
+    std::shared_ptr<http::Request> post(const http::Request::Configuration& configuration, std::string&& payload, const std::string& type);
+    std::shared_ptr<http::Request> post(const http::Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload, const std::string& type);
+    std::shared_ptr<http::Request> put(const http::Request::Configuration& configuration, std::string&& payload);
+    std::shared_ptr<http::Request> put(const http::Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload);
+    std::shared_ptr<http::StreamingRequest> streaming_post(const http::Request::Configuration& configuration, std::string&& payload, const std::string& type);
+    std::shared_ptr<http::StreamingRequest> streaming_post(const http::Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload, const std::string& type);
+    std::shared_ptr<http::StreamingRequest> streaming_put(const http::Request::Configuration& configuration, std::string&& payload);
+    std::shared_ptr<http::StreamingRequest> streaming_put(const http::Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload);
+    std::shared_ptr<http::Request> post_form(const http::Request::Configuration& configuration, const http::Form& form);
+    std::shared_ptr<http::StreamingRequest> streaming_post_form(const http::Request::Configuration& configuration, const http::Form& form);
+    std::shared_ptr<http::StreamingRequest> streaming_post_chunked(const http::Request::Configuration& configuration, const Producer& producer, const std::string& type);
+    std::shared_ptr<http::StreamingRequest> streaming_put_chunked(const http::Request::Configuration& configuration, const Producer& producer);
+    std::shared_ptr<http::EventSource> open_event_source(const http::Request::Configuration& configuration, const http::EventStream::Handler& on_event, const http::Request::ErrorHandler& on_error);
+
 private:
-    std::shared_ptr<curl::Request> get_impl(const http::Request::Configuration& configuration);
-    std::shared_ptr<curl::Request> head_impl(const http::Request::Configuration& configuration);
-    std::shared_ptr<curl::Request> post_impl(const http::Request::Configuration& configuration, const std::string&, const std::string&);
-    std::shared_ptr<curl::Request> put_impl(const http::Request::Configuration& configuration, std::istream& payload, std::size_t size);
-
-    std::shared_ptr<curl::Request> post_impl(const http::Request::Configuration& configuration, std::istream& payload, std::size_t size);
-    std::shared_ptr<curl::Request> post_impl(const http::Request::Configuration& configuration, std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback, std::size_t size);
-    std::shared_ptr<curl::Request> put_impl(const http::Request::Configuration& configuration, std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback, std::size_t size);
-    std::shared_ptr<curl::Request> del_impl(const http::Request::Configuration& configuration);
+    std::shared_ptr<http::StreamingRequest> post_impl(const http::Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload, const std::string&);
+    std::shared_ptr<http::StreamingRequest> put_impl(const http::Request::Configuration& configuration, std::istream& payload, std::size_t size);
+
+    std::shared_ptr<http::StreamingRequest> post_impl(const http::Request::Configuration& configuration, std::istream& payload, std::size_t size);
+    // Sets up a POST request pulling its body from readdata_callback, which rewind, if given, restarts from the beginning.
+    std::shared_ptr<http::StreamingRequest> post_impl(const http::Request::Configuration& configuration, std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback, std::size_t size, const std::string& type, const std::function<void()>& rewind);
+    std::shared_ptr<http::StreamingRequest> put_impl(const http::Request::Configuration& configuration, std::function<size_t(void *dest, std::size_t buf_size)> readdata_callback, std::size_t size);
+    std::shared_ptr<http::StreamingRequest> put_impl(const http::Request::Configuration& configuration, const std::shared_ptr<const std::string>& payload);
+    std::shared_ptr<http::StreamingRequest> del_impl(const http::Request::Configuration& configuration);
+    // Sets up a POST or PUT request with a body of unknown size, sent with chunked transfer-encoding.
+    std::shared_ptr<http::StreamingRequest> chunked_impl(http::Method method, const http::Request::Configuration& configuration, const Producer& producer, const std::string& type);
+
+    // Sets up a GET or HEAD request, answered from the response cache and sharing
+    // its transfer with identical requests in flight if enabled and applicable.
+    std::shared_ptr<http::StreamingRequest> safe(http::Method method,
+                                                 const http::Request::Configuration& configuration);
+
+    // Wraps request to deliver its callbacks on the configured executor, if any.
+    std::shared_ptr<http::StreamingRequest> offloaded(const std::shared_ptr<http::StreamingRequest>& request);
+
+    std::shared_ptr<cache::Cache> cache;
+    std::shared_ptr<Coalescer> coalescer;
+    std::shared_ptr<core::net::Executor> executor;
+    bool offload_chunks{false};
 
     ::curl::multi::Handle multi;    
 };
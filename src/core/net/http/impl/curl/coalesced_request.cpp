@@ -0,0 +1,353 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "coalesced_request.h"
+#include "curl.h"
+
+#include <core/net/percent_encoding.h>
+#include <core/net/http/error.h>
+
+#include <condition_variable>
+#include <deque>
+
+namespace http = core::net::http;
+
+namespace
+{
+// Hands the outcome of a flight over to a thread waiting for it synchronously.
+class Mailbox
+{
+public:
+    void post(const std::string& chunk)
+    {
+        std::lock_guard<std::mutex> lg(guard);
+        chunks.push_back(chunk);
+        wakeup.notify_one();
+    }
+
+    void close(const http::Response& response)
+    {
+        std::lock_guard<std::mutex> lg(guard);
+        result = response;
+        closed = true;
+        wakeup.notify_one();
+    }
+
+    void close(const core::net::Error& e)
+    {
+        std::lock_guard<std::mutex> lg(guard);
+        error = e.what();
+        failed = closed = true;
+        wakeup.notify_one();
+    }
+
+    // Waits for the next chunk, returns false once all chunks have been handed out.
+    bool next(std::string& chunk)
+    {
+        std::unique_lock<std::mutex> ul(guard);
+        wakeup.wait(ul, [this]() { return closed || not chunks.empty(); });
+
+        if (chunks.empty())
+            return false;
+
+        chunk.swap(chunks.front());
+        chunks.pop_front();
+
+        return true;
+    }
+
+    // Returns the response, or throws http::Error if the flight failed.
+    http::Response response()
+    {
+        std::lock_guard<std::mutex> lg(guard);
+
+        if (failed)
+            throw http::Error(error, CORE_FROM_HERE());
+
+        return result;
+    }
+
+private:
+    std::mutex guard;
+    std::condition_variable wakeup;
+    std::deque<std::string> chunks;
+    http::Response result;
+    std::string error;
+    bool closed{false};
+    bool failed{false};
+};
+}
+
+http::impl::curl::CoalescedRequest::CoalescedRequest(const std::shared_ptr<Coalescer>& coalescer,
+                                                     const std::string& key,
+                                                     const Factory& factory)
+    : coalescer(coalescer),
+      key(key),
+      factory(factory),
+      atomic_state(http::Request::State::ready)
+{
+}
+
+http::Request::State http::impl::curl::CoalescedRequest::state()
+{
+    return atomic_state.load();
+}
+
+void http::impl::curl::CoalescedRequest::set_timeout(const std::chrono::milliseconds& timeout)
+{
+    configure([timeout](http::StreamingRequest& request) { request.set_timeout(timeout); });
+}
+
+http::Response http::impl::curl::CoalescedRequest::execute(const http::Request::ProgressHandler& ph)
+{
+    return execute(ph, [](const std::string&){});
+}
+
+http::Response http::impl::curl::CoalescedRequest::execute(const http::Request::ProgressHandler& ph,
+                                                           const http::StreamingRequest::DataHandler& dh)
+{
+    activate();
+
+    if (has_options())
+    {
+        try
+        {
+            auto response = lead()->execute(ph, dh);
+            atomic_state.store(http::Request::State::done);
+            return response;
+        } catch (...)
+        {
+            atomic_state.store(http::Request::State::done);
+            throw;
+        }
+    }
+
+    auto mailbox = std::make_shared<Mailbox>();
+    Coalescer::Waiter waiter
+    {
+        [mailbox](const std::string& chunk) { mailbox->post(chunk); },
+        [mailbox](const http::Response& response) { mailbox->close(response); },
+        [mailbox](const core::net::Error& error) { mailbox->close(error); }
+    };
+
+    bool leads{false};
+    auto flight = coalescer->join(key, waiter, leads);
+
+    if (not leads)
+    {
+        // Chunks are handed to dh on the calling thread, as for any other synchronous
+        // request. The transfer is not ours, so ph is never invoked.
+        std::string chunk;
+        while (mailbox->next(chunk))
+            dh(chunk);
+
+        atomic_state.store(http::Request::State::done);
+        return mailbox->response();
+    }
+
+    http::Response response;
+
+    try
+    {
+        response = lead()->execute(ph, [dh, flight](const std::string& chunk)
+        {
+            dh(chunk);
+            flight->deliver(chunk);
+        });
+    } catch (const core::net::Error& e)
+    {
+        land(flight, e);
+        throw;
+    } catch (const std::exception& e)
+    {
+        land(flight, http::Error(e.what(), CORE_FROM_HERE()));
+        throw;
+    }
+
+    land(flight, response);
+    return response;
+}
+
+void http::impl::curl::CoalescedRequest::async_execute(const http::Request::Handler& handler)
+{
+    async_execute(handler, [](const std::string&){});
+}
+
+void http::impl::curl::CoalescedRequest::async_execute(const http::Request::Handler& handler,
+                                                       const http::StreamingRequest::DataHandler& dh)
+{
+    activate();
+
+    auto thiz = shared_from_this();
+
+    if (has_options())
+    {
+        auto wrapped = handler;
+        wrapped.on_response([thiz, handler](const http::Response& response)
+        {
+            thiz->atomic_state.store(http::Request::State::done);
+
+            if (handler.on_response())
+                handler.on_response()(response);
+        });
+        wrapped.on_error([thiz, handler](const core::net::Error& error)
+        {
+            thiz->atomic_state.store(http::Request::State::done);
+
+            if (handler.on_error())
+                handler.on_error()(error);
+        });
+
+        lead()->async_execute(wrapped, dh);
+        return;
+    }
+
+    Coalescer::Waiter waiter
+    {
+        dh,
+        [thiz, handler](const http::Response& response)
+        {
+            thiz->atomic_state.store(http::Request::State::done);
+
+            if (handler.on_response())
+                handler.on_response()(response);
+        },
+        [thiz, handler](const core::net::Error& error)
+        {
+            thiz->atomic_state.store(http::Request::State::done);
+
+            if (handler.on_error())
+                handler.on_error()(error);
+        }
+    };
+
+    bool leads{false};
+    auto flight = coalescer->join(key, waiter, leads);
+
+    // The transfer is not ours, so the progress handler is never invoked.
+    if (not leads)
+        return;
+
+    http::Request::Handler wrapped;
+    wrapped.on_progress(handler.on_progress());
+    wrapped.on_response([thiz, flight, waiter](const http::Response& response)
+    {
+        thiz->land(flight, response);
+        waiter.on_response(response);
+    });
+    wrapped.on_error([thiz, flight, waiter](const core::net::Error& error)
+    {
+        thiz->land(flight, error);
+        waiter.on_error(error);
+    });
+
+    try
+    {
+        lead()->async_execute(wrapped, [dh, flight](const std::string& chunk)
+        {
+            dh(chunk);
+            flight->deliver(chunk);
+        });
+    } catch (const std::exception& e)
+    {
+        land(flight, http::Error(e.what(), CORE_FROM_HERE()));
+        throw;
+    }
+}
+
+std::string http::impl::curl::CoalescedRequest::url_escape(const std::string& s)
+{
+    return core::net::percent_encoding::encode(s);
+}
+
+std::string http::impl::curl::CoalescedRequest::url_unescape(const std::string& s)
+{
+    return core::net::percent_encoding::decode(s);
+}
+
+void http::impl::curl::CoalescedRequest::pause()
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    if (request)
+        request->pause();
+}
+
+void http::impl::curl::CoalescedRequest::resume()
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    if (request)
+        request->resume();
+}
+
+void http::impl::curl::CoalescedRequest::abort_request_if(std::uint64_t limit, const std::chrono::seconds& time)
+{
+    configure([limit, time](http::StreamingRequest& request) { request.abort_request_if(limit, time); });
+}
+
+void http::impl::curl::CoalescedRequest::activate()
+{
+    auto expected = http::Request::State::ready;
+
+    if (not atomic_state.compare_exchange_strong(expected, http::Request::State::active))
+        throw http::Request::Errors::AlreadyActive{CORE_FROM_HERE()};
+}
+
+void http::impl::curl::CoalescedRequest::configure(const std::function<void(http::StreamingRequest&)>& option)
+{
+    if (atomic_state.load() != http::Request::State::ready)
+        throw http::Request::Errors::AlreadyActive{CORE_FROM_HERE()};
+
+    std::lock_guard<std::mutex> lg(guard);
+    options.push_back(option);
+}
+
+bool http::impl::curl::CoalescedRequest::has_options()
+{
+    std::lock_guard<std::mutex> lg(guard);
+    return not options.empty();
+}
+
+std::shared_ptr<http::StreamingRequest> http::impl::curl::CoalescedRequest::lead()
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    request = factory();
+
+    for (const auto& option : options)
+        option(*request);
+
+    return request;
+}
+
+void http::impl::curl::CoalescedRequest::land(const std::shared_ptr<Coalescer::Flight>& flight,
+                                              const http::Response& response)
+{
+    coalescer->retire(key, flight);
+    atomic_state.store(http::Request::State::done);
+    flight->complete(response);
+}
+
+void http::impl::curl::CoalescedRequest::land(const std::shared_ptr<Coalescer::Flight>& flight,
+                                              const core::net::Error& error)
+{
+    coalescer->retire(key, flight);
+    atomic_state.store(http::Request::State::done);
+    flight->fail(error);
+}
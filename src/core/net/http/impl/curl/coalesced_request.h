@@ -0,0 +1,112 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_COALESCED_REQUEST_H_
+#define CORE_NET_HTTP_IMPL_CURL_COALESCED_REQUEST_H_
+
+#include <core/net/http/streaming_request.h>
+
+#include "coalescer.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace curl
+{
+// Shares a single transfer with identical requests executed at the same time.
+// The first request to execute carries out the transfer, and only then creates
+// the underlying request. Requests executed while the transfer is in flight
+// receive the chunks received so far, all further chunks and the final response
+// or error, unless the transfer received more than its coalescer replays, in
+// which case they carry out their own. Only the request carrying out the
+// transfer reports progress, the progress handlers of requests sharing it are
+// never invoked. Requests with a timeout or a speed limit never share a
+// transfer, as they could not honour them on one they do not own, and carry out
+// their own instead. Pausing and resuming a request sharing the transfer of
+// another one has no effect.
+class CoalescedRequest : public core::net::http::StreamingRequest,
+                         public std::enable_shared_from_this<CoalescedRequest>
+{
+public:
+    // Function type creating the request that carries out the transfer.
+    typedef std::function<std::shared_ptr<StreamingRequest>()> Factory;
+
+    // Creates a new instance sharing transfers under key via coalescer,
+    // relying on factory to set up a request if it has to lead.
+    CoalescedRequest(const std::shared_ptr<Coalescer>& coalescer,
+                     const std::string& key,
+                     const Factory& factory);
+
+    // From core::net::http::StreamingRequest
+    State state() override;
+    void set_timeout(const std::chrono::milliseconds& timeout) override;
+    Response execute(const Request::ProgressHandler& ph) override;
+    Response execute(const Request::ProgressHandler& ph, const StreamingRequest::DataHandler& dh) override;
+    void async_execute(const Request::Handler& handler) override;
+    void async_execute(const Request::Handler& handler, const StreamingRequest::DataHandler& dh) override;
+    std::string url_escape(const std::string& s) override;
+    std::string url_unescape(const std::string& s) override;
+    void pause() override;
+    void resume() override;
+    void abort_request_if(std::uint64_t limit, const std::chrono::seconds& time) override;
+
+private:
+    // Switches from State::ready to State::active, throws AlreadyActive otherwise.
+    void activate();
+
+    // Remembers option to be applied to the request carrying out the transfer.
+    void configure(const std::function<void(StreamingRequest&)>& option);
+
+    // Returns true if any options have been configured.
+    bool has_options();
+
+    // Creates the request carrying out the transfer, with all options applied.
+    std::shared_ptr<StreamingRequest> lead();
+
+    // Stops further requests from joining flight, and hands out its outcome.
+    void land(const std::shared_ptr<Coalescer::Flight>& flight, const Response& response);
+    void land(const std::shared_ptr<Coalescer::Flight>& flight, const core::net::Error& error);
+
+    std::shared_ptr<Coalescer> coalescer;
+    std::string key;
+    Factory factory;
+
+    std::atomic<State> atomic_state;
+
+    std::mutex guard;
+    std::vector<std::function<void(StreamingRequest&)>> options;
+    // Only set if this request leads a flight.
+    std::shared_ptr<StreamingRequest> request;
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_COALESCED_REQUEST_H_
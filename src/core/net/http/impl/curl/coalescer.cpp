@@ -0,0 +1,169 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "coalescer.h"
+
+#include <sstream>
+
+namespace http = core::net::http;
+
+http::impl::curl::Coalescer::Flight::Flight(std::size_t replay_limit)
+    : replay_limit(replay_limit)
+{
+}
+
+void http::impl::curl::Coalescer::Flight::deliver(const std::string& chunk)
+{
+    std::lock_guard<std::recursive_mutex> lg(guard);
+
+    if (not overflowed && received.size() + chunk.size() > replay_limit)
+    {
+        // Late joiners would miss chunks, so there are none from now on.
+        overflowed = true;
+        std::string().swap(received);
+    }
+
+    if (not overflowed)
+        received.append(chunk);
+
+    for (const auto& waiter : waiters)
+        waiter.dh(chunk);
+}
+
+void http::impl::curl::Coalescer::Flight::complete(const http::Response& response)
+{
+    std::vector<Waiter> attached;
+
+    {
+        std::lock_guard<std::recursive_mutex> lg(guard);
+        landed = true;
+        waiters.swap(attached);
+    }
+
+    for (const auto& waiter : attached)
+        if (waiter.on_response)
+            waiter.on_response(response);
+}
+
+void http::impl::curl::Coalescer::Flight::fail(const core::net::Error& error)
+{
+    std::vector<Waiter> attached;
+
+    {
+        std::lock_guard<std::recursive_mutex> lg(guard);
+        landed = true;
+        waiters.swap(attached);
+    }
+
+    for (const auto& waiter : attached)
+        if (waiter.on_error)
+            waiter.on_error(error);
+}
+
+bool http::impl::curl::Coalescer::Flight::attach(const Waiter& waiter)
+{
+    std::lock_guard<std::recursive_mutex> lg(guard);
+
+    if (landed || overflowed)
+        return false;
+
+    if (not received.empty())
+        waiter.dh(received);
+
+    waiters.push_back(waiter);
+    return true;
+}
+
+http::impl::curl::Coalescer::Coalescer(std::size_t replay_limit)
+    : replay_limit(replay_limit)
+{
+}
+
+bool http::impl::curl::Coalescer::is_coalescable(http::Method method, const http::Request::Configuration& configuration)
+{
+    if (method != http::Method::get && method != http::Method::head)
+        return false;
+
+    // Credentials are handed out per request, we cannot tell whether they match.
+    return not configuration.authentication_handler.for_http;
+}
+
+std::string http::impl::curl::Coalescer::key_for(http::Method method, const http::Request::Configuration& configuration)
+{
+    std::stringstream ss;
+
+    ss << (method == http::Method::head ? "HEAD " : "GET ") << configuration.uri << "\n"
+       << configuration.ssl.verify_peer << configuration.ssl.verify_host << "\n";
+
+    // Fields are enumerated in order, such that identical headers yield identical keys.
+    configuration.header.enumerate([&ss](const std::string& key, const std::set<std::string>& values)
+    {
+        for (const auto& value : values)
+            ss << key << ": " << value << "\n";
+    });
+
+    return ss.str();
+}
+
+std::shared_ptr<http::impl::curl::Coalescer::Flight> http::impl::curl::Coalescer::join(
+        const std::string& key, const Waiter& waiter, bool& leads)
+{
+    while (true)
+    {
+        std::shared_ptr<Flight> flight;
+
+        {
+            std::lock_guard<std::mutex> lg(guard);
+
+            auto it = flights.find(key);
+
+            if (it == flights.end())
+            {
+                flight = std::make_shared<Flight>(replay_limit);
+                flights.insert(std::make_pair(key, flight));
+                leads = true;
+
+                return flight;
+            }
+
+            flight = it->second;
+        }
+
+        // We attach without holding guard, as data handlers invoked while
+        // attaching might issue requests themselves. If the flight landed in
+        // the meantime, it has been retired already. If it received too much
+        // to replay, we retire it ourselves. Either way, we start over.
+        if (flight->attach(waiter))
+        {
+            leads = false;
+            return flight;
+        }
+
+        retire(key, flight);
+    }
+}
+
+void http::impl::curl::Coalescer::retire(const std::string& key, const std::shared_ptr<Flight>& flight)
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    auto it = flights.find(key);
+
+    if (it != flights.end() && it->second == flight)
+        flights.erase(it);
+}
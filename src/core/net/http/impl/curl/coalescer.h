@@ -0,0 +1,121 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_COALESCER_H_
+#define CORE_NET_HTTP_IMPL_CURL_COALESCER_H_
+
+#include <core/net/http/method.h>
+#include <core/net/http/response.h>
+#include <core/net/http/streaming_request.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace curl
+{
+// Keeps track of the transfers in flight, such that concurrent identical
+// requests attach to a single transfer instead of starting their own.
+class Coalescer
+{
+public:
+    // Callbacks of a request waiting for the outcome of a flight.
+    struct Waiter
+    {
+        StreamingRequest::DataHandler dh;
+        core::net::http::Request::ResponseHandler on_response;
+        core::net::http::Request::ErrorHandler on_error;
+    };
+
+    // A transfer shared by all requests attached to it.
+    class Flight
+    {
+    public:
+        // Creates a flight replaying up to replay_limit bytes to late joiners.
+        explicit Flight(std::size_t replay_limit);
+
+        // Hands chunk to all waiters and keeps it around for late joiners,
+        // unless that exceeds the replay limit.
+        void deliver(const std::string& chunk);
+
+        // Hands response to all waiters.
+        void complete(const Response& response);
+
+        // Hands error to all waiters.
+        void fail(const core::net::Error& error);
+
+    private:
+        friend class Coalescer;
+
+        // Replays the chunks received so far to waiter and attaches it. Returns
+        // false if the flight has already landed or cannot replay all chunks.
+        bool attach(const Waiter& waiter);
+
+        // Chunks are handed out with guard held to keep them in order
+        // for late joiners. Data handlers may issue requests themselves.
+        std::recursive_mutex guard;
+        std::size_t replay_limit;
+        std::string received;
+        std::vector<Waiter> waiters;
+        bool landed{false};
+        // Set once the chunks received exceed replay_limit, no one joins from then on.
+        bool overflowed{false};
+    };
+
+    // Creates a coalescer whose flights admit joiners until they
+    // received more than replay_limit bytes.
+    explicit Coalescer(std::size_t replay_limit);
+
+    // Returns true if requests carrying out method with the given configuration
+    // can share a transfer, i.e., they are safe and do not carry credentials.
+    static bool is_coalescable(Method method, const core::net::http::Request::Configuration& configuration);
+
+    // Returns the key that identical requests share.
+    static std::string key_for(Method method, const core::net::http::Request::Configuration& configuration);
+
+    // Attaches waiter to the flight in progress for key and returns it. If there
+    // is none, or it cannot be joined anymore, a new flight without waiters is
+    // registered and returned, and leads is set to true. The caller then carries
+    // out the transfer and has to retire the flight before handing out its outcome.
+    std::shared_ptr<Flight> join(const std::string& key, const Waiter& waiter, bool& leads);
+
+    // Stops further requests from joining flight.
+    void retire(const std::string& key, const std::shared_ptr<Flight>& flight);
+
+private:
+    std::size_t replay_limit;
+
+    std::mutex guard;
+    std::unordered_map<std::string, std::shared_ptr<Flight>> flights;
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_COALESCER_H_
@@ -164,9 +164,15 @@ struct easy::Handle::Private
     easy::Handle::OnReadData on_read_data_cb;
     easy::Handle::OnWriteData on_write_data_cb;
     easy::Handle::OnWriteHeader on_write_header_cb;
+    easy::Handle::OnPrerequest on_prerequest_cb;
+    easy::Handle::OnSeek on_seek_cb;
 
     ::curl::StringList* header_string_list;
+    std::shared_ptr<const std::string> post_data;
+    std::string route;
     char error[CURL_ERROR_SIZE];
+    // Set while performed synchronously, without a reactor to resume the transfer.
+    bool performing{false};
 };
 
 int easy::Handle::progress_cb(void* data, double dltotal, double dlnow, double ultotal, double ulnow)
@@ -211,6 +217,38 @@ std::size_t easy::Handle::write_header_cb(void* data, size_t size, size_t nmemb,
     return did_not_consume_any_data;
 }
 
+int easy::Handle::prereq_cb(void* cookie, char*, char*, int, int)
+{
+    auto thiz = static_cast<easy::Handle::Private*>(cookie);
+
+    if (thiz && thiz->on_prerequest_cb)
+        thiz->on_prerequest_cb();
+
+#if LIBCURL_VERSION_NUM >= 0x075000
+    return CURL_PREREQFUNC_OK;
+#else
+    return 0;
+#endif
+}
+
+int easy::Handle::seek_cb(void* cookie, curl_off_t offset, int origin)
+{
+    auto thiz = static_cast<easy::Handle::Private*>(cookie);
+
+    if (thiz && thiz->on_seek_cb)
+    {
+        try
+        {
+            return thiz->on_seek_cb(offset, origin) ? CURL_SEEKFUNC_OK : CURL_SEEKFUNC_CANTSEEK;
+        } catch (...)
+        {
+            return CURL_SEEKFUNC_FAIL;
+        }
+    }
+
+    return CURL_SEEKFUNC_CANTSEEK;
+}
+
 std::size_t easy::Handle::read_data_cb(void* data, std::size_t size, std::size_t nmemb, void *cookie)
 {
     static const std::size_t did_not_consume_any_data = 0;
@@ -219,7 +257,13 @@ std::size_t easy::Handle::read_data_cb(void* data, std::size_t size, std::size_t
 
     if (thiz && thiz->on_read_data_cb)
     {
-        return thiz->on_read_data_cb(data, size, nmemb);
+        auto result = thiz->on_read_data_cb(data, size, nmemb);
+
+        // Nothing could ever unpause a synchronous transfer, so we give up instead of hanging.
+        if (thiz->performing && result == CURL_READFUNC_PAUSE)
+            return CURL_READFUNC_ABORT;
+
+        return result;
     }
 
     return did_not_consume_any_data;
@@ -333,6 +377,19 @@ easy::Handle& easy::Handle::on_read_data(const easy::Handle::OnReadData& on_read
     return *this;
 }
 
+easy::Handle& easy::Handle::on_read_data(const easy::Handle::OnReadData& on_read_data)
+{
+    if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
+
+    set_option(Option::read_function, Handle::read_data_cb);
+    set_option(Option::read_data, d.get());
+    set_option(Option::in_file_size, easy::unknown_size);
+
+    d->on_read_data_cb = on_read_data;
+
+    return *this;
+}
+
 easy::Handle& easy::Handle::on_write_data(const easy::Handle::OnWriteData& on_new_data)
 {
     if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
@@ -357,6 +414,32 @@ easy::Handle& easy::Handle::on_write_header(const easy::Handle::OnWriteHeader& o
     return *this;
 }
 
+easy::Handle& easy::Handle::on_prerequest(const easy::Handle::OnPrerequest& on_prerequest)
+{
+    if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
+
+#if LIBCURL_VERSION_NUM >= 0x075000
+    set_option(Option::prereq_function, Handle::prereq_cb);
+    set_option(Option::prereq_data, d.get());
+#endif
+
+    d->on_prerequest_cb = on_prerequest;
+
+    return *this;
+}
+
+easy::Handle& easy::Handle::on_seek(const easy::Handle::OnSeek& on_seek)
+{
+    if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
+
+    set_option(Option::seek_function, Handle::seek_cb);
+    set_option(Option::seek_data, d.get());
+
+    d->on_seek_cb = on_seek;
+
+    return *this;
+}
+
 easy::Handle& easy::Handle::method(core::net::http::Method method)
 {
     if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
@@ -399,6 +482,24 @@ easy::Handle& easy::Handle::post_data(const std::string& data, const std::string
     return *this;
 }
 
+easy::Handle& easy::Handle::post_data(const std::shared_ptr<const std::string>& data, const std::string&)
+{
+    if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
+
+    long content_length = data->size();
+    set_option(Option::post_field_size, content_length);
+    set_option(Option::postfields, data->c_str());
+
+    d->post_data = data;
+
+    return *this;
+}
+
+easy::Handle& easy::Handle::post_data(std::string&& data, const std::string& ct)
+{
+    return post_data(std::make_shared<const std::string>(std::move(data)), ct);
+}
+
 easy::Handle& easy::Handle::header(const core::net::http::Header& header)
 {
     if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
@@ -420,6 +521,30 @@ easy::Handle& easy::Handle::header(const core::net::http::Header& header)
     return *this;
 }
 
+easy::Handle& easy::Handle::route(const std::string& route)
+{
+    if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
+
+    d->route = route;
+    return *this;
+}
+
+const std::string& easy::Handle::route() const
+{
+    if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
+
+    return d->route;
+}
+
+std::string easy::Handle::effective_url()
+{
+    if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
+
+    char* result{nullptr};
+    get_option(curl::Info::effective_url, &result);
+    return result ? result : "";
+}
+
 core::net::http::Status easy::Handle::status()
 {
     if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
@@ -437,9 +562,22 @@ easy::native::Handle easy::Handle::native() const
 }
 
 void easy::Handle::perform()
+{
+    perform(easy::Handle::OnFinished{});
+}
+
+void easy::Handle::perform(const easy::Handle::OnFinished& on_finished)
 {
     if (!d) throw easy::Handle::HandleHasBeenAbandoned{};
-    throw_if_not<curl::Code::ok>(easy::native::perform(native()), [this]() { return std::string{d->error};});
+
+    d->performing = true;
+    auto code = easy::native::perform(native());
+    d->performing = false;
+
+    if (on_finished)
+        on_finished(code);
+
+    throw_if_not<curl::Code::ok>(code, [this]() { return std::string{d->error};});
 }
 
 // URL escapes the given input string.
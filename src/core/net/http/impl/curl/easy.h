@@ -29,6 +29,7 @@
 #include <curl/curl.h>
 
 #include <chrono>
+#include <cstdint>
 #include <iosfwd>
 #include <sstream>
 #include <system_error>
@@ -90,7 +91,8 @@ enum class Code
     ssl_issuer_error = CURLE_SSL_ISSUER_ERROR,
     chunk_failed = CURLE_CHUNK_FAILED,
     no_connection_available = CURLE_NO_CONNECTION_AVAILABLE,
-    no_readfunc_abort = CURL_READFUNC_ABORT
+    no_readfunc_abort = CURL_READFUNC_ABORT,
+    readfunc_pause = CURL_READFUNC_PAUSE
 };
 
 std::ostream& operator<<(std::ostream& out, Code code);
@@ -103,7 +105,20 @@ enum class Info
     appconnect_time = CURLINFO_APPCONNECT_TIME,
     pretransfer_time = CURLINFO_PRETRANSFER_TIME,
     starttransfer_time = CURLINFO_STARTTRANSFER_TIME,
-    total_time = CURLINFO_TOTAL_TIME
+    total_time = CURLINFO_TOTAL_TIME,
+    effective_url = CURLINFO_EFFECTIVE_URL,
+    header_size = CURLINFO_HEADER_SIZE,
+    request_size = CURLINFO_REQUEST_SIZE,
+    size_upload = CURLINFO_SIZE_UPLOAD_T,
+    size_download = CURLINFO_SIZE_DOWNLOAD_T,
+    num_connects = CURLINFO_NUM_CONNECTS,
+    redirect_count = CURLINFO_REDIRECT_COUNT,
+    redirect_time = CURLINFO_REDIRECT_TIME,
+    http_version = CURLINFO_HTTP_VERSION,
+    primary_ip = CURLINFO_PRIMARY_IP,
+    primary_port = CURLINFO_PRIMARY_PORT,
+    local_ip = CURLINFO_LOCAL_IP,
+    local_port = CURLINFO_LOCAL_PORT
 };
 
 enum class Option
@@ -127,6 +142,7 @@ enum class Option
     http_post = CURLOPT_POST,
     http_put = CURLOPT_PUT,
     copy_postfields = CURLOPT_COPYPOSTFIELDS,
+    postfields = CURLOPT_POSTFIELDS,
     post_field_size = CURLOPT_POSTFIELDSIZE,
     upload = CURLOPT_UPLOAD,
     in_file_size = CURLOPT_INFILESIZE,
@@ -141,7 +157,13 @@ enum class Option
     ssl_verify_host = CURLOPT_SSL_VERIFYHOST,
     customrequest = CURLOPT_CUSTOMREQUEST,
     low_speed_limit = CURLOPT_LOW_SPEED_LIMIT,
-    low_speed_time = CURLOPT_LOW_SPEED_TIME
+    low_speed_time = CURLOPT_LOW_SPEED_TIME,
+#if LIBCURL_VERSION_NUM >= 0x075000
+    prereq_function = CURLOPT_PREREQFUNCTION,
+    prereq_data = CURLOPT_PREREQDATA,
+    seek_function = CURLOPT_SEEKFUNCTION,
+    seek_data = CURLOPT_SEEKDATA
+#endif
 };
 
 namespace native
@@ -169,6 +191,9 @@ constexpr static const long enable = 1;
 // Constant for enabling automatic SSL host verification.
 constexpr static const long enable_ssl_host_verification = 2;
 
+// Constant for announcing an upload whose size is not known in advance.
+constexpr static const long unknown_size = -1;
+
 // Returns a human-readable description of the error code.
 std::string print_error(Code code);
 
@@ -274,6 +299,10 @@ public:
     typedef std::function<std::size_t(char*, std::size_t, std::size_t)> OnWriteData;
     // Function type that gets called whenever header data should be written.
     typedef std::function<std::size_t(void*, std::size_t, std::size_t)> OnWriteHeader;
+    // Function type that gets called once a connection is ready, right before a request is sent.
+    typedef std::function<void()> OnPrerequest;
+    // Function type that gets called whenever an upload has to be rewound, returning false if it cannot be.
+    typedef std::function<bool(std::int64_t offset, int origin)> OnSeek;
 
     // Creates a new handle and initializes the underlying curl easy instance.
     Handle();
@@ -328,16 +357,34 @@ public:
     Handle& on_progress(const OnProgress& on_progress);
     // Sets the OnReadData handler.
     Handle& on_read_data(const OnReadData& on_read_data, std::size_t size);
+    // Sets the OnReadData handler for an upload of unknown size.
+    Handle& on_read_data(const OnReadData& on_read_data);
     // Sets the OnWriteData handler.
     Handle& on_write_data(const OnWriteData& on_new_data);
     // Sets the OnWriteHeader handler.
     Handle& on_write_header(const OnWriteHeader& on_new_header);
+    // Sets the OnPrerequest handler, which is never invoked with versions of curl prior to 7.80.0.
+    Handle& on_prerequest(const OnPrerequest& on_prerequest);
+    // Sets the OnSeek handler.
+    Handle& on_seek(const OnSeek& on_seek);
     // Sets the http method used by this instance.
     Handle& method(core::net::http::Method method);
     // Sets the data to be posted by this instance.
     Handle& post_data(const std::string& data, const std::string&);
+    // Sets the data to be posted by this instance without copying it.
+    // The instance keeps the data alive until it is released.
+    Handle& post_data(const std::shared_ptr<const std::string>& data, const std::string&);
+    // Sets the data to be posted by this instance, taking ownership of it.
+    Handle& post_data(std::string&& data, const std::string&);
     // Sets custom request headers
     Handle& header(const core::net::http::Header& header);
+    // Labels the transfer with the route it belongs to, for breaking down metrics.
+    Handle& route(const std::string& route);
+
+    // Queries the route label of this instance.
+    const std::string& route() const;
+    // Queries the url of the last transfer, after following redirects.
+    std::string effective_url();
 
     // Queries the current status of this instance.
     core::net::http::Status status();
@@ -347,6 +394,10 @@ public:
     // Executes the operation associated with this handle.
     void perform();
 
+    // Executes the operation associated with this handle, handing
+    // its result to on_finished prior to throwing in case of issues.
+    void perform(const OnFinished& on_finished);
+
     // URL escapes the given input string.
     std::string escape(const std::string& in);
 
@@ -367,6 +418,8 @@ private:
     static std::size_t read_data_cb(void* data, std::size_t size, std::size_t nmemb, void *cookie);
     static std::size_t write_data_cb(char* data, size_t size, size_t nmemb, void* cookie);
     static std::size_t write_header_cb(void* data, size_t size, size_t nmemb, void* cookie);
+    static int prereq_cb(void* cookie, char* primary_ip, char* local_ip, int primary_port, int local_port);
+    static int seek_cb(void* cookie, curl_off_t offset, int origin);
 
     // Returns the current error description.
     std::string error() const;
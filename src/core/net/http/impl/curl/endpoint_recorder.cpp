@@ -0,0 +1,198 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "endpoint_recorder.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace http = core::net::http;
+namespace multi = curl::multi;
+
+namespace
+{
+std::string lower_case(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+const char* default_port_for(const std::string& scheme)
+{
+    if (scheme == "http")
+        return "80";
+    if (scheme == "https")
+        return "443";
+
+    return nullptr;
+}
+}
+
+std::string multi::origin_of(const std::string& url)
+{
+    auto scheme_end = url.find("://");
+
+    if (scheme_end == std::string::npos)
+        return std::string{};
+
+    auto scheme = lower_case(url.substr(0, scheme_end));
+
+    auto authority_begin = scheme_end + 3;
+    auto authority_end = url.find_first_of("/?#", authority_begin);
+    auto authority = url.substr(authority_begin, authority_end == std::string::npos ? std::string::npos : authority_end - authority_begin);
+
+    // Credentials never make it into metrics.
+    auto at = authority.rfind('@');
+    if (at != std::string::npos)
+        authority.erase(0, at + 1);
+
+    authority = lower_case(authority);
+
+    // Colons within brackets belong to an IPv6 address.
+    auto colon = authority.rfind(':');
+    auto bracket = authority.rfind(']');
+    bool has_port = colon != std::string::npos && (bracket == std::string::npos || colon > bracket);
+
+    if (not has_port)
+    {
+        if (auto port = default_port_for(scheme))
+            authority.append(":").append(port);
+    }
+
+    return scheme + "://" + authority;
+}
+
+multi::EndpointRecorder::Series::Series()
+{
+    for (auto& counter : responses)
+        counter.store(0, std::memory_order_relaxed);
+
+    for (auto& counter : errors)
+        counter.store(0, std::memory_order_relaxed);
+}
+
+multi::EndpointRecorder::EndpointRecorder(std::size_t capacity)
+    : capacity(capacity)
+{
+}
+
+void multi::EndpointRecorder::record(easy::Handle easy, const Transfer& transfer)
+{
+    auto s = series_for(origin_of(easy.effective_url()), easy.route());
+
+    s->requests.fetch_add(1, std::memory_order_relaxed);
+
+    if (transfer.code == curl::Code::ok)
+    {
+        auto status_class = static_cast<std::size_t>(transfer.status) / 100;
+
+        if (status_class >= 1 && status_class <= s->responses.size())
+            s->responses[status_class - 1].fetch_add(1, std::memory_order_relaxed);
+    } else
+    {
+        auto index = static_cast<std::size_t>(transfer.code);
+
+        if (index < s->errors.size())
+            s->errors[index].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    s->bytes_sent.fetch_add(transfer.bytes_sent, std::memory_order_relaxed);
+    s->bytes_received.fetch_add(transfer.bytes_received, std::memory_order_relaxed);
+
+    s->timings.record(transfer.timings);
+}
+
+std::vector<http::Client::EndpointMetrics> multi::EndpointRecorder::collect()
+{
+    std::vector<std::shared_ptr<Series>> snapshot;
+
+    {
+        std::lock_guard<std::mutex> lg(guard);
+
+        snapshot = series;
+        if (overflow)
+            snapshot.push_back(overflow);
+    }
+
+    std::vector<http::Client::EndpointMetrics> result;
+    result.reserve(snapshot.size());
+
+    for (const auto& s : snapshot)
+    {
+        http::Client::EndpointMetrics metrics;
+
+        metrics.origin = s->origin;
+        metrics.route = s->route;
+        metrics.overflow = s->overflow;
+        metrics.requests = s->requests.load(std::memory_order_relaxed);
+
+        metrics.responses.informational = s->responses[0].load(std::memory_order_relaxed);
+        metrics.responses.success = s->responses[1].load(std::memory_order_relaxed);
+        metrics.responses.redirection = s->responses[2].load(std::memory_order_relaxed);
+        metrics.responses.client_error = s->responses[3].load(std::memory_order_relaxed);
+        metrics.responses.server_error = s->responses[4].load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < s->errors.size(); i++)
+            if (auto count = s->errors[i].load(std::memory_order_relaxed))
+                metrics.errors[i] = count;
+
+        metrics.bytes_sent = s->bytes_sent.load(std::memory_order_relaxed);
+        metrics.bytes_received = s->bytes_received.load(std::memory_order_relaxed);
+
+        s->timings.collect(metrics.timings, false);
+        summarize(metrics.timings);
+
+        result.push_back(std::move(metrics));
+    }
+
+    return result;
+}
+
+std::shared_ptr<multi::EndpointRecorder::Series> multi::EndpointRecorder::series_for(const std::string& origin, const std::string& route)
+{
+    auto key = origin + '\n' + route;
+
+    std::lock_guard<std::mutex> lg(guard);
+
+    auto it = index.find(key);
+    if (it != index.end())
+        return it->second;
+
+    std::shared_ptr<Series> result;
+
+    if (series.size() < capacity)
+    {
+        result = std::make_shared<Series>();
+        result->origin = origin;
+        result->route = route;
+
+        series.push_back(result);
+        index.insert(std::make_pair(key, result));
+    } else
+    {
+        if (not overflow)
+        {
+            overflow = std::make_shared<Series>();
+            overflow->overflow = true;
+        }
+
+        result = overflow;
+    }
+
+    return result;
+}
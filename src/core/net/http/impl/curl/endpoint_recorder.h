@@ -0,0 +1,94 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_ENDPOINT_RECORDER_H_
+#define CORE_NET_HTTP_IMPL_CURL_ENDPOINT_RECORDER_H_
+
+#include <core/net/http/client.h>
+
+#include "easy.h"
+#include "timing_recorder.h"
+#include "transfer_counters.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace curl
+{
+namespace multi
+{
+// Breaks down metrics of completed transfers by endpoint, i.e., by origin and
+// route label. At most capacity endpoints are tracked, further ones are accounted
+// for in an overflow series. Looking up the series of a transfer is guarded by
+// a mutex, accounting for the transfer is lock-free.
+class EndpointRecorder
+{
+public:
+    // Creates a new instance tracking at most capacity endpoints.
+    EndpointRecorder(std::size_t capacity);
+
+    EndpointRecorder(const EndpointRecorder&) = delete;
+    EndpointRecorder& operator=(const EndpointRecorder&) = delete;
+
+    // Accounts for the transfer carried out by easy.
+    void record(easy::Handle easy, const Transfer& transfer);
+
+    // Returns the metrics of all endpoints seen so far.
+    std::vector<core::net::http::Client::EndpointMetrics> collect();
+
+private:
+    struct Series
+    {
+        Series();
+
+        std::string origin;
+        std::string route;
+        bool overflow{false};
+
+        std::atomic<std::uint64_t> requests{0};
+        // Indexed by the class of the status code minus 1.
+        std::array<std::atomic<std::uint64_t>, 5> responses;
+        // Indexed by CURLcode.
+        std::array<std::atomic<std::uint64_t>, CURL_LAST> errors;
+        std::atomic<std::uint64_t> bytes_sent{0};
+        std::atomic<std::uint64_t> bytes_received{0};
+        TimingHistograms timings;
+    };
+
+    // Returns the series for origin and route, setting it up if there is room for it.
+    std::shared_ptr<Series> series_for(const std::string& origin, const std::string& route);
+
+    const std::size_t capacity;
+
+    std::mutex guard;
+    std::unordered_map<std::string, std::shared_ptr<Series>> index;
+    std::vector<std::shared_ptr<Series>> series;
+    std::shared_ptr<Series> overflow;
+};
+
+// Returns the lower-cased scheme, host and port of url, filling in
+// the default port of the scheme if url does not carry one.
+std::string origin_of(const std::string& url);
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_ENDPOINT_RECORDER_H_
@@ -0,0 +1,181 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "event_source.h"
+
+#include <core/net/http/response.h>
+
+namespace http = core::net::http;
+
+http::EventSource::Errors::ConnectionFailed::ConnectionFailed(http::Status status, const core::Location& loc)
+    : core::net::Error("Event stream answered with status " + std::to_string(static_cast<int>(status)) + ".", loc),
+      status(status)
+{
+}
+
+std::shared_ptr<http::impl::curl::EventSource> http::impl::curl::EventSource::open(
+        ::curl::multi::Handle multi,
+        const http::Request::Configuration& configuration,
+        const RequestFactory& factory,
+        const http::EventStream::Handler& on_event,
+        const http::Request::ErrorHandler& on_error)
+{
+    std::shared_ptr<EventSource> result{new EventSource{multi, configuration, factory, on_event, on_error}};
+    result->connect();
+    return result;
+}
+
+http::impl::curl::EventSource::EventSource(
+        ::curl::multi::Handle multi,
+        const http::Request::Configuration& configuration,
+        const RequestFactory& factory,
+        const http::EventStream::Handler& on_event,
+        const http::Request::ErrorHandler& on_error)
+    : multi(multi),
+      configuration(configuration),
+      factory(factory),
+      on_error(on_error),
+      closed(false),
+      stream(on_event)
+{
+}
+
+http::impl::curl::EventSource::~EventSource()
+{
+    close();
+}
+
+void http::impl::curl::EventSource::close()
+{
+    std::lock_guard<std::recursive_mutex> lg(guard);
+    closed = true;
+}
+
+std::string http::impl::curl::EventSource::last_event_id() const
+{
+    std::lock_guard<std::recursive_mutex> lg(guard);
+    return stream.last_event_id();
+}
+
+void http::impl::curl::EventSource::connect()
+{
+    std::lock_guard<std::recursive_mutex> lg(guard);
+
+    if (closed)
+        return;
+
+    auto c = configuration;
+    c.header.set("Accept", "text/event-stream");
+    c.header.set("Cache-Control", "no-cache");
+    if (not stream.last_event_id().empty())
+        c.header.set("Last-Event-ID", stream.last_event_id());
+
+    stream.reset();
+
+    // Requests must not keep us alive, the subscription ends with the last reference.
+    std::weak_ptr<EventSource> weak{shared_from_this()};
+
+    request = factory(c);
+    request->async_execute(
+                http::Request::Handler()
+                    .on_progress([weak](const http::Request::Progress&)
+                    {
+                        // Merely a hint to stop early, and atomic, so we do not take the lock.
+                        auto sp = weak.lock();
+                        return sp && not sp->closed ?
+                                    http::Request::Progress::Next::continue_operation :
+                                    http::Request::Progress::Next::abort_operation;
+                    })
+                    .on_response([weak](const http::Response& response)
+                    {
+                        if (auto sp = weak.lock())
+                            sp->on_finished(response.status);
+                    })
+                    .on_error([weak](const core::net::Error& e)
+                    {
+                        if (auto sp = weak.lock())
+                            sp->on_failed(e);
+                    }),
+                [weak](const std::string& chunk)
+                {
+                    if (auto sp = weak.lock())
+                        sp->on_chunk(chunk);
+                });
+}
+
+void http::impl::curl::EventSource::on_chunk(const std::string& chunk)
+{
+    std::lock_guard<std::recursive_mutex> lg(guard);
+
+    if (not closed)
+        stream.feed(chunk);
+}
+
+void http::impl::curl::EventSource::on_finished(http::Status status)
+{
+    {
+        std::lock_guard<std::recursive_mutex> lg(guard);
+
+        if (closed)
+            return;
+
+        // Anything but a stream, including 204, tells us to stop.
+        if (status != http::Status::ok)
+            closed = true;
+    }
+
+    if (status != http::Status::ok)
+    {
+        if (on_error)
+            on_error(Errors::ConnectionFailed{status, CORE_FROM_HERE()});
+        return;
+    }
+
+    reconnect_later();
+}
+
+void http::impl::curl::EventSource::on_failed(const core::net::Error& error)
+{
+    {
+        std::lock_guard<std::recursive_mutex> lg(guard);
+
+        if (closed)
+            return;
+    }
+
+    if (on_error)
+        on_error(error);
+
+    reconnect_later();
+}
+
+void http::impl::curl::EventSource::reconnect_later()
+{
+    std::chrono::milliseconds delay;
+    {
+        std::lock_guard<std::recursive_mutex> lg(guard);
+        delay = stream.reconnection_time();
+    }
+
+    std::weak_ptr<EventSource> weak{shared_from_this()};
+    multi.dispatch_after(delay, [weak]()
+    {
+        if (auto sp = weak.lock())
+            sp->connect();
+    });
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_EVENT_SOURCE_H_
+#define CORE_NET_HTTP_IMPL_CURL_EVENT_SOURCE_H_
+
+#include <core/net/http/event_source.h>
+#include <core/net/http/event_stream.h>
+#include <core/net/http/streaming_request.h>
+
+#include "multi.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace curl
+{
+// Keeps a GET request for a text/event-stream resource going, issuing a
+// new one on the reactor of multi whenever the previous one finishes.
+class EventSource : public core::net::http::EventSource,
+                    public std::enable_shared_from_this<EventSource>
+{
+public:
+    // Function type creating a request for the given configuration.
+    typedef std::function<std::shared_ptr<core::net::http::StreamingRequest>(
+            const core::net::http::Request::Configuration&)> RequestFactory;
+
+    // Creates a new instance and issues the first request.
+    static std::shared_ptr<EventSource> open(
+            ::curl::multi::Handle multi,
+            const core::net::http::Request::Configuration& configuration,
+            const RequestFactory& factory,
+            const core::net::http::EventStream::Handler& on_event,
+            const core::net::http::Request::ErrorHandler& on_error);
+
+    ~EventSource();
+
+    // From core::net::http::EventSource
+    void close() override;
+    std::string last_event_id() const override;
+
+private:
+    EventSource(::curl::multi::Handle multi,
+                const core::net::http::Request::Configuration& configuration,
+                const RequestFactory& factory,
+                const core::net::http::EventStream::Handler& on_event,
+                const core::net::http::Request::ErrorHandler& on_error);
+
+    // Issues a request, asking for the events following the last one received.
+    void connect();
+    // Feeds a chunk of the body to the event stream.
+    void on_chunk(const std::string& chunk);
+    // Reconnects after the server closed the stream, or gives up for statuses other than 200.
+    void on_finished(core::net::http::Status status);
+    // Reports error and reconnects.
+    void on_failed(const core::net::Error& error);
+    // Schedules connect() once the reconnection time has passed.
+    void reconnect_later();
+
+    ::curl::multi::Handle multi;
+    core::net::http::Request::Configuration configuration;
+    RequestFactory factory;
+    core::net::http::Request::ErrorHandler on_error;
+
+    // Guards closed, the event stream and the request in flight. Recursive, as handlers
+    // invoked while holding it might call close() or last_event_id(). Updates to closed
+    // happen under the lock, reading it without is fine for the progress handler only.
+    mutable std::recursive_mutex guard;
+    std::atomic<bool> closed;
+    core::net::http::EventStream stream;
+    std::shared_ptr<core::net::http::StreamingRequest> request;
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_EVENT_SOURCE_H_
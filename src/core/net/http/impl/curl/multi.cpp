@@ -19,26 +19,24 @@
 #include "multi.h"
 
 #include "easy.h"
+#include "endpoint_recorder.h"
+#include "reactor_monitor.h"
+#include "timing_recorder.h"
+#include "tracer.h"
+#include "transfer_counters.h"
 
 #include <boost/asio.hpp>
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/posix/stream_descriptor.hpp>
 
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/variance.hpp>
-
+#include <algorithm>
 #include <condition_variable>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <mutex>
 
-namespace acc = boost::accumulators;
-
 namespace easy = ::curl::easy;
 namespace multi = ::curl::multi;
 
@@ -211,47 +209,35 @@ struct multi::Handle::Private
         std::shared_ptr<Private> d;
     };
 
-    typedef acc::accumulator_set<
-        double,
-        acc::stats<
-            acc::tag::min,
-            acc::tag::max,
-            acc::tag::mean,
-            acc::tag::variance
-        >
-    > Accumulator;
-
-    static void fill_from_accumulator(core::net::http::Client::Timings::Statistics& stats,
-                                      const multi::Handle::Private::Accumulator& accu)
-    {
-        typedef core::net::http::Client::Timings::Seconds Seconds;
-        stats.max = Seconds{acc::max(accu)};
-        stats.min = Seconds{acc::min(accu)};
-        stats.mean = Seconds{acc::mean(accu)};
-        stats.variance = Seconds{acc::variance(accu)};
-    }
-
     Private();
     ~Private();
 
-    void update_timings(const easy::Handle::Timings& timings);
+    // Records timings and metrics of a completed transfer.
+    void account_for(easy::Handle easy, curl::Code code);
+
+    // Arms the probe measuring the lag of the event loop.
+    void probe(const std::shared_ptr<Private>& self);
 
     multi::native::Handle handle;
     boost::asio::io_service dispatcher;
     boost::asio::io_service::work keep_alive;
-    std::mutex guard;
+    // Recursive, as handlers of finished transfers run with guard held and may start new
+    // transfers on the reactor. That only works for completion handlers, which run after
+    // curl_multi_socket_action returned: callbacks invoked from within it, i.e., data,
+    // header, read and progress callbacks, get CURLM_RECURSIVE_API_CALL from curl instead.
+    std::recursive_mutex guard;
     SynchronizedHandleStore handle_store;
     Timeout timeout;
 
-    struct
-    {
-        Accumulator for_name_look_up{};
-        Accumulator for_connect{};
-        Accumulator for_app_connect{};
-        Accumulator for_pre_transfer{};
-        Accumulator for_start_transfer{};
-        Accumulator for_total{};
-    } accumulator;
+    ReactorMonitor reactor_monitor;
+    std::chrono::milliseconds probe_interval{0};
+    std::once_flag probing;
+    boost::asio::deadline_timer probe_timer;
+
+    TransferCounters transfer_counters;
+    TimingRecorder timing_recorder;
+    std::unique_ptr<EndpointRecorder> endpoint_recorder;
+    std::shared_ptr<Tracer> tracer;
 
     struct Holder
     {
@@ -273,20 +259,84 @@ multi::Handle::Handle() : d(new Private())
 
 core::net::http::Client::Timings multi::Handle::timings()
 {
-    core::net::http::Client::Timings result;
+    return d->timing_recorder.collect(false);
+}
+
+core::net::http::Client::Timings multi::Handle::reset_timings()
+{
+    return d->timing_recorder.collect(true);
+}
+
+void multi::Handle::track_endpoints(std::size_t capacity)
+{
+    d->endpoint_recorder.reset(new EndpointRecorder(capacity));
+}
+
+std::vector<core::net::http::Client::EndpointMetrics> multi::Handle::endpoint_metrics()
+{
+    if (not d->endpoint_recorder)
+        return std::vector<core::net::http::Client::EndpointMetrics>{};
+
+    return d->endpoint_recorder->collect();
+}
+
+void multi::Handle::monitor_reactor(const std::chrono::milliseconds& probe_interval,
+                                    const std::chrono::microseconds& threshold,
+                                    const std::function<void(const core::net::http::Client::SlowCallback&)>& on_slow_callback)
+{
+    d->probe_interval = probe_interval;
+    d->reactor_monitor.report_slow_callbacks(threshold, on_slow_callback);
+}
+
+core::net::http::Client::ReactorStatistics multi::Handle::reactor_statistics()
+{
+    return d->reactor_monitor.collect();
+}
+
+void multi::Handle::account_for_callback(easy::Handle easy,
+                                         core::net::http::Client::SlowCallback::Kind kind,
+                                         const std::chrono::steady_clock::duration& duration)
+{
+    d->reactor_monitor.callback(easy, kind, duration);
+}
+
+void multi::Handle::account_for_callbacks(const std::chrono::steady_clock::duration& duration)
+{
+    d->reactor_monitor.transfer(duration);
+}
+
+void multi::Handle::trace(const std::shared_ptr<core::net::http::Client::Observer>& observer, bool chunks)
+{
+    d->tracer = std::make_shared<Tracer>(observer, chunks);
+}
+
+std::shared_ptr<multi::Tracer> multi::Handle::tracer() const
+{
+    return d->tracer;
+}
 
-    Private::fill_from_accumulator(result.name_look_up, d->accumulator.for_name_look_up);
-    Private::fill_from_accumulator(result.connect, d->accumulator.for_connect);
-    Private::fill_from_accumulator(result.app_connect, d->accumulator.for_app_connect);
-    Private::fill_from_accumulator(result.pre_transfer, d->accumulator.for_pre_transfer);
-    Private::fill_from_accumulator(result.start_transfer, d->accumulator.for_start_transfer);
-    Private::fill_from_accumulator(result.total, d->accumulator.for_total);
+core::net::http::Client::TransferStatistics multi::Handle::transfer_statistics()
+{
+    return d->transfer_counters.collect();
+}
 
-    return result;
+void multi::Handle::perform(easy::Handle easy)
+{
+    auto thiz = d;
+
+    d->transfer_counters.started();
+    easy.perform([thiz, easy](curl::Code code) { thiz->account_for(easy, code); });
 }
 
 void multi::Handle::run()
 {
+    // The probe only makes sense once the event loop is running.
+    if (d->probe_interval.count() > 0)
+    {
+        auto context = d;
+        std::call_once(d->probing, [context]() { context->probe(context); });
+    }
+
     d->dispatcher.run();
 }
 
@@ -297,18 +347,42 @@ void multi::Handle::stop()
 
 void multi::Handle::dispatch(const std::function<void ()> &task)
 {
-    d->dispatcher.post(task);
+    // Queued tasks never outlive the dispatcher and thus the monitor.
+    auto monitor = &d->reactor_monitor;
+
+    monitor->queued();
+    d->dispatcher.post([monitor, task]()
+    {
+        monitor->dequeued();
+        task();
+    });
+}
+
+void multi::Handle::dispatch_after(const std::chrono::milliseconds& delay, const std::function<void()>& task)
+{
+    // The timer keeps itself alive until it fired or the dispatcher goes away.
+    auto timer = std::make_shared<boost::asio::deadline_timer>(d->dispatcher);
+    // Longer delays would overflow the microseconds boost counts in, and roughly 24.8 days are as good as never.
+    auto count = std::min<std::chrono::milliseconds::rep>(delay.count(), std::numeric_limits<std::int32_t>::max());
+    timer->expires_from_now(boost::posix_time::milliseconds{count});
+    timer->async_wait([timer, task](const boost::system::error_code& ec)
+    {
+        if (not ec)
+            task();
+    });
 }
 
 void multi::Handle::add(easy::Handle easy)
 {
-    std::lock_guard<std::mutex> lg(d->guard);
+    std::lock_guard<std::recursive_mutex> lg(d->guard);
 
     d->handle_store.add(easy);
     multi::throw_if_not<multi::Code::ok>(
                 multi::native::add_handle(
                     native(),
                     easy.native()));
+
+    d->transfer_counters.started();
 }
 
 void multi::Handle::remove(easy::Handle easy)
@@ -350,7 +424,7 @@ void multi::Handle::Private::process_multi_info()
             {
                 auto easy = handle_store.lookup_native(native_easy);
 
-                update_timings(easy.timings());
+                account_for(easy, rc);
 
                 easy.notify_finished(rc);
                 handle_store.remove(easy);
@@ -387,7 +461,9 @@ void multi::Handle::Private::Timeout::Private::cancel()
 
 void multi::Handle::Private::Timeout::Private::async_wait_for(const std::weak_ptr<Handle::Private>& context, const std::chrono::milliseconds& ms)
 {
-    if (ms.count() > 0)
+    // A timeout of 0 is handled on the dispatcher, too, as curl does not
+    // allow for calling back into the multi handle from within the callback.
+    if (ms.count() >= 0)
     {
         std::weak_ptr<Private> self{shared_from_this()};
         timer.expires_from_now(boost::posix_time::milliseconds{ms.count()});
@@ -400,18 +476,11 @@ void multi::Handle::Private::Timeout::Private::async_wait_for(const std::weak_pt
             {
                 if (auto sp = self.lock())
                 {
-                    std::lock_guard<std::mutex> lg(spc->guard);
+                    std::lock_guard<std::recursive_mutex> lg(spc->guard);
                     sp->handle_timeout(spc);
                 }
             }
         });
-    } else if (ms.count() == 0)
-    {
-        auto sp = context.lock();
-        if (not sp)
-            return;
-
-        handle_timeout(sp);
     }
 }
 
@@ -428,9 +497,6 @@ int multi::Handle::Private::timer_callback(
         long timeout_ms,
         void* cookie)
 {
-    if (timeout_ms < 0)
-        return -1;
-
     auto holder = static_cast<Private::Holder*>(cookie);
 
     if (!holder)
@@ -438,7 +504,12 @@ int multi::Handle::Private::timer_callback(
 
     auto thiz = holder->value.lock();
 
-    thiz->timeout.async_wait_for(thiz, std::chrono::milliseconds{timeout_ms});
+    // A negative timeout asks us to delete the timer. Returning -1 in
+    // that case would make recent versions of curl abort all transfers.
+    if (timeout_ms < 0)
+        thiz->timeout.cancel();
+    else
+        thiz->timeout.async_wait_for(thiz, std::chrono::milliseconds{timeout_ms});
 
     return 0;
 }
@@ -497,7 +568,7 @@ void multi::Handle::Private::Socket::Socket::Private::async_wait_for_readable(co
 
             if (auto spc = context.lock())
             {
-                std::lock_guard<std::mutex> lg(spc->guard);
+                std::lock_guard<std::recursive_mutex> lg(spc->guard);
 
                 int bitmask{0};
 
@@ -537,7 +608,7 @@ void multi::Handle::Private::Socket::Socket::Private::async_wait_for_writeable(
 
             if (auto spc = context.lock())
             {
-                std::lock_guard<std::mutex> lg(spc->guard);
+                std::lock_guard<std::recursive_mutex> lg(spc->guard);
 
                 int bitmask{0};
 
@@ -581,6 +652,7 @@ int multi::Handle::Private::socket_callback(
     {
         socket = new Socket{thiz->dispatcher, s};
         multi::throw_if_not<multi::Code::ok>(multi::native::assign(thiz->handle, s, socket));
+        thiz->reactor_monitor.socket_opened();
     }
 
     switch (action)
@@ -603,6 +675,7 @@ int multi::Handle::Private::socket_callback(
     {
         multi::native::assign(thiz->handle, s, nullptr);
         delete socket;
+        thiz->reactor_monitor.socket_closed();
         break;
     }
     }
@@ -613,7 +686,8 @@ int multi::Handle::Private::socket_callback(
 multi::Handle::Private::Private()
     : handle(multi::native::init()),
       keep_alive(dispatcher),
-      timeout(dispatcher)
+      timeout(dispatcher),
+      probe_timer(dispatcher)
 {
 }
 
@@ -622,12 +696,32 @@ multi::Handle::Private::~Private()
     multi::native::cleanup(handle);
 }
 
-void multi::Handle::Private::update_timings(const easy::Handle::Timings& timings)
+void multi::Handle::Private::probe(const std::shared_ptr<Private>& self)
+{
+    std::weak_ptr<Private> context{self};
+    auto scheduled = std::chrono::steady_clock::now() + probe_interval;
+
+    probe_timer.expires_from_now(boost::posix_time::milliseconds{probe_interval.count()});
+    probe_timer.async_wait([context, scheduled](const boost::system::error_code& ec)
+    {
+        if (ec)
+            return;
+
+        if (auto spc = context.lock())
+        {
+            spc->reactor_monitor.probed(std::chrono::steady_clock::now() - scheduled);
+            spc->probe(spc);
+        }
+    });
+}
+
+void multi::Handle::Private::account_for(easy::Handle easy, curl::Code code)
 {
-    accumulator.for_name_look_up(timings.name_look_up.count());
-    accumulator.for_connect(timings.connect.count());
-    accumulator.for_app_connect(timings.app_connect.count());
-    accumulator.for_pre_transfer(timings.pre_transfer.count());
-    accumulator.for_start_transfer(timings.start_transfer.count());
-    accumulator.for_total(timings.total.count());
+    auto transfer = Transfer::of(easy, code);
+
+    transfer_counters.finished(easy, transfer);
+    timing_recorder.record(transfer.timings);
+
+    if (endpoint_recorder)
+        endpoint_recorder->record(easy, transfer);
 }
@@ -130,6 +130,8 @@ std::pair<Message, int> read_info(Handle);
 std::pair<Code, int> socket_action(Handle handle, Socket socket, int events);
 }
 
+class Tracer;
+
 // Wrapper class for a native curl multi handle.
 class Handle
 {
@@ -140,6 +142,49 @@ public:
     // Queries statistics about the timing information of the last transfers.
     core::net::http::Client::Timings timings();
 
+    // Queries statistics like timings() and starts over with empty statistics.
+    core::net::http::Client::Timings reset_timings();
+
+    // Starts breaking down metrics by endpoint, tracking at most capacity
+    // endpoints. Has to be called prior to carrying out any transfers.
+    void track_endpoints(std::size_t capacity);
+
+    // Queries metrics broken down by endpoint, empty unless tracking endpoints.
+    std::vector<core::net::http::Client::EndpointMetrics> endpoint_metrics();
+
+    // Starts reporting the steps that requests pass to observer. Has to
+    // be called prior to creating any requests.
+    void trace(const std::shared_ptr<core::net::http::Client::Observer>& observer, bool chunks);
+
+    // Returns the tracer requests report to, nullptr unless tracing.
+    std::shared_ptr<Tracer> tracer() const;
+
+    // Queries counters over all transfers carried out so far.
+    core::net::http::Client::TransferStatistics transfer_statistics();
+
+    // Starts probing the lag of the event loop every probe_interval once running, and
+    // reports user callbacks taking longer than threshold to on_slow_callback. Either
+    // is disabled if 0. Has to be called prior to carrying out any transfers.
+    void monitor_reactor(const std::chrono::milliseconds& probe_interval,
+                         const std::chrono::microseconds& threshold,
+                         const std::function<void(const core::net::http::Client::SlowCallback&)>& on_slow_callback);
+
+    // Queries statistics about the health of the reactor.
+    core::net::http::Client::ReactorStatistics reactor_statistics();
+
+    // Accounts for a user callback of kind invoked on the reactor for the transfer of easy.
+    void account_for_callback(curl::easy::Handle easy,
+                              core::net::http::Client::SlowCallback::Kind kind,
+                              const std::chrono::steady_clock::duration& duration);
+
+    // Accounts for the time spent in all user callbacks invoked on the reactor for a single transfer.
+    void account_for_callbacks(const std::chrono::steady_clock::duration& duration);
+
+    // Carries out the transfer of easy synchronously on the calling thread,
+    // accounting for it like for transfers added to this instance.
+    // Throws std::runtime_error in case of issues.
+    void perform(curl::easy::Handle easy);
+
     // Executes the underlying dispatcher executing the curl multi instance.
     // Can be called multiple times for thread-pool use-cases.
     void run();
@@ -150,6 +195,8 @@ public:
 
     // Adds and schedules a new curl easy handle for execution.
     // Throws std::system_error in case of issues.
+    // Safe to call from handlers of finished transfers on the reactor, but
+    // not from data, header, read or progress callbacks of a transfer.
     void add(curl::easy::Handle easy);
 
     // Removes a previously added curl easy handle.
@@ -174,6 +221,9 @@ public:
     // Dispatch dispatches task on the underlying reactor.
     void dispatch(const std::function<void()>& task);
 
+    // Dispatches task on the underlying reactor once delay has passed.
+    void dispatch_after(const std::chrono::milliseconds& delay, const std::function<void()>& task);
+
 private:
     struct Private;
     std::shared_ptr<Private> d;
@@ -0,0 +1,139 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "offloaded_request.h"
+
+#include "../strand.h"
+
+#include <core/net/error.h>
+#include <core/net/http/response.h>
+
+namespace http = core::net::http;
+
+http::impl::curl::OffloadedRequest::OffloadedRequest(const std::shared_ptr<StreamingRequest>& request,
+                                                     const std::shared_ptr<core::net::Executor>& executor,
+                                                     bool chunks)
+    : request(request),
+      executor(executor),
+      chunks(chunks)
+{
+}
+
+http::Request::State http::impl::curl::OffloadedRequest::state()
+{
+    return request->state();
+}
+
+void http::impl::curl::OffloadedRequest::set_timeout(const std::chrono::milliseconds& timeout)
+{
+    request->set_timeout(timeout);
+}
+
+http::Response http::impl::curl::OffloadedRequest::execute(const http::Request::ProgressHandler& ph)
+{
+    // StreamingRequest hides the overload, dispatch through the base class.
+    return static_cast<http::Request&>(*request).execute(ph);
+}
+
+http::Response http::impl::curl::OffloadedRequest::execute(const http::Request::ProgressHandler& ph,
+                                                           const http::StreamingRequest::DataHandler& dh)
+{
+    return request->execute(ph, dh);
+}
+
+void http::impl::curl::OffloadedRequest::async_execute(const http::Request::Handler& handler)
+{
+    offload(handler, nullptr);
+}
+
+void http::impl::curl::OffloadedRequest::async_execute(const http::Request::Handler& handler,
+                                                       const http::StreamingRequest::DataHandler& dh)
+{
+    offload(handler, &dh);
+}
+
+std::string http::impl::curl::OffloadedRequest::url_escape(const std::string& s)
+{
+    return request->url_escape(s);
+}
+
+std::string http::impl::curl::OffloadedRequest::url_unescape(const std::string& s)
+{
+    return request->url_unescape(s);
+}
+
+void http::impl::curl::OffloadedRequest::pause()
+{
+    request->pause();
+}
+
+void http::impl::curl::OffloadedRequest::resume()
+{
+    request->resume();
+}
+
+void http::impl::curl::OffloadedRequest::abort_request_if(std::uint64_t limit, const std::chrono::seconds& time)
+{
+    request->abort_request_if(limit, time);
+}
+
+void http::impl::curl::OffloadedRequest::offload(const http::Request::Handler& handler,
+                                                 const http::StreamingRequest::DataHandler* dh)
+{
+    auto strand = std::make_shared<http::impl::Strand>(executor);
+
+    http::Request::Handler wrapped;
+    wrapped.on_progress(handler.on_progress());
+
+    if (handler.on_response())
+    {
+        auto on_response = handler.on_response();
+        wrapped.on_response([strand, on_response](const http::Response& response)
+        {
+            strand->post([on_response, response]() { on_response(response); });
+        });
+    }
+
+    if (handler.on_error())
+    {
+        auto on_error = handler.on_error();
+        wrapped.on_error([strand, on_error](const core::net::Error& e)
+        {
+            core::net::Error error{e};
+            strand->post([on_error, error]() { on_error(error); });
+        });
+    }
+
+    if (not dh)
+    {
+        static_cast<http::Request&>(*request).async_execute(wrapped);
+        return;
+    }
+
+    if (not chunks)
+    {
+        request->async_execute(wrapped, *dh);
+        return;
+    }
+
+    auto on_chunk = *dh;
+    request->async_execute(wrapped, [strand, on_chunk](const std::string& chunk)
+    {
+        strand->post([on_chunk, chunk]() { on_chunk(chunk); });
+    });
+}
@@ -0,0 +1,77 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_OFFLOADED_REQUEST_H_
+#define CORE_NET_HTTP_IMPL_CURL_OFFLOADED_REQUEST_H_
+
+#include <core/net/executor.h>
+#include <core/net/http/streaming_request.h>
+
+#include <memory>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+namespace curl
+{
+// Delivers the response or error of an asynchronous request, and optionally its
+// chunks, on an executor instead of the reactor, such that the reactor carries on
+// with network I/O while user callbacks run. Callbacks of a single execution are
+// delivered in order via a strand. Progress handlers stay on the reactor as their
+// result steers the transfer, and synchronous execution is not affected at all.
+class OffloadedRequest : public core::net::http::StreamingRequest
+{
+public:
+    // Creates a new instance offloading callbacks of request to executor,
+    // including chunks of the body if chunks is true.
+    OffloadedRequest(const std::shared_ptr<StreamingRequest>& request,
+                     const std::shared_ptr<core::net::Executor>& executor,
+                     bool chunks);
+
+    // From core::net::http::StreamingRequest
+    State state() override;
+    void set_timeout(const std::chrono::milliseconds& timeout) override;
+    Response execute(const Request::ProgressHandler& ph) override;
+    Response execute(const Request::ProgressHandler& ph, const StreamingRequest::DataHandler& dh) override;
+    void async_execute(const Request::Handler& handler) override;
+    void async_execute(const Request::Handler& handler, const StreamingRequest::DataHandler& dh) override;
+    std::string url_escape(const std::string& s) override;
+    std::string url_unescape(const std::string& s) override;
+    void pause() override;
+    void resume() override;
+    void abort_request_if(std::uint64_t limit, const std::chrono::seconds& time) override;
+
+private:
+    // Wraps up the callbacks of handler, and dh if given, to run on a strand of their own.
+    void offload(const Request::Handler& handler, const StreamingRequest::DataHandler* dh);
+
+    std::shared_ptr<StreamingRequest> request;
+    std::shared_ptr<core::net::Executor> executor;
+    bool chunks;
+};
+}
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_OFFLOADED_REQUEST_H_
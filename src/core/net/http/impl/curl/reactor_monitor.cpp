@@ -0,0 +1,92 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "reactor_monitor.h"
+
+namespace http = core::net::http;
+namespace multi = curl::multi;
+
+void multi::ReactorMonitor::report_slow_callbacks(const std::chrono::microseconds& threshold, const SlowCallbackHook& hook)
+{
+    this->threshold = std::chrono::duration_cast<Duration>(threshold);
+    this->hook = hook;
+}
+
+void multi::ReactorMonitor::probed(const Duration& lag)
+{
+    loop_lag.record(lag);
+}
+
+void multi::ReactorMonitor::queued()
+{
+    queued_tasks.fetch_add(1, std::memory_order_relaxed);
+    dispatched_tasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void multi::ReactorMonitor::dequeued()
+{
+    queued_tasks.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void multi::ReactorMonitor::socket_opened()
+{
+    active_sockets.fetch_add(1, std::memory_order_relaxed);
+}
+
+void multi::ReactorMonitor::socket_closed()
+{
+    active_sockets.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void multi::ReactorMonitor::callback(easy::Handle easy, http::Client::SlowCallback::Kind kind, const Duration& duration)
+{
+    if (threshold == Duration::zero() || duration <= threshold)
+        return;
+
+    slow_callbacks.fetch_add(1, std::memory_order_relaxed);
+
+    if (not hook)
+        return;
+
+    http::Client::SlowCallback report;
+    report.kind = kind;
+    report.duration = duration;
+    report.uri = easy.effective_url();
+
+    hook(report);
+}
+
+void multi::ReactorMonitor::transfer(const Duration& callbacks)
+{
+    this->callbacks.record(callbacks);
+}
+
+http::Client::ReactorStatistics multi::ReactorMonitor::collect()
+{
+    http::Client::ReactorStatistics result;
+
+    loop_lag.collect(result.loop_lag, false);
+    callbacks.collect(result.callbacks, false);
+
+    result.slow_callbacks = slow_callbacks.load(std::memory_order_relaxed);
+    result.queued_tasks = queued_tasks.load(std::memory_order_relaxed);
+    result.dispatched_tasks = dispatched_tasks.load(std::memory_order_relaxed);
+    result.active_sockets = active_sockets.load(std::memory_order_relaxed);
+
+    return result;
+}
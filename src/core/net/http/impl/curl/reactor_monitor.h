@@ -0,0 +1,89 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_REACTOR_MONITOR_H_
+#define CORE_NET_HTTP_IMPL_CURL_REACTOR_MONITOR_H_
+
+#include <core/net/http/client.h>
+
+#include "../concurrent_histogram.h"
+
+#include "easy.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+namespace curl
+{
+namespace multi
+{
+// Keeps track of the health of the reactor executing a multi handle: how far
+// the event loop lags behind, how long user callbacks block it and how busy it
+// is. Recording never locks, apart from the hook reporting slow callbacks.
+class ReactorMonitor
+{
+public:
+    typedef std::chrono::steady_clock::duration Duration;
+    typedef std::function<void(const core::net::http::Client::SlowCallback&)> SlowCallbackHook;
+
+    ReactorMonitor() = default;
+
+    ReactorMonitor(const ReactorMonitor&) = delete;
+    ReactorMonitor& operator=(const ReactorMonitor&) = delete;
+
+    // Reports callbacks taking longer than threshold to hook, disabled if threshold is 0.
+    // Has to be called prior to recording any callbacks.
+    void report_slow_callbacks(const std::chrono::microseconds& threshold, const SlowCallbackHook& hook);
+
+    // Accounts for a probe that fired lag behind its schedule.
+    void probed(const Duration& lag);
+
+    // Accounts for a task that has been queued for execution on the reactor.
+    void queued();
+    // Accounts for a queued task that is about to be executed.
+    void dequeued();
+
+    // Accounts for a socket that the reactor started to watch.
+    void socket_opened();
+    // Accounts for a socket that the reactor stopped watching.
+    void socket_closed();
+
+    // Accounts for a user callback of kind invoked for the transfer of easy, which took duration.
+    void callback(easy::Handle easy, core::net::http::Client::SlowCallback::Kind kind, const Duration& duration);
+
+    // Accounts for the time spent in all user callbacks invoked for a single transfer.
+    void transfer(const Duration& callbacks);
+
+    // Returns the statistics recorded so far.
+    core::net::http::Client::ReactorStatistics collect();
+
+private:
+    Duration threshold{Duration::zero()};
+    SlowCallbackHook hook;
+
+    core::net::http::impl::ConcurrentHistogram loop_lag;
+    core::net::http::impl::ConcurrentHistogram callbacks;
+    std::atomic<std::uint64_t> slow_callbacks{0};
+    std::atomic<std::uint64_t> queued_tasks{0};
+    std::atomic<std::uint64_t> dispatched_tasks{0};
+    std::atomic<std::uint64_t> active_sockets{0};
+};
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_REACTOR_MONITOR_H_
@@ -21,16 +21,18 @@
 
 #include <core/net/http/streaming_request.h>
 
+#include <core/net/percent_encoding.h>
 #include <core/net/http/error.h>
 #include <core/net/http/response.h>
 
 #include "client.h"
 #include "curl.h"
+#include "tracer.h"
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <iostream>
-#include <regex>
 #include <sstream>
 
 namespace core
@@ -39,30 +41,111 @@ namespace net
 {
 namespace http
 {
-// A regex for parsing key,value pairs from an http header line.
-std::regex header_line{"\\s*(\\S*)\\s*:\\s*(\\S*)\\s*"};
 namespace impl
 {
 namespace curl
 {
 
 // See http://www.w3.org/Protocols/rfc2616/rfc2616-sec4.html
-std::tuple<std::string, std::string> parse_header_line(const char* line, std::size_t size)
+// Values are kept as is, apart from leading and trailing whitespace, and
+// may contain spaces, e.g., dates or lists of cache directives.
+inline std::tuple<std::string, std::string> parse_header_line(const char* line, std::size_t size)
 {
-    std::cmatch matches;
+    static constexpr const char* whitespace{" \t\r\n"};
 
-    if (not std::regex_match(line, line + size, matches, http::header_line))
+    std::string s{line, size};
+
+    auto colon = s.find(':');
+    if (colon == std::string::npos)
+        return std::make_tuple(std::string{}, std::string{});
+
+    auto key_begin = s.find_first_not_of(whitespace);
+    auto key_end = s.find_last_not_of(whitespace, colon - 1);
+
+    // Status lines and continuation lines do not carry a field name.
+    if (key_begin >= colon || key_end == std::string::npos || key_end < key_begin)
+        return std::make_tuple(std::string{}, std::string{});
+
+    auto key = s.substr(key_begin, key_end - key_begin + 1);
+    if (key.find_first_of(whitespace) != std::string::npos)
         return std::make_tuple(std::string{}, std::string{});
 
-    return std::make_tuple(matches.str(1), matches.str(2));
+    auto value_begin = s.find_first_not_of(whitespace, colon + 1);
+    if (value_begin == std::string::npos)
+        return std::make_tuple(key, std::string{});
+
+    auto value_end = s.find_last_not_of(whitespace);
+    return std::make_tuple(key, s.substr(value_begin, value_end - value_begin + 1));
 }
 
-std::tuple<std::string, std::string, std::size_t> handle_header_line(void* data, std::size_t size, std::size_t nmemb)
+inline std::tuple<std::string, std::string, std::size_t> handle_header_line(void* data, std::size_t size, std::size_t nmemb)
 {
     std::size_t length = size * nmemb;
     return std::tuple_cat(parse_header_line(static_cast<const char*>(data), length), std::make_tuple(length));
 }
 
+// Returns the version of HTTP reported by curl in textual form.
+inline std::string http_version_of(long version)
+{
+    switch (version)
+    {
+    case CURL_HTTP_VERSION_1_0: return "1.0";
+    case CURL_HTTP_VERSION_1_1: return "1.1";
+    case CURL_HTTP_VERSION_2_0: return "2";
+#if LIBCURL_VERSION_NUM >= 0x074200
+    case CURL_HTTP_VERSION_3: return "3";
+#endif
+    }
+
+    return std::string{};
+}
+
+// Describes the transfer last carried out by easy.
+inline core::net::http::Response::Transfer transfer_of(::curl::easy::Handle easy)
+{
+    core::net::http::Response::Transfer result;
+
+    auto timings = easy.timings();
+    result.name_look_up = timings.name_look_up;
+    result.connect = timings.connect;
+    result.app_connect = timings.app_connect;
+    result.pre_transfer = timings.pre_transfer;
+    result.start_transfer = timings.start_transfer;
+    result.total = timings.total;
+
+    long status{0}, connects{0}, redirects{0}, version{0}, local_port{0}, remote_port{0};
+    double redirect_time{0};
+    char* local_ip{nullptr};
+    char* remote_ip{nullptr};
+
+    easy.get_option(::curl::Info::response_code, &status);
+    easy.get_option(::curl::Info::num_connects, &connects);
+    easy.get_option(::curl::Info::redirect_count, &redirects);
+    easy.get_option(::curl::Info::redirect_time, &redirect_time);
+    easy.get_option(::curl::Info::http_version, &version);
+    easy.get_option(::curl::Info::local_ip, &local_ip);
+    easy.get_option(::curl::Info::local_port, &local_port);
+    easy.get_option(::curl::Info::primary_ip, &remote_ip);
+    easy.get_option(::curl::Info::primary_port, &remote_port);
+
+    result.redirect = core::net::http::Response::Transfer::Seconds{redirect_time};
+    result.redirects = redirects;
+    result.connects = connects;
+    // A transfer that did not open a connection but got a response went over a kept-alive one.
+    result.reused = connects == 0 && status != 0;
+    result.http_version = http_version_of(version);
+
+    if (local_ip)
+        result.local.address = local_ip;
+    result.local.port = local_port;
+
+    if (remote_ip)
+        result.remote.address = remote_ip;
+    result.remote.port = remote_port;
+
+    return result;
+}
+
 // Make sure that we switch the state back to idle whenever an instance
 // of StateGuard goes out of scope.
 struct StateGuard
@@ -96,8 +179,15 @@ public:
             ::curl::easy::Handle easy)
         : atomic_state(core::net::http::Request::State::ready),
           multi(multi),
-          easy(easy)
+          easy(easy),
+          tracer(multi.tracer())
     {
+        if (tracer)
+        {
+            id = tracer->next_request();
+            handle = ::curl::multi::Tracer::id_of(easy);
+            trace(TraceKind::created);
+        }
     }
 
     State state()
@@ -117,6 +207,25 @@ public:
         easy.set_option(::curl::Option::timeout_ms, adjusted_timeout);
     }
 
+    // Makes a State::ready request hand its body to the DataHandler only, instead of
+    // accumulating it in Response::body, e.g., for long-lived streams.
+    void discard_body()
+    {
+        if (atomic_state.load() != core::net::http::Request::State::ready)
+            throw core::net::http::Request::Errors::AlreadyActive{CORE_FROM_HERE()};
+
+        retains_body = false;
+    }
+
+    // Adds the given fields to the header of a State::ready request.
+    void add_header(const Header& header)
+    {
+        if (atomic_state.load() != core::net::http::Request::State::ready)
+            throw core::net::http::Request::Errors::AlreadyActive{CORE_FROM_HERE()};
+
+        easy.header(header);
+    }
+
     Response execute(const Request::ProgressHandler& ph)
     {
         return execute(ph, [](const std::string&){});
@@ -155,9 +264,11 @@ public:
         easy.on_write_data(
                     [&](char* data, std::size_t size, std::size_t nmemb)
                     {
+                        trace_chunk(size * nmemb);
                         // Report out to the data handler prior to accumulating data.
                         dh(std::string{data, size * nmemb});
-                        context.body.write(data, size * nmemb);
+                        if (retains_body)
+                            context.body.write(data, size * nmemb);
                         return size * nmemb;
                     });
         easy.on_write_header(
@@ -167,6 +278,8 @@ public:
                         static constexpr const std::size_t value_index{1};
                         static constexpr const std::size_t size_index{2};
 
+                        trace_first_byte(context);
+
                         auto kvs = handle_header_line(data, size, nmemb);
 
                         if (not std::get<key_index>(kvs).empty())
@@ -175,16 +288,33 @@ public:
                         return std::get<size_index>(kvs);
                     });
 
+        if (tracer)
+            easy.on_prerequest([&]() { trace_connection(context); });
+
+        trace(TraceKind::queued);
+
         try
         {
-            easy.perform();
+            multi.perform(easy);
         } catch(const std::system_error& se)
         {
+            trace(TraceKind::errored);
+            trace(TraceKind::released);
             throw core::net::http::Error(se.what(), CORE_FROM_HERE());
+        } catch(...)
+        {
+            trace(TraceKind::errored);
+            trace(TraceKind::released);
+            throw;
         }
 
+        trace(TraceKind::completed);
+
         context.result.status = easy.status();
         context.result.body = context.body.str();
+        context.result.transfer = transfer_of(easy);
+
+        trace(TraceKind::released);
 
         return context.result;
     }
@@ -206,28 +336,43 @@ public:
 
         easy.on_finished([thiz, handler, context](::curl::Code code)
         {
+            thiz->trace(code == ::curl::Code::ok ? TraceKind::completed : TraceKind::errored);
+
             if (code == ::curl::Code::ok)
             {
                 context->result.status = thiz->easy.status();
                 context->result.body = context->body.str();
+                context->result.transfer = transfer_of(thiz->easy);
 
                 if (handler.on_response())
-                    handler.on_response()(context->result);
+                {
+                    thiz->timed(*context, Kind::response, [&]()
+                    {
+                        handler.on_response()(context->result);
+                    });
+                }
             } else
             {
                 if (handler.on_error())
                 {
                     std::stringstream ss; ss << code;
-                    handler.on_error()(core::net::http::Error(ss.str(), CORE_FROM_HERE()));
+                    core::net::http::Error error(ss.str(), CORE_FROM_HERE());
+
+                    thiz->timed(*context, Kind::error, [&]()
+                    {
+                        handler.on_error()(error);
+                    });
                 }
             }
 
+            thiz->multi.account_for_callbacks(context->callbacks);
             thiz->easy.release();
+            thiz->trace(TraceKind::released);
         });
 
         if (handler.on_progress())
         {
-            easy.on_progress([handler](void*, double dltotal, double dlnow, double ultotal, double ulnow)
+            easy.on_progress([thiz, handler, context](void*, double dltotal, double dlnow, double ultotal, double ulnow)
             {
                 Request::Progress progress;
                 progress.download.total = dltotal;
@@ -237,31 +382,42 @@ public:
 
                 int result{-1};
 
-                switch(handler.on_progress()(progress))
+                thiz->timed(*context, Kind::progress, [&]()
                 {
-                case Request::Progress::Next::abort_operation: result = 1; break;
-                case Request::Progress::Next::continue_operation: result = 0; break;
-                }
+                    switch(handler.on_progress()(progress))
+                    {
+                    case Request::Progress::Next::abort_operation: result = 1; break;
+                    case Request::Progress::Next::continue_operation: result = 0; break;
+                    }
+                });
+
                 return result;
             });
         }
 
         easy.on_write_data(
-                    [context, dh](char* data, std::size_t size, std::size_t nmemb)
+                    [thiz, context, dh](char* data, std::size_t size, std::size_t nmemb)
                     {
+                        thiz->trace_chunk(size * nmemb);
                         // Report out to the data handler prior to accumulating data.
-                        dh(std::string{data, size * nmemb});
-                        context->body.write(data, size * nmemb);
+                        thiz->timed(*context, Kind::data, [&]()
+                        {
+                            dh(std::string{data, size * nmemb});
+                        });
+                        if (thiz->retains_body)
+                            context->body.write(data, size * nmemb);
                         return size * nmemb;
                     });
 
         easy.on_write_header(
-                    [context](void* data, std::size_t size, std::size_t nmemb)
+                    [thiz, context](void* data, std::size_t size, std::size_t nmemb)
                     {
                         static constexpr const std::size_t key_index{0};
                         static constexpr const std::size_t value_index{1};
                         static constexpr const std::size_t size_index{2};
 
+                        thiz->trace_first_byte(*context);
+
                         auto kvs = handle_header_line(data, size, nmemb);
 
                         if (not std::get<key_index>(kvs).empty())
@@ -270,17 +426,22 @@ public:
                         return std::get<size_index>(kvs);
                     });
 
+        if (tracer)
+            easy.on_prerequest([thiz, context]() { thiz->trace_connection(*context); });
+
+        trace(TraceKind::queued);
+
         multi.add(easy);
     }
 
     std::string url_escape(const std::string& s)
     {
-        return easy.escape(s);
+        return core::net::percent_encoding::encode(s);
     }
 
     std::string url_unescape(const std::string& s)
     {
-        return easy.unescape(s);
+        return core::net::percent_encoding::decode(s);
     }
 
     void pause()
@@ -319,15 +480,77 @@ public:
     }
 
 private:
-    std::atomic<core::net::http::Request::State> atomic_state;
-    ::curl::multi::Handle multi;
-    ::curl::easy::Handle easy;
+    typedef core::net::http::Client::SlowCallback::Kind Kind;
+    typedef core::net::http::Client::TraceEvent::Kind TraceKind;
 
     struct Context
     {
         Response result;
         std::stringstream body;
+        // Time spent in user callbacks on the reactor.
+        std::chrono::steady_clock::duration callbacks{std::chrono::steady_clock::duration::zero()};
+        // Whether the setup of the connection and the first byte have been traced.
+        bool connection_traced{false};
+        bool first_byte_traced{false};
     };
+
+    // Reports passing a step to the observer, if tracing.
+    void trace(TraceKind kind, std::size_t size = 0)
+    {
+        if (tracer)
+            tracer->trace(kind, id, handle, std::chrono::steady_clock::now(), size);
+    }
+
+    // Reports the setup of the connection once per execution, if tracing.
+    void trace_connection(Context& context)
+    {
+        if (not tracer || context.connection_traced)
+            return;
+
+        context.connection_traced = true;
+        tracer->trace_connection(id, easy);
+    }
+
+    // Reports the first byte of the response, preceded by the setup of the connection
+    // for versions of curl that do not tell about the connection being ready.
+    void trace_first_byte(Context& context)
+    {
+        if (not tracer || context.first_byte_traced)
+            return;
+
+        trace_connection(context);
+
+        context.first_byte_traced = true;
+        trace(TraceKind::first_byte);
+    }
+
+    // Reports an arriving chunk, if tracing chunks.
+    void trace_chunk(std::size_t size)
+    {
+        if (tracer && tracer->traces_chunks())
+            trace(TraceKind::chunk, size);
+    }
+
+    // Invokes callback on the reactor, accounting for the time it blocks the reactor.
+    template<typename Callback>
+    void timed(Context& context, Kind kind, const Callback& callback)
+    {
+        auto start = std::chrono::steady_clock::now();
+        callback();
+        auto duration = std::chrono::steady_clock::now() - start;
+
+        context.callbacks += duration;
+        multi.account_for_callback(easy, kind, duration);
+    }
+
+    std::atomic<core::net::http::Request::State> atomic_state;
+    ::curl::multi::Handle multi;
+    ::curl::easy::Handle easy;
+    bool retains_body{true};
+
+    std::shared_ptr<::curl::multi::Tracer> tracer;
+    std::uint64_t id{0};
+    std::uint64_t handle{0};
 };
 }
 }
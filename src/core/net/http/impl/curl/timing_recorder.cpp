@@ -0,0 +1,123 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "timing_recorder.h"
+
+namespace http = core::net::http;
+namespace multi = curl::multi;
+
+namespace
+{
+// Returns a small number identifying the calling thread, handed out in order of first use.
+std::size_t this_thread_index()
+{
+    static std::atomic<std::size_t> next{0};
+    static thread_local std::size_t index{next.fetch_add(1, std::memory_order_relaxed)};
+
+    return index;
+}
+
+// Fills in the summary of stats from its histogram.
+void summarize_statistics(http::Client::Timings::Statistics& stats)
+{
+    stats.max = stats.histogram.max();
+    stats.min = stats.histogram.min();
+    stats.mean = stats.histogram.mean();
+    stats.variance = stats.histogram.variance();
+}
+}
+
+void multi::TimingHistograms::record(const easy::Handle::Timings& timings)
+{
+    name_look_up.record(timings.name_look_up);
+    connect.record(timings.connect);
+    app_connect.record(timings.app_connect);
+    pre_transfer.record(timings.pre_transfer);
+    start_transfer.record(timings.start_transfer);
+    total.record(timings.total);
+}
+
+void multi::TimingHistograms::collect(http::Client::Timings& timings, bool reset)
+{
+    name_look_up.collect(timings.name_look_up.histogram, reset);
+    connect.collect(timings.connect.histogram, reset);
+    app_connect.collect(timings.app_connect.histogram, reset);
+    pre_transfer.collect(timings.pre_transfer.histogram, reset);
+    start_transfer.collect(timings.start_transfer.histogram, reset);
+    total.collect(timings.total.histogram, reset);
+}
+
+void multi::summarize(http::Client::Timings& timings)
+{
+    summarize_statistics(timings.name_look_up);
+    summarize_statistics(timings.connect);
+    summarize_statistics(timings.app_connect);
+    summarize_statistics(timings.pre_transfer);
+    summarize_statistics(timings.start_transfer);
+    summarize_statistics(timings.total);
+}
+
+multi::TimingRecorder::TimingRecorder()
+{
+    for (auto& shard : shards)
+        shard.store(nullptr);
+}
+
+multi::TimingRecorder::~TimingRecorder()
+{
+    for (auto& shard : shards)
+        delete shard.load();
+}
+
+void multi::TimingRecorder::record(const easy::Handle::Timings& timings)
+{
+    shard_for_this_thread().record(timings);
+}
+
+http::Client::Timings multi::TimingRecorder::collect(bool reset)
+{
+    http::Client::Timings result;
+
+    for (auto& slot : shards)
+    {
+        auto shard = slot.load(std::memory_order_acquire);
+
+        if (shard)
+            shard->collect(result, reset);
+    }
+
+    summarize(result);
+    return result;
+}
+
+multi::TimingRecorder::Shard& multi::TimingRecorder::shard_for_this_thread()
+{
+    auto& slot = shards[this_thread_index() % shards.size()];
+    auto shard = slot.load(std::memory_order_acquire);
+
+    if (shard)
+        return *shard;
+
+    // Another thread mapping to the same slot might race us, the loser hands over.
+    std::unique_ptr<Shard> candidate{new Shard()};
+
+    if (slot.compare_exchange_strong(shard, candidate.get(), std::memory_order_acq_rel))
+        return *candidate.release();
+
+    return *shard;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_TIMING_RECORDER_H_
+#define CORE_NET_HTTP_IMPL_CURL_TIMING_RECORDER_H_
+
+#include <core/net/http/client.h>
+
+#include "../concurrent_histogram.h"
+
+#include "easy.h"
+
+#include <array>
+#include <atomic>
+
+namespace curl
+{
+namespace multi
+{
+// Histograms for all phases of transfers, recorded to and collected from without locking.
+struct TimingHistograms
+{
+    // Records the timings of a single transfer.
+    void record(const easy::Handle::Timings& timings);
+
+    // Adds the timings recorded so far to timings, and drops them if reset is true.
+    // The summaries of timings are not touched, see summarize.
+    void collect(core::net::http::Client::Timings& timings, bool reset);
+
+    core::net::http::impl::ConcurrentHistogram name_look_up;
+    core::net::http::impl::ConcurrentHistogram connect;
+    core::net::http::impl::ConcurrentHistogram app_connect;
+    core::net::http::impl::ConcurrentHistogram pre_transfer;
+    core::net::http::impl::ConcurrentHistogram start_transfer;
+    core::net::http::impl::ConcurrentHistogram total;
+};
+
+// Fills in the summaries of all phases of timings from their histograms.
+void summarize(core::net::http::Client::Timings& timings);
+
+// Records the timings of completed transfers from any number of reactor threads,
+// and hands them out to any number of monitoring threads, without ever locking.
+// Threads record to one of a fixed number of shards, such that they rarely contend
+// on the same cache lines. Shards are only set up once a thread records to them.
+class TimingRecorder
+{
+public:
+    TimingRecorder();
+    ~TimingRecorder();
+
+    TimingRecorder(const TimingRecorder&) = delete;
+    TimingRecorder& operator=(const TimingRecorder&) = delete;
+
+    // Records the timings of a single transfer.
+    void record(const easy::Handle::Timings& timings);
+
+    // Returns the timings merged from all shards, and drops them if reset is true.
+    core::net::http::Client::Timings collect(bool reset);
+
+private:
+    typedef TimingHistograms Shard;
+
+    // Returns the shard of the calling thread, setting it up if necessary.
+    Shard& shard_for_this_thread();
+
+    std::array<std::atomic<Shard*>, 8> shards;
+};
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_TIMING_RECORDER_H_
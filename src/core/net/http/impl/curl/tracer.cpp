@@ -0,0 +1,98 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "tracer.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace multi = curl::multi;
+
+namespace
+{
+typedef std::chrono::duration<double> Seconds;
+}
+
+multi::Tracer::Tracer(const std::shared_ptr<core::net::http::Client::Observer>& observer, bool chunks)
+    : observer(observer),
+      chunks(chunks)
+{
+}
+
+bool multi::Tracer::traces_chunks() const
+{
+    return chunks;
+}
+
+std::uint64_t multi::Tracer::next_request()
+{
+    return requests.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+std::uint64_t multi::Tracer::id_of(easy::Handle easy)
+{
+    return reinterpret_cast<std::uintptr_t>(easy.native());
+}
+
+void multi::Tracer::trace(Kind kind, std::uint64_t request, std::uint64_t handle, const TimePoint& when, std::size_t size)
+{
+    core::net::http::Client::TraceEvent event;
+    event.kind = kind;
+    event.when = when;
+    event.request = request;
+    event.handle = handle;
+    event.size = size;
+
+    observer->on_event(event);
+}
+
+void multi::Tracer::trace_connection(std::uint64_t request, easy::Handle easy)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    long connects{0};
+    double name_look_up{0}, connect{0}, app_connect{0};
+
+    easy.get_option(curl::Info::num_connects, &connects);
+
+    if (connects == 0)
+        return;
+
+    easy.get_option(curl::Info::namelookup_time, &name_look_up);
+    easy.get_option(curl::Info::connect_time, &connect);
+    easy.get_option(curl::Info::appconnect_time, &app_connect);
+
+    // curl measures relative to the start of the transfer, which we
+    // infer from the connection having become ready just now.
+    auto ready = std::max(connect, app_connect);
+    auto start = now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(Seconds{ready});
+
+    auto at = [start](double offset)
+    {
+        return start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(Seconds{offset});
+    };
+
+    auto handle = id_of(easy);
+
+    trace(Kind::name_look_up_started, request, handle, start);
+    trace(Kind::name_look_up_finished, request, handle, at(name_look_up));
+    trace(Kind::connected, request, handle, at(connect));
+
+    if (app_connect > 0)
+        trace(Kind::tls_established, request, handle, at(app_connect));
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_TRACER_H_
+#define CORE_NET_HTTP_IMPL_CURL_TRACER_H_
+
+#include <core/net/http/client.h>
+
+#include "easy.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace curl
+{
+namespace multi
+{
+// Hands the steps that requests pass to an observer. Only ever created if
+// an observer is configured, such that requests are not traced otherwise.
+class Tracer
+{
+public:
+    typedef core::net::http::Client::TraceEvent::Kind Kind;
+    typedef std::chrono::steady_clock::time_point TimePoint;
+
+    Tracer(const std::shared_ptr<core::net::http::Client::Observer>& observer, bool chunks);
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    // Returns true if arriving chunks should be reported.
+    bool traces_chunks() const;
+
+    // Returns a new id identifying a request.
+    std::uint64_t next_request();
+
+    // Returns the id identifying the handle easy.
+    static std::uint64_t id_of(easy::Handle easy);
+
+    // Reports that request, carried out by handle, passed a step of kind at when.
+    void trace(Kind kind, std::uint64_t request, std::uint64_t handle, const TimePoint& when, std::size_t size = 0);
+
+    // Reports the steps of setting up the connection used by easy for request, which
+    // has just become ready. Does not report anything for kept-alive connections.
+    void trace_connection(std::uint64_t request, easy::Handle easy);
+
+private:
+    std::shared_ptr<core::net::http::Client::Observer> observer;
+    bool chunks;
+    std::atomic<std::uint64_t> requests{0};
+};
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_TRACER_H_
@@ -0,0 +1,144 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "transfer_counters.h"
+
+#include "endpoint_recorder.h"
+
+namespace http = core::net::http;
+namespace multi = curl::multi;
+
+namespace
+{
+// Mirrors the default of CURLOPT_DNS_CACHE_TIMEOUT, which we never adjust.
+constexpr const std::chrono::seconds dns_cache_timeout{60};
+
+// Expired hosts are dropped once the model of the DNS cache grows beyond this size.
+constexpr const std::size_t dns_cache_pruning_threshold{1024};
+
+// Returns the host and port of url.
+std::string host_of(const std::string& url)
+{
+    auto origin = multi::origin_of(url);
+    auto scheme_end = origin.find("://");
+
+    return scheme_end == std::string::npos ? origin : origin.substr(scheme_end + 3);
+}
+}
+
+multi::Transfer multi::Transfer::of(easy::Handle easy, curl::Code code)
+{
+    Transfer result;
+    result.code = code;
+
+    long request_size{0}, header_size{0};
+    curl_off_t size_upload{0}, size_download{0};
+
+    easy.get_option(Info::response_code, &result.status);
+    easy.get_option(Info::num_connects, &result.connects);
+    easy.get_option(Info::request_size, &request_size);
+    easy.get_option(Info::header_size, &header_size);
+    easy.get_option(Info::size_upload, &size_upload);
+    easy.get_option(Info::size_download, &size_download);
+
+    result.bytes_sent = request_size + size_upload;
+    result.bytes_received = header_size + size_download;
+    result.timings = easy.timings();
+
+    return result;
+}
+
+multi::TransferCounters::TransferCounters()
+{
+    for (auto& counter : errors)
+        counter.store(0, std::memory_order_relaxed);
+}
+
+void multi::TransferCounters::started()
+{
+    in_flight.fetch_add(1, std::memory_order_relaxed);
+}
+
+void multi::TransferCounters::finished(easy::Handle easy, const Transfer& transfer)
+{
+    in_flight.fetch_sub(1, std::memory_order_relaxed);
+    completed.fetch_add(1, std::memory_order_relaxed);
+
+    if (transfer.connects > 0)
+    {
+        connections_opened.fetch_add(transfer.connects, std::memory_order_relaxed);
+
+        if (resolved_from_cache(host_of(easy.effective_url()), std::chrono::steady_clock::now()))
+            dns_cache_hits.fetch_add(1, std::memory_order_relaxed);
+    } else if (transfer.status != 0)
+    {
+        connections_reused.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (transfer.code != curl::Code::ok)
+    {
+        auto index = static_cast<std::size_t>(transfer.code);
+
+        if (index < errors.size())
+            errors[index].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bytes_sent.fetch_add(transfer.bytes_sent, std::memory_order_relaxed);
+    bytes_received.fetch_add(transfer.bytes_received, std::memory_order_relaxed);
+}
+
+http::Client::TransferStatistics multi::TransferCounters::collect()
+{
+    http::Client::TransferStatistics result;
+
+    result.in_flight = in_flight.load(std::memory_order_relaxed);
+    result.completed = completed.load(std::memory_order_relaxed);
+    result.connections_opened = connections_opened.load(std::memory_order_relaxed);
+    result.connections_reused = connections_reused.load(std::memory_order_relaxed);
+    result.dns_cache_hits = dns_cache_hits.load(std::memory_order_relaxed);
+    result.bytes_sent = bytes_sent.load(std::memory_order_relaxed);
+    result.bytes_received = bytes_received.load(std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < errors.size(); i++)
+        if (auto count = errors[i].load(std::memory_order_relaxed))
+            result.errors[i] = count;
+
+    if (auto used = result.connections_opened + result.connections_reused)
+        result.connection_reuse_ratio = static_cast<double>(result.connections_reused) / used;
+
+    return result;
+}
+
+bool multi::TransferCounters::resolved_from_cache(const std::string& host, const std::chrono::steady_clock::time_point& now)
+{
+    std::lock_guard<std::mutex> lg(guard);
+
+    auto it = resolved.find(host);
+    if (it != resolved.end() && now - it->second < dns_cache_timeout)
+        return true;
+
+    if (resolved.size() >= dns_cache_pruning_threshold)
+    {
+        for (auto jt = resolved.begin(); jt != resolved.end();)
+            jt = now - jt->second < dns_cache_timeout ? std::next(jt) : resolved.erase(jt);
+    }
+
+    // curl resolves the host and caches the result, it does not refresh entries on hits.
+    resolved[host] = now;
+    return false;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_CURL_TRANSFER_COUNTERS_H_
+#define CORE_NET_HTTP_IMPL_CURL_TRANSFER_COUNTERS_H_
+
+#include <core/net/http/client.h>
+
+#include "easy.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace curl
+{
+namespace multi
+{
+// Summarizes a finished transfer. Queried from the easy handle once,
+// and shared by everything accounting for the transfer.
+struct Transfer
+{
+    // Queries the summary of the transfer carried out by easy, which finished with code.
+    // Throws std::runtime_error in case of issues.
+    static Transfer of(easy::Handle easy, curl::Code code);
+
+    curl::Code code{curl::Code::ok};
+    // 0 if the transfer did not yield a response.
+    long status{0};
+    // Number of connections opened to carry out the transfer.
+    long connects{0};
+    std::uint64_t bytes_sent{0};
+    std::uint64_t bytes_received{0};
+    easy::Handle::Timings timings;
+};
+
+// Counts transfers, their connections and their errors. Counting is lock-free,
+// apart from connections being opened, which consult a model of curl's DNS cache.
+class TransferCounters
+{
+public:
+    TransferCounters();
+
+    TransferCounters(const TransferCounters&) = delete;
+    TransferCounters& operator=(const TransferCounters&) = delete;
+
+    // Accounts for a transfer that has been started.
+    void started();
+
+    // Accounts for a started transfer that finished, carried out by easy.
+    void finished(easy::Handle easy, const Transfer& transfer);
+
+    // Returns the counters accumulated so far.
+    core::net::http::Client::TransferStatistics collect();
+
+private:
+    // Returns true if curl finds host in its DNS cache when opening a connection at now.
+    bool resolved_from_cache(const std::string& host, const std::chrono::steady_clock::time_point& now);
+
+    std::atomic<std::uint64_t> in_flight{0};
+    std::atomic<std::uint64_t> completed{0};
+    std::atomic<std::uint64_t> connections_opened{0};
+    std::atomic<std::uint64_t> connections_reused{0};
+    std::atomic<std::uint64_t> dns_cache_hits{0};
+    std::atomic<std::uint64_t> bytes_sent{0};
+    std::atomic<std::uint64_t> bytes_received{0};
+    // Indexed by CURLcode.
+    std::array<std::atomic<std::uint64_t>, CURL_LAST> errors;
+
+    // Point in time a host was last resolved at, by host and port.
+    std::mutex guard;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> resolved;
+};
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_CURL_TRANSFER_COUNTERS_H_
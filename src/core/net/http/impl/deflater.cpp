@@ -0,0 +1,205 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "deflater.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace http = core::net::http;
+
+namespace
+{
+// Size of the staging buffer used for data handed out by a Source.
+constexpr const std::size_t staging_buffer_size{64 * 1024};
+
+// zlib adds a gzip wrapper to the stream if 16 is added to the window bits.
+constexpr const int gzip_window_bits{15 + 16};
+// A plain zlib wrapper, which is what HTTP calls deflate.
+constexpr const int zlib_window_bits{15};
+// Default memory level as documented in zlib.h.
+constexpr const int default_memory_level{8};
+
+int window_bits_for(http::Request::Compression compression)
+{
+    switch (compression)
+    {
+    case http::Request::Compression::gzip: return gzip_window_bits;
+    case http::Request::Compression::deflate: return zlib_window_bits;
+    case http::Request::Compression::none: break;
+    }
+
+    throw std::logic_error("Cannot deflate a request body without compression.");
+}
+}
+
+struct http::impl::Deflater::Private
+{
+    Private(http::Request::Compression compression)
+        : finished(false)
+    {
+        stream.zalloc = Z_NULL;
+        stream.zfree = Z_NULL;
+        stream.opaque = Z_NULL;
+        stream.next_in = Z_NULL;
+        stream.avail_in = 0;
+
+        if (deflateInit2(&stream,
+                         Z_DEFAULT_COMPRESSION,
+                         Z_DEFLATED,
+                         window_bits_for(compression),
+                         default_memory_level,
+                         Z_DEFAULT_STRATEGY) != Z_OK)
+            throw std::runtime_error("Could not initialize zlib stream.");
+    }
+
+    ~Private()
+    {
+        deflateEnd(&stream);
+    }
+
+    // Hands the next slice of uncompressed data to zlib, returns false if
+    // no more input is available.
+    bool refill()
+    {
+        if (buffer)
+        {
+            auto remaining = buffer->size() - offset;
+            auto chunk = std::min<std::size_t>(remaining, std::numeric_limits<uInt>::max());
+
+            // zlib promises to not touch the input, it just lacks the const qualifier.
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(buffer->data() + offset));
+            stream.avail_in = chunk;
+            offset += chunk;
+
+            return chunk > 0;
+        }
+
+        auto chunk = source(staging.data(), staging.size());
+
+        if (chunk == Deflater::would_block)
+        {
+            blocked = true;
+            return true;
+        }
+
+        stream.next_in = reinterpret_cast<Bytef*>(staging.data());
+        stream.avail_in = chunk;
+
+        return chunk > 0;
+    }
+
+    z_stream stream;
+    bool finished;
+    bool input_exhausted{false};
+    // Set while the source has no data available, until
+    // everything compressed so far has been flushed out.
+    bool blocked{false};
+
+    std::shared_ptr<const std::string> buffer;
+    std::size_t offset{0};
+
+    Deflater::Source source;
+    std::vector<char> staging;
+};
+
+constexpr const std::size_t http::impl::Deflater::would_block;
+
+const char* http::impl::Deflater::content_encoding(http::Request::Compression compression)
+{
+    switch (compression)
+    {
+    case http::Request::Compression::gzip: return "gzip";
+    case http::Request::Compression::deflate: return "deflate";
+    case http::Request::Compression::none: break;
+    }
+
+    throw std::logic_error("A request body without compression has no content-coding.");
+}
+
+http::impl::Deflater::Deflater(http::Request::Compression compression, const std::shared_ptr<const std::string>& buffer)
+    : d(new Private(compression))
+{
+    d->buffer = buffer;
+}
+
+http::impl::Deflater::Deflater(http::Request::Compression compression, const Deflater::Source& source)
+    : d(new Private(compression))
+{
+    d->source = source;
+    d->staging.resize(staging_buffer_size);
+}
+
+http::impl::Deflater::~Deflater()
+{
+}
+
+std::size_t http::impl::Deflater::read(void* dest, std::size_t size)
+{
+    if (d->finished)
+        return 0;
+
+    d->stream.next_out = static_cast<Bytef*>(dest);
+    d->stream.avail_out = std::min<std::size_t>(size, std::numeric_limits<uInt>::max());
+
+    auto available = d->stream.avail_out;
+
+    // Keep going until we either filled up the output buffer or reached
+    // the end of the stream. Returning 0 early would signal EOF to the consumer.
+    while (d->stream.avail_out > 0 && not d->finished)
+    {
+        if (d->stream.avail_in == 0 && not d->input_exhausted && not d->blocked)
+            d->input_exhausted = not d->refill();
+
+        // While waiting for the source, we hand out whatever zlib holds back
+        // such that the receiver sees all data produced so far.
+        auto flush = d->input_exhausted ? Z_FINISH : (d->blocked ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+        auto rc = deflate(&d->stream, flush);
+
+        switch (rc)
+        {
+        case Z_STREAM_END:
+            d->finished = true;
+            break;
+        case Z_OK:
+        case Z_BUF_ERROR:
+            break;
+        default:
+            throw std::runtime_error("Could not compress request body.");
+        }
+
+        if (d->blocked && d->stream.avail_out > 0)
+            break;
+    }
+
+    auto written = available - d->stream.avail_out;
+
+    // The flush is complete, the next read asks the source again.
+    if (d->blocked && d->stream.avail_out > 0)
+    {
+        d->blocked = false;
+        if (written == 0)
+            return would_block;
+    }
+
+    return written;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_DEFLATER_H_
+#define CORE_NET_HTTP_IMPL_DEFLATER_H_
+
+#include <core/net/http/request.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+// Compresses a request body on the fly, pulling uncompressed data
+// from its source whenever the consumer asks for more output.
+class Deflater
+{
+public:
+    // Function type that fills up dest with at most size bytes of uncompressed
+    // data, returning the number of bytes written, 0 at the end of the data or
+    // would_block if no data is available right now.
+    typedef std::function<std::size_t(char* dest, std::size_t size)> Source;
+
+    // Returned by sources without data at hand and by read() once everything
+    // compressed so far has been flushed out while waiting for the source.
+    static constexpr const std::size_t would_block = static_cast<std::size_t>(-1);
+
+    // Returns the value of the Content-Encoding header matching compression.
+    // Throws std::logic_error for http::Request::Compression::none.
+    static const char* content_encoding(http::Request::Compression compression);
+
+    // Compresses the given buffer without copying it.
+    Deflater(http::Request::Compression compression, const std::shared_ptr<const std::string>& buffer);
+
+    // Compresses whatever the given source hands out.
+    Deflater(http::Request::Compression compression, const Source& source);
+
+    Deflater(const Deflater&) = delete;
+    ~Deflater();
+
+    Deflater& operator=(const Deflater&) = delete;
+
+    // Writes at most size bytes of compressed data to dest and returns the
+    // number of bytes written. Only returns 0 once the stream is complete and
+    // would_block if the source has no data available and nothing is pending.
+    // Throws std::runtime_error in case of issues.
+    std::size_t read(void* dest, std::size_t size);
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_DEFLATER_H_
@@ -0,0 +1,43 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "form.h"
+
+#include <core/net/percent_encoding.h>
+
+namespace http = core::net::http;
+namespace pe = core::net::percent_encoding;
+
+std::string http::impl::form_body_for(const std::map<std::string, std::string>& values)
+{
+    std::string body;
+    bool first{true};
+
+    for (const auto& pair : values)
+    {
+        if (not first)
+            body.push_back('&');
+
+        pe::encode(pair.first.data(), pair.first.size(), body, pe::Component::form);
+        body.push_back('=');
+        pe::encode(pair.second.data(), pair.second.size(), body, pe::Component::form);
+        first = false;
+    }
+
+    return body;
+}
@@ -0,0 +1,307 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "open_metrics.h"
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <ostream>
+#include <string>
+
+namespace http = core::net::http;
+
+namespace
+{
+// Bucket bounds of exposed histograms, in seconds and as rendered.
+struct Bound
+{
+    double seconds;
+    const char* label;
+};
+
+constexpr const std::array<Bound, 18> bounds
+{{
+    {0.0001, "0.0001"}, {0.00025, "0.00025"}, {0.0005, "0.0005"},
+    {0.001, "0.001"}, {0.0025, "0.0025"}, {0.005, "0.005"},
+    {0.01, "0.01"}, {0.025, "0.025"}, {0.05, "0.05"},
+    {0.1, "0.1"}, {0.25, "0.25"}, {0.5, "0.5"},
+    {1, "1.0"}, {2.5, "2.5"}, {5, "5.0"},
+    {10, "10.0"}, {30, "30.0"}, {60, "60.0"}
+}};
+
+// Precision of durations, enough for microseconds on transfers taking hours.
+constexpr const std::streamsize precision{12};
+
+struct Label
+{
+    const char* name;
+    const char* value;
+};
+
+typedef std::initializer_list<Label> Labels;
+
+// Writes metric families and their samples, see
+// https://github.com/OpenObservability/OpenMetrics/blob/main/specification/OpenMetrics.md
+class Writer
+{
+public:
+    Writer(std::ostream& out)
+        : out(out),
+          flags(out.flags()),
+          saved_precision(out.precision())
+    {
+        out.flags(std::ios::dec);
+        out.precision(precision);
+    }
+
+    ~Writer()
+    {
+        out.flags(flags);
+        out.precision(saved_precision);
+    }
+
+    // Starts a family of the given type, unit is either empty or the suffix of name.
+    void family(const char* name, const char* type, const char* help, const char* unit = "")
+    {
+        out << "# TYPE " << name << ' ' << type << '\n';
+        if (*unit)
+            out << "# UNIT " << name << ' ' << unit << '\n';
+        out << "# HELP " << name << ' ' << help << '\n';
+    }
+
+    void counter(const char* name, const Labels& labels, std::uint64_t value)
+    {
+        sample(name, "_total", labels);
+        out << ' ' << value << '\n';
+    }
+
+    void gauge(const char* name, const Labels& labels, std::uint64_t value)
+    {
+        sample(name, "", labels);
+        out << ' ' << value << '\n';
+    }
+
+    void gauge(const char* name, const Labels& labels, double value)
+    {
+        sample(name, "", labels);
+        out << ' ' << value << '\n';
+    }
+
+    // Writes cumulative buckets, count and sum. Durations are counted in the smallest
+    // bound not below the upper bound of the bucket they were recorded in.
+    void histogram(const char* name, const Labels& labels, const http::Histogram& histogram)
+    {
+        std::array<std::uint64_t, bounds.size()> counts;
+        counts.fill(0);
+
+        histogram.enumerate([&counts](const http::Histogram::Seconds& upper_bound, std::uint64_t count)
+        {
+            auto it = std::lower_bound(bounds.begin(), bounds.end(), upper_bound.count(), [](const Bound& bound, double seconds)
+            {
+                return bound.seconds < seconds;
+            });
+
+            if (it != bounds.end())
+                counts[it - bounds.begin()] += count;
+        });
+
+        std::uint64_t cumulative{0};
+
+        for (std::size_t i = 0; i < bounds.size(); i++)
+        {
+            cumulative += counts[i];
+            sample(name, "_bucket", labels, Label{"le", bounds[i].label});
+            out << ' ' << cumulative << '\n';
+        }
+
+        sample(name, "_bucket", labels, Label{"le", "+Inf"});
+        out << ' ' << histogram.count() << '\n';
+        sample(name, "_count", labels);
+        out << ' ' << histogram.count() << '\n';
+        sample(name, "_sum", labels);
+        out << ' ' << histogram.sum().count() << '\n';
+    }
+
+    void finish()
+    {
+        out << "# EOF\n";
+    }
+
+private:
+    void sample(const char* name, const char* suffix, const Labels& labels, const Label& extra = Label{nullptr, nullptr})
+    {
+        out << name << suffix;
+
+        if (labels.size() == 0 && not extra.name)
+            return;
+
+        char separator = '{';
+
+        for (const auto& label : labels)
+        {
+            out << separator;
+            write(label);
+            separator = ',';
+        }
+
+        if (extra.name)
+        {
+            out << separator;
+            write(extra);
+        }
+
+        out << '}';
+    }
+
+    // Writes label, escaping its value.
+    void write(const Label& label)
+    {
+        out << label.name << "=\"";
+
+        for (auto c = label.value; *c; c++)
+        {
+            switch (*c)
+            {
+            case '\\': out << "\\\\"; break;
+            case '"': out << "\\\""; break;
+            case '\n': out << "\\n"; break;
+            default: out << *c; break;
+            }
+        }
+
+        out << '"';
+    }
+
+    std::ostream& out;
+    std::ios::fmtflags flags;
+    std::streamsize saved_precision;
+};
+
+void write_phases(Writer& writer, const http::Client::Timings& timings)
+{
+    static constexpr const char* name{"net_cpp_transfer_phase_seconds"};
+
+    writer.family(name, "histogram", "Time from the start of transfers until the end of a phase.", "seconds");
+    writer.histogram(name, {{"phase", "name_look_up"}}, timings.name_look_up.histogram);
+    writer.histogram(name, {{"phase", "connect"}}, timings.connect.histogram);
+    writer.histogram(name, {{"phase", "app_connect"}}, timings.app_connect.histogram);
+    writer.histogram(name, {{"phase", "pre_transfer"}}, timings.pre_transfer.histogram);
+    writer.histogram(name, {{"phase", "start_transfer"}}, timings.start_transfer.histogram);
+    writer.histogram(name, {{"phase", "total"}}, timings.total.histogram);
+}
+
+void write_endpoints(Writer& writer, const std::vector<http::Client::EndpointMetrics>& endpoints)
+{
+    writer.family("net_cpp_endpoint_requests", "counter", "Completed requests by endpoint, including failed ones.");
+    for (const auto& e : endpoints)
+        writer.counter("net_cpp_endpoint_requests", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}}, e.requests);
+
+    writer.family("net_cpp_endpoint_responses", "counter", "Responses by endpoint and class of status code.");
+    for (const auto& e : endpoints)
+    {
+        writer.counter("net_cpp_endpoint_responses", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}, {"class", "1xx"}}, e.responses.informational);
+        writer.counter("net_cpp_endpoint_responses", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}, {"class", "2xx"}}, e.responses.success);
+        writer.counter("net_cpp_endpoint_responses", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}, {"class", "3xx"}}, e.responses.redirection);
+        writer.counter("net_cpp_endpoint_responses", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}, {"class", "4xx"}}, e.responses.client_error);
+        writer.counter("net_cpp_endpoint_responses", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}, {"class", "5xx"}}, e.responses.server_error);
+    }
+
+    writer.family("net_cpp_endpoint_errors", "counter", "Requests by endpoint that failed without a response, by CURLcode.");
+    for (const auto& e : endpoints)
+        for (const auto& error : e.errors)
+            writer.counter("net_cpp_endpoint_errors", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}, {"code", std::to_string(error.first).c_str()}}, error.second);
+
+    writer.family("net_cpp_endpoint_sent_bytes", "counter", "Bytes sent by endpoint, including request lines and headers.", "bytes");
+    for (const auto& e : endpoints)
+        writer.counter("net_cpp_endpoint_sent_bytes", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}}, e.bytes_sent);
+
+    writer.family("net_cpp_endpoint_received_bytes", "counter", "Bytes received by endpoint, including status lines and headers.", "bytes");
+    for (const auto& e : endpoints)
+        writer.counter("net_cpp_endpoint_received_bytes", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}}, e.bytes_received);
+
+    writer.family("net_cpp_endpoint_duration_seconds", "histogram", "Total time of requests by endpoint.", "seconds");
+    for (const auto& e : endpoints)
+        writer.histogram("net_cpp_endpoint_duration_seconds", {{"origin", e.origin.c_str()}, {"route", e.route.c_str()}}, e.timings.total.histogram);
+}
+}
+
+void http::impl::write_open_metrics(std::ostream& out, const ClientMetrics& metrics)
+{
+    Writer writer{out};
+
+    const auto& transfers = metrics.transfers;
+
+    writer.family("net_cpp_transfers_in_flight", "gauge", "Transfers currently carried out.");
+    writer.gauge("net_cpp_transfers_in_flight", {}, transfers.in_flight);
+    writer.family("net_cpp_transfers", "counter", "Completed transfers, including failed ones.");
+    writer.counter("net_cpp_transfers", {}, transfers.completed);
+    writer.family("net_cpp_connections_opened", "counter", "Connections opened to carry out transfers.");
+    writer.counter("net_cpp_connections_opened", {}, transfers.connections_opened);
+    writer.family("net_cpp_connections_reused", "counter", "Transfers carried out on a connection kept alive.");
+    writer.counter("net_cpp_connections_reused", {}, transfers.connections_reused);
+    writer.family("net_cpp_connection_reuse_ratio", "gauge", "Share of transfers carried out on a kept-alive connection.", "ratio");
+    writer.gauge("net_cpp_connection_reuse_ratio", {}, transfers.connection_reuse_ratio);
+    writer.family("net_cpp_dns_cache_hits", "counter", "Connections opened without resolving the name of the host.");
+    writer.counter("net_cpp_dns_cache_hits", {}, transfers.dns_cache_hits);
+    writer.family("net_cpp_sent_bytes", "counter", "Bytes sent, including request lines and headers.", "bytes");
+    writer.counter("net_cpp_sent_bytes", {}, transfers.bytes_sent);
+    writer.family("net_cpp_received_bytes", "counter", "Bytes received, including status lines and headers.", "bytes");
+    writer.counter("net_cpp_received_bytes", {}, transfers.bytes_received);
+
+    writer.family("net_cpp_transfer_errors", "counter", "Transfers that failed without a response, by CURLcode.");
+    for (const auto& error : transfers.errors)
+        writer.counter("net_cpp_transfer_errors", {{"code", std::to_string(error.first).c_str()}}, error.second);
+
+    const auto& reactor = metrics.reactor;
+
+    writer.family("net_cpp_reactor_loop_lag_seconds", "histogram", "Delay of the probe of the event loop behind its schedule.", "seconds");
+    writer.histogram("net_cpp_reactor_loop_lag_seconds", {}, reactor.loop_lag);
+    writer.family("net_cpp_reactor_callback_seconds", "histogram", "Time spent in user callbacks on the reactor, per transfer.", "seconds");
+    writer.histogram("net_cpp_reactor_callback_seconds", {}, reactor.callbacks);
+    writer.family("net_cpp_reactor_slow_callbacks", "counter", "User callbacks that took longer than the configured threshold.");
+    writer.counter("net_cpp_reactor_slow_callbacks", {}, reactor.slow_callbacks);
+    writer.family("net_cpp_reactor_queued_tasks", "gauge", "Tasks currently queued for execution on the reactor.");
+    writer.gauge("net_cpp_reactor_queued_tasks", {}, reactor.queued_tasks);
+    writer.family("net_cpp_reactor_dispatched_tasks", "counter", "Tasks queued for execution on the reactor.");
+    writer.counter("net_cpp_reactor_dispatched_tasks", {}, reactor.dispatched_tasks);
+    writer.family("net_cpp_reactor_active_sockets", "gauge", "Sockets currently watched by the reactor.");
+    writer.gauge("net_cpp_reactor_active_sockets", {}, reactor.active_sockets);
+
+    const auto& cache = metrics.cache;
+
+    writer.family("net_cpp_cache_hits", "counter", "Requests answered from the cache, including revalidated responses.");
+    writer.counter("net_cpp_cache_hits", {}, cache.hits);
+    writer.family("net_cpp_cache_misses", "counter", "Requests that had to be answered by the origin server.");
+    writer.counter("net_cpp_cache_misses", {}, cache.misses);
+    writer.family("net_cpp_cache_revalidations", "counter", "Stale responses confirmed by the origin server.");
+    writer.counter("net_cpp_cache_revalidations", {}, cache.revalidations);
+    writer.family("net_cpp_cache_evictions", "counter", "Responses evicted from the cache to make room for others.");
+    writer.counter("net_cpp_cache_evictions", {}, cache.evictions);
+    writer.family("net_cpp_cache_entries", "gauge", "Responses currently in the cache.");
+    writer.gauge("net_cpp_cache_entries", {}, static_cast<std::uint64_t>(cache.entries));
+    writer.family("net_cpp_cache_size_bytes", "gauge", "Bytes currently occupied by the cache.", "bytes");
+    writer.gauge("net_cpp_cache_size_bytes", {}, static_cast<std::uint64_t>(cache.size));
+
+    write_phases(writer, metrics.timings);
+
+    if (not metrics.endpoints.empty())
+        write_endpoints(writer, metrics.endpoints);
+
+    writer.finish();
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_OPEN_METRICS_H_
+#define CORE_NET_HTTP_IMPL_OPEN_METRICS_H_
+
+#include <core/net/http/client.h>
+
+#include <iosfwd>
+#include <vector>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+// Snapshot of all metrics of a client, as handed to write_open_metrics.
+struct ClientMetrics
+{
+    http::Client::TransferStatistics transfers;
+    http::Client::ReactorStatistics reactor;
+    http::Client::CacheStatistics cache;
+    http::Client::Timings timings;
+    std::vector<http::Client::EndpointMetrics> endpoints;
+};
+
+// Renders metrics in the OpenMetrics text format, straight to out and
+// without buffering samples. The formatting state of out is restored.
+void write_open_metrics(std::ostream& out, const ClientMetrics& metrics);
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_OPEN_METRICS_H_
@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "strand.h"
+
+namespace http = core::net::http;
+
+namespace
+{
+// Number of tasks run in one go before handing back to the executor.
+constexpr const std::size_t batch_size{16};
+}
+
+http::impl::Strand::Strand(const std::shared_ptr<core::net::Executor>& executor)
+    : executor(executor)
+{
+}
+
+void http::impl::Strand::post(const core::net::Executor::Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lg(guard);
+        tasks.push_back(task);
+
+        if (scheduled)
+            return;
+
+        scheduled = true;
+    }
+
+    auto thiz = shared_from_this();
+    executor->post([thiz]() { thiz->run(); });
+}
+
+void http::impl::Strand::run()
+{
+    for (std::size_t i = 0; i < batch_size; i++)
+    {
+        core::net::Executor::Task task;
+
+        {
+            std::lock_guard<std::mutex> lg(guard);
+
+            if (tasks.empty())
+            {
+                scheduled = false;
+                return;
+            }
+
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+
+        // Tasks are user callbacks, which must not stall the strand when throwing.
+        try
+        {
+            task();
+        } catch (...)
+        {
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(guard);
+
+        if (tasks.empty())
+        {
+            scheduled = false;
+            return;
+        }
+    }
+
+    auto thiz = shared_from_this();
+    executor->post([thiz]() { thiz->run(); });
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_HTTP_IMPL_STRAND_H_
+#define CORE_NET_HTTP_IMPL_STRAND_H_
+
+#include <core/net/executor.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace core
+{
+namespace net
+{
+namespace http
+{
+namespace impl
+{
+// Runs tasks on an executor one after another, in order of submission,
+// never occupying more than one of the threads of the executor at a time.
+class Strand : public std::enable_shared_from_this<Strand>
+{
+public:
+    // Creates a new instance running tasks on executor.
+    Strand(const std::shared_ptr<core::net::Executor>& executor);
+
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+
+    // Schedules task to run after all tasks posted before.
+    void post(const core::net::Executor::Task& task);
+
+private:
+    // Runs a batch of queued tasks, and hands over to the executor
+    // again if more are left, such that other work gets a chance.
+    void run();
+
+    std::shared_ptr<core::net::Executor> executor;
+
+    std::mutex guard;
+    std::deque<core::net::Executor::Task> tasks;
+    bool scheduled{false};
+};
+}
+}
+}
+}
+
+#endif // CORE_NET_HTTP_IMPL_STRAND_H_
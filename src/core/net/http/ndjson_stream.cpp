@@ -0,0 +1,100 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/http/ndjson_stream.h>
+
+#include <cstring>
+
+namespace http = core::net::http;
+
+struct http::NdjsonStream::Private
+{
+    Private(const Handler& handler) : handler(handler)
+    {
+    }
+
+    void feed(const char* p, std::size_t size)
+    {
+        auto end = p + size;
+
+        while (p != end)
+        {
+            auto lf = static_cast<const char*>(std::memchr(p, '\n', end - p));
+
+            if (not lf)
+            {
+                line.append(p, end);
+                return;
+            }
+
+            // Records within a chunk are handed out right where they are.
+            if (line.empty())
+                emit(p, lf - p);
+            else
+            {
+                line.append(p, lf);
+                emit(line.data(), line.size());
+                line.clear();
+            }
+
+            p = lf + 1;
+        }
+    }
+
+    void emit(const char* record, std::size_t size)
+    {
+        if (size > 0 && record[size - 1] == '\r')
+            size--;
+
+        if (size > 0 && handler)
+            handler(record, size);
+    }
+
+    Handler handler;
+    // The beginning of a record continued by the next chunk.
+    std::string line;
+};
+
+http::NdjsonStream::NdjsonStream(const Handler& handler) : d(new Private(handler))
+{
+}
+
+void http::NdjsonStream::feed(const char* data, std::size_t size)
+{
+    d->feed(data, size);
+}
+
+void http::NdjsonStream::feed(const std::string& chunk)
+{
+    d->feed(chunk.data(), chunk.size());
+}
+
+http::StreamingRequest::DataHandler http::NdjsonStream::to_data_handler() const
+{
+    auto d = this->d;
+    return [d](const std::string& chunk)
+    {
+        d->feed(chunk.data(), chunk.size());
+    };
+}
+
+void http::NdjsonStream::finish()
+{
+    d->emit(d->line.data(), d->line.size());
+    d->line.clear();
+}
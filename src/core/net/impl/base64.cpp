@@ -0,0 +1,440 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "base64.h"
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace base64 = core::net::base64;
+namespace impl = core::net::impl::base64;
+
+using core::net::impl::Isa;
+
+namespace
+{
+constexpr const char* standard_symbols{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+constexpr const char* url_safe_symbols{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"};
+
+// Marks bytes outside of an alphabet in Tables::values.
+constexpr const std::uint8_t invalid{0xff};
+constexpr const char padding{'='};
+
+// Everything the kernels need to know about an alphabet, derived from its symbols.
+// Both alphabets of RFC 4648 share the layout A-Z, a-z, 0-9 for the values 0 to 61
+// and only differ in the symbols for 62 and 63.
+struct Tables
+{
+    explicit Tables(const char* s)
+    {
+        std::memcpy(symbols, s, sizeof(symbols));
+        std::memset(values, invalid, sizeof(values));
+        std::memset(valid_high_nibbles, 0, sizeof(valid_high_nibbles));
+        std::memset(shifts, 0, sizeof(shifts));
+
+        bool has_shift[16] = {};
+        odd_symbol = 0;
+        odd_shift = 0;
+
+        for (int value = 0; value < 64; value++)
+        {
+            auto c = static_cast<std::uint8_t>(s[value]);
+            auto shift = static_cast<std::int8_t>(value - c);
+
+            values[c] = value;
+            valid_high_nibbles[c & 0x0f] |= 1 << (c >> 4);
+
+            if (not has_shift[c >> 4])
+            {
+                shifts[c >> 4] = shift;
+                has_shift[c >> 4] = true;
+            } else if (shifts[c >> 4] != shift)
+            {
+                // Only the symbol for 63 ends up here for both alphabets.
+                odd_symbol = static_cast<char>(c);
+                odd_shift = shift;
+            }
+        }
+
+        std::memset(offsets, 0, sizeof(offsets));
+        offsets[0] = s[26] - 26;
+        for (int i = 1; i <= 10; i++)
+            offsets[i] = s[52] - 52;
+        offsets[11] = s[62] - 62;
+        offsets[12] = s[63] - 63;
+        offsets[13] = s[0];
+    }
+
+    char symbols[64];
+    std::uint8_t values[256];
+
+    // The vectorized encoder maps a value to its symbol by adding the offset
+    // for the class of the value: 13 for A-Z, 0 for a-z, 1 to 10 for 0-9 and
+    // 11 and 12 for the remaining two symbols.
+    std::int8_t offsets[16];
+
+    // The vectorized decoder accepts a byte c if bit c >> 4 is set in
+    // valid_high_nibbles[c & 0x0f] and maps it to its value by adding
+    // shifts[c >> 4]. The one symbol not sharing the shift of its high
+    // nibble is patched up separately.
+    std::uint8_t valid_high_nibbles[16];
+    std::int8_t shifts[16];
+    char odd_symbol;
+    std::int8_t odd_shift;
+};
+
+const Tables& tables_for(base64::Alphabet alphabet)
+{
+    static const Tables standard{standard_symbols};
+    static const Tables url_safe{url_safe_symbols};
+
+    switch (alphabet)
+    {
+    case base64::Alphabet::standard: return standard;
+    case base64::Alphabet::url_safe: return url_safe;
+    }
+
+    return standard;
+}
+
+std::size_t encoded_size(std::size_t size, bool padded)
+{
+    auto remainder = size % 3;
+    return size / 3 * 4 + (remainder == 0 ? 0 : (padded ? 4 : remainder + 1));
+}
+
+[[noreturn]] void throw_malformed(const std::string& reason, std::size_t position)
+{
+    std::stringstream ss; ss << reason << " at offset " << position;
+    throw base64::Errors::Malformed(ss.str(), CORE_FROM_HERE());
+}
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+// The vectorized kernels follow the approach described by Wojciech Muła and
+// Daniel Lemire in "Faster Base64 Encoding and Decoding using AVX2 Instructions".
+// They only ever process full blocks, leaving the tail, padding and the reporting
+// of errors to the scalar code.
+
+__attribute__((target("ssse3")))
+inline __m128i sextets_ssse3(__m128i in)
+{
+    // Each 32-bit lane holds the bytes b, a, c, b of a 3-byte group a, b, c.
+    // Shifting the 16-bit halves into place via multiplications leaves us
+    // with the four 6-bit values of the group in the four bytes of the lane.
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    auto hi = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    auto lo = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(hi, lo);
+}
+
+__attribute__((target("ssse3")))
+inline __m128i symbols_ssse3(__m128i values, __m128i offsets)
+{
+    // Classify values into the 14 classes of Tables::offsets.
+    auto classes = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    auto upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), values);
+    classes = _mm_or_si128(classes, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(values, _mm_shuffle_epi8(offsets, classes));
+}
+
+__attribute__((target("ssse3")))
+std::size_t encode_ssse3(const Tables& t, const std::uint8_t* in, std::size_t size, char* out)
+{
+    auto offsets = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.offsets));
+
+    // We consume 12 bytes per iteration, but load 16.
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 12, out += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), symbols_ssse3(sextets_ssse3(block), offsets));
+    }
+
+    return i;
+}
+
+// Returns the values of the 16 symbols in block, or false if any of them is invalid.
+__attribute__((target("ssse3")))
+inline bool values_ssse3(const Tables& t, __m128i block, __m128i& values)
+{
+    auto nibble = _mm_set1_epi8(0x0f);
+    auto hi = _mm_and_si128(_mm_srli_epi32(block, 4), nibble);
+    auto lo = _mm_and_si128(block, nibble);
+
+    // High nibbles of 8 and above are never valid and map to a zero bit.
+    auto bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto valid = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.valid_high_nibbles));
+    auto accepted = _mm_and_si128(_mm_shuffle_epi8(valid, lo), _mm_shuffle_epi8(bits, hi));
+
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(accepted, _mm_setzero_si128())) != 0)
+        return false;
+
+    auto shifts = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.shifts)), hi);
+    auto odd = _mm_cmpeq_epi8(block, _mm_set1_epi8(t.odd_symbol));
+    shifts = _mm_or_si128(_mm_and_si128(odd, _mm_set1_epi8(t.odd_shift)), _mm_andnot_si128(odd, shifts));
+
+    values = _mm_add_epi8(block, shifts);
+    return true;
+}
+
+// Packs the 6-bit values in each 32-bit lane into 3 bytes in its lower 24 bits, big-endian.
+__attribute__((target("ssse3")))
+inline __m128i pack_ssse3(__m128i values)
+{
+    auto pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    auto quads = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(quads, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+__attribute__((target("ssse3")))
+std::size_t decode_ssse3(const Tables& t, const std::uint8_t* in, std::size_t size, std::uint8_t* out)
+{
+    // We consume 16 symbols per iteration, but store 16 bytes instead of 12.
+    // Keeping 8 symbols in reserve guarantees that out has enough room.
+    std::size_t i = 0;
+    for (; i + 24 <= size; i += 16, out += 12)
+    {
+        __m128i values;
+        if (not values_ssse3(t, _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), values))
+            break;
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), pack_ssse3(values));
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t encode_avx2(const Tables& t, const std::uint8_t* in, std::size_t size, char* out)
+{
+    auto offsets = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.offsets)));
+    auto shuffle = _mm256_setr_epi8(
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+
+    // We consume 24 bytes per iteration, loading 12 of them into each lane.
+    std::size_t i = 0;
+    for (; i + 28 <= size; i += 24, out += 32)
+    {
+        auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 12));
+        auto block = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), shuffle);
+
+        auto h = _mm256_mulhi_epu16(_mm256_and_si256(block, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+        auto l = _mm256_mullo_epi16(_mm256_and_si256(block, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+        auto values = _mm256_or_si256(h, l);
+
+        auto classes = _mm256_subs_epu8(values, _mm256_set1_epi8(51));
+        auto upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), values);
+        classes = _mm256_or_si256(classes, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+
+        auto symbols = _mm256_add_epi8(values, _mm256_shuffle_epi8(offsets, classes));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), symbols);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t decode_avx2(const Tables& t, const std::uint8_t* in, std::size_t size, std::uint8_t* out)
+{
+    auto nibble = _mm256_set1_epi8(0x0f);
+    auto bits = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+                1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto valid = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.valid_high_nibbles)));
+    auto shifts = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.shifts)));
+    auto odd_symbol = _mm256_set1_epi8(t.odd_symbol);
+    auto odd_shift = _mm256_set1_epi8(t.odd_shift);
+    auto pack = _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    // We consume 32 symbols per iteration, but store 32 bytes instead of 24.
+    std::size_t i = 0;
+    for (; i + 48 <= size; i += 32, out += 24)
+    {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        auto hi = _mm256_and_si256(_mm256_srli_epi32(block, 4), nibble);
+        auto lo = _mm256_and_si256(block, nibble);
+
+        auto accepted = _mm256_and_si256(_mm256_shuffle_epi8(valid, lo), _mm256_shuffle_epi8(bits, hi));
+        if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(accepted, _mm256_setzero_si256())) != 0)
+            break;
+
+        auto odd = _mm256_cmpeq_epi8(block, odd_symbol);
+        auto shift = _mm256_blendv_epi8(_mm256_shuffle_epi8(shifts, hi), odd_shift, odd);
+        auto values = _mm256_add_epi8(block, shift);
+
+        auto pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        auto quads = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+        auto packed = _mm256_shuffle_epi8(quads, pack);
+
+        // Move the 12 valid bytes of the upper lane next to the ones of the lower lane.
+        packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), packed);
+    }
+
+    return i;
+}
+#endif
+}
+
+void impl::encode(
+        const char* data,
+        std::size_t size,
+        std::string& out,
+        core::net::base64::Alphabet alphabet,
+        bool padded,
+        Isa isa)
+{
+    const auto& t = tables_for(alphabet);
+
+    auto offset = out.size();
+    out.resize(offset + encoded_size(size, padded));
+
+    auto in = reinterpret_cast<const std::uint8_t*>(data);
+    auto o = &out[offset];
+
+    std::size_t consumed = 0;
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+    switch (isa)
+    {
+    case Isa::avx2: consumed = encode_avx2(t, in, size, o); break;
+    case Isa::ssse3: consumed = encode_ssse3(t, in, size, o); break;
+    case Isa::scalar: break;
+    }
+#else
+    (void) isa;
+#endif
+
+    in += consumed; size -= consumed; o += consumed / 3 * 4;
+
+    for (; size >= 3; in += 3, size -= 3, o += 4)
+    {
+        std::uint32_t group = in[0] << 16 | in[1] << 8 | in[2];
+        o[0] = t.symbols[group >> 18];
+        o[1] = t.symbols[(group >> 12) & 0x3f];
+        o[2] = t.symbols[(group >> 6) & 0x3f];
+        o[3] = t.symbols[group & 0x3f];
+    }
+
+    if (size == 0)
+        return;
+
+    std::uint32_t group = in[0] << 16 | (size == 2 ? in[1] << 8 : 0);
+    o[0] = t.symbols[group >> 18];
+    o[1] = t.symbols[(group >> 12) & 0x3f];
+
+    if (size == 2)
+        o[2] = t.symbols[(group >> 6) & 0x3f];
+    else if (padded)
+        o[2] = padding;
+
+    if (padded)
+        o[3] = padding;
+}
+
+void impl::decode(
+        const char* text,
+        std::size_t size,
+        std::string& out,
+        core::net::base64::Alphabet alphabet,
+        Isa isa)
+{
+    const auto& t = tables_for(alphabet);
+
+    // Padding is optional, but if present, it has to complete the final quantum.
+    std::size_t pad = 0;
+    if (size > 0 && text[size - 1] == padding)
+        pad = (size > 1 && text[size - 2] == padding) ? 2 : 1;
+
+    if (pad > 0 && size % 4 != 0)
+        throw_malformed("Padding does not complete a quantum", size - pad);
+
+    auto symbols = size - pad;
+
+    if (symbols % 4 == 1)
+        throw_malformed("Truncated quantum", symbols - 1);
+
+    auto remainder = symbols % 4;
+    auto offset = out.size();
+    out.resize(offset + symbols / 4 * 3 + (remainder == 0 ? 0 : remainder - 1));
+
+    auto in = reinterpret_cast<const std::uint8_t*>(text);
+    auto o = reinterpret_cast<std::uint8_t*>(&out[offset]);
+
+    std::size_t i = 0;
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+    switch (isa)
+    {
+    case Isa::avx2: i = decode_avx2(t, in, symbols, o); break;
+    case Isa::ssse3: i = decode_ssse3(t, in, symbols, o); break;
+    case Isa::scalar: break;
+    }
+#else
+    (void) isa;
+#endif
+
+    o += i / 4 * 3;
+
+    // Returns the value of the symbol at position j, throwing if it is not in the alphabet.
+    auto value_at = [&](std::size_t j) -> std::uint32_t
+    {
+        auto value = t.values[in[j]];
+
+        if (value == invalid)
+        {
+            out.resize(offset);
+            throw_malformed("Invalid symbol", j);
+        }
+
+        return value;
+    };
+
+    for (; i + 4 <= symbols; i += 4, o += 3)
+    {
+        auto group = value_at(i) << 18 | value_at(i + 1) << 12 | value_at(i + 2) << 6 | value_at(i + 3);
+        o[0] = group >> 16;
+        o[1] = group >> 8;
+        o[2] = group;
+    }
+
+    if (remainder == 0)
+        return;
+
+    std::uint32_t group = value_at(i) << 18 | value_at(i + 1) << 12 | (remainder == 3 ? value_at(i + 2) << 6 : 0);
+
+    // Encoders have to zero the bits that do not make it into a full byte.
+    if ((remainder == 2 && (group & 0x00ffff) != 0) || (remainder == 3 && (group & 0x0000ff) != 0))
+    {
+        out.resize(offset);
+        throw_malformed("Non-zero trailing bits", i + remainder - 1);
+    }
+
+    o[0] = group >> 16;
+    if (remainder == 3)
+        o[1] = group >> 8;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_IMPL_BASE64_H_
+#define CORE_NET_IMPL_BASE64_H_
+
+#include <core/net/base64.h>
+
+#include "cpu.h"
+
+#include <cstddef>
+#include <string>
+
+namespace core
+{
+namespace net
+{
+namespace impl
+{
+namespace base64
+{
+// Appends the encoding of size bytes of data to out, using the kernel for isa.
+void encode(
+        const char* data,
+        std::size_t size,
+        std::string& out,
+        core::net::base64::Alphabet alphabet,
+        bool padded,
+        Isa isa);
+
+// Appends the decoding of size bytes of text to out, using the kernel for isa.
+// Throws core::net::base64::Errors::Malformed if text is not valid base64.
+void decode(
+        const char* text,
+        std::size_t size,
+        std::string& out,
+        core::net::base64::Alphabet alphabet,
+        Isa isa);
+}
+}
+}
+}
+
+#endif // CORE_NET_IMPL_BASE64_H_
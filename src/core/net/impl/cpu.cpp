@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "cpu.h"
+
+namespace impl = core::net::impl;
+
+impl::Isa impl::best_supported_isa()
+{
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+    static const Isa isa = []()
+    {
+        // We might end up here from a static initializer, before the
+        // runtime had a chance to query the CPU.
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            return Isa::avx2;
+        if (__builtin_cpu_supports("ssse3"))
+            return Isa::ssse3;
+
+        return Isa::scalar;
+    }();
+
+    return isa;
+#else
+    return Isa::scalar;
+#endif
+}
+
+std::vector<impl::Isa> impl::supported_isas()
+{
+    std::vector<Isa> result{Isa::scalar};
+
+    switch (best_supported_isa())
+    {
+    case Isa::avx2: result.push_back(Isa::ssse3); result.push_back(Isa::avx2); break;
+    case Isa::ssse3: result.push_back(Isa::ssse3); break;
+    case Isa::scalar: break;
+    }
+
+    return result;
+}
+
+const char* impl::name_of(impl::Isa isa)
+{
+    switch (isa)
+    {
+    case Isa::scalar: return "scalar";
+    case Isa::ssse3: return "ssse3";
+    case Isa::avx2: return "avx2";
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_IMPL_CPU_H_
+#define CORE_NET_IMPL_CPU_H_
+
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CORE_NET_HAVE_X86_KERNELS
+#endif
+
+namespace core
+{
+namespace net
+{
+namespace impl
+{
+// The instruction sets we carry vectorized kernels for. Kernels are compiled
+// with per-function target attributes and selected at runtime.
+enum class Isa
+{
+    scalar,
+    ssse3,
+    avx2
+};
+
+// Returns the most capable instruction set supported by the CPU we are running on.
+Isa best_supported_isa();
+
+// Returns all instruction sets supported by the CPU we are running on.
+std::vector<Isa> supported_isas();
+
+// Returns a human-readable name for isa.
+const char* name_of(Isa isa);
+}
+}
+}
+
+#endif // CORE_NET_IMPL_CPU_H_
@@ -0,0 +1,107 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "line_break.h"
+
+#include <cstdint>
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace impl = core::net::impl;
+
+namespace
+{
+// Lines up to this many bytes are scanned without the vectorized kernels.
+constexpr const std::size_t short_line{16};
+
+bool is_line_break(char c)
+{
+    return c == '\r' || c == '\n';
+}
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+// Returns the offset of the first line break in the leading multiple of 16 bytes of in,
+// or that multiple if there is none.
+__attribute__((target("sse2")))
+std::size_t line_break_sse2(const char* in, std::size_t size)
+{
+    auto cr = _mm_set1_epi8('\r');
+    auto lf = _mm_set1_epi8('\n');
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        auto breaks = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, cr), _mm_cmpeq_epi8(block, lf)));
+
+        if (breaks != 0)
+            return i + __builtin_ctz(breaks);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t line_break_avx2(const char* in, std::size_t size)
+{
+    auto cr = _mm256_set1_epi8('\r');
+    auto lf = _mm256_set1_epi8('\n');
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        auto breaks = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, cr), _mm256_cmpeq_epi8(block, lf))));
+
+        if (breaks != 0)
+            return i + __builtin_ctz(breaks);
+    }
+
+    return i + line_break_sse2(in + i, size - i);
+}
+#endif
+}
+
+std::size_t impl::find_line_break(const char* data, std::size_t size, Isa isa)
+{
+    std::size_t i = 0;
+    while (i < size && i < short_line && not is_line_break(data[i]))
+        i++;
+
+    if (i < short_line)
+        return i;
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+    switch (isa)
+    {
+    case Isa::avx2: i += line_break_avx2(data + i, size - i); break;
+    case Isa::ssse3: i += line_break_sse2(data + i, size - i); break;
+    case Isa::scalar: break;
+    }
+#else
+    (void) isa;
+#endif
+
+    while (i < size && not is_line_break(data[i]))
+        i++;
+
+    return i;
+}
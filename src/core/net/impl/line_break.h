@@ -0,0 +1,38 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+#ifndef CORE_NET_IMPL_LINE_BREAK_H_
+#define CORE_NET_IMPL_LINE_BREAK_H_
+
+#include "cpu.h"
+
+#include <cstddef>
+
+namespace core
+{
+namespace net
+{
+namespace impl
+{
+// Returns the offset of the first '\r' or '\n' in size bytes of data,
+// or size if there is none, using the kernel for isa.
+std::size_t find_line_break(const char* data, std::size_t size, Isa isa);
+}
+}
+}
+
+#endif // CORE_NET_IMPL_LINE_BREAK_H_
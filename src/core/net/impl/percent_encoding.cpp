@@ -0,0 +1,365 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "percent_encoding.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace pe = core::net::percent_encoding;
+namespace impl = core::net::impl::percent_encoding;
+
+using core::net::impl::Isa;
+
+namespace
+{
+constexpr const char* alphanumerics{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"};
+constexpr const char* hex_digits{"0123456789ABCDEF"};
+
+// Runs of up to this many bytes are scanned without the vectorized kernels.
+constexpr const std::size_t short_run{8};
+
+// The bytes a component leaves untouched when encoding.
+struct Tables
+{
+    Tables(const std::string& symbols, bool space_as_plus)
+        : space_as_plus(space_as_plus)
+    {
+        std::memset(safe, 0, sizeof(safe));
+        std::memset(safe_high_nibbles, 0, sizeof(safe_high_nibbles));
+
+        for (auto symbol : symbols)
+        {
+            auto c = static_cast<std::uint8_t>(symbol);
+            safe[c] = true;
+            safe_high_nibbles[c & 0x0f] |= 1 << (c >> 4);
+        }
+    }
+
+    bool safe[256];
+
+    // The vectorized kernels consider a byte c safe if bit c >> 4
+    // is set in safe_high_nibbles[c & 0x0f].
+    std::uint8_t safe_high_nibbles[16];
+
+    bool space_as_plus;
+};
+
+const Tables& tables_for(pe::Component component)
+{
+    static const std::string unreserved_symbols{std::string{alphanumerics} + "-._~"};
+    static const std::string sub_delims{"!$&'()*+,;="};
+
+    static const Tables unreserved{unreserved_symbols, false};
+    static const Tables path_segment{unreserved_symbols + sub_delims + ":@", false};
+    static const Tables query{unreserved_symbols + "!$'()*,;" + ":@/?", false};
+    static const Tables form{std::string{alphanumerics} + "*-._", true};
+
+    switch (component)
+    {
+    case pe::Component::unreserved: return unreserved;
+    case pe::Component::path_segment: return path_segment;
+    case pe::Component::query: return query;
+    case pe::Component::form: return form;
+    }
+
+    return unreserved;
+}
+
+int hex_value(std::uint8_t c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+
+    return -1;
+}
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+// The vectorized kernels only ever scan full blocks, returning the number
+// of bytes known to be safe (or literal). The caller takes care of the tail.
+
+__attribute__((target("ssse3")))
+std::size_t safe_prefix_ssse3(const Tables& t, const std::uint8_t* in, std::size_t size)
+{
+    auto nibble = _mm_set1_epi8(0x0f);
+    auto bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto safe = _mm_loadu_si128(reinterpret_cast<const __m128i*>(t.safe_high_nibbles));
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        auto hi = _mm_and_si128(_mm_srli_epi32(block, 4), nibble);
+        auto lo = _mm_and_si128(block, nibble);
+
+        auto accepted = _mm_and_si128(_mm_shuffle_epi8(safe, lo), _mm_shuffle_epi8(bits, hi));
+        auto unsafe = _mm_movemask_epi8(_mm_cmpeq_epi8(accepted, _mm_setzero_si128()));
+
+        if (unsafe != 0)
+            return i + __builtin_ctz(unsafe);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t safe_prefix_avx2(const Tables& t, const std::uint8_t* in, std::size_t size)
+{
+    auto nibble = _mm256_set1_epi8(0x0f);
+    auto bits = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+                1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    auto safe = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(t.safe_high_nibbles)));
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        auto hi = _mm256_and_si256(_mm256_srli_epi32(block, 4), nibble);
+        auto lo = _mm256_and_si256(block, nibble);
+
+        auto accepted = _mm256_and_si256(_mm256_shuffle_epi8(safe, lo), _mm256_shuffle_epi8(bits, hi));
+        auto unsafe = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(accepted, _mm256_setzero_si256())));
+
+        if (unsafe != 0)
+            return i + __builtin_ctz(unsafe);
+    }
+
+    return i + safe_prefix_ssse3(t, in + i, size - i);
+}
+
+// Finding '%' and '+' only takes comparisons, which SSE2 has to offer already.
+__attribute__((target("sse2")))
+std::size_t literal_prefix_sse2(const std::uint8_t* in, std::size_t size, bool plus)
+{
+    auto percent = _mm_set1_epi8('%');
+    auto escape = _mm_set1_epi8(plus ? '+' : '%');
+
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16)
+    {
+        auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        auto special = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, percent), _mm_cmpeq_epi8(block, escape)));
+
+        if (special != 0)
+            return i + __builtin_ctz(special);
+    }
+
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t literal_prefix_avx2(const std::uint8_t* in, std::size_t size, bool plus)
+{
+    auto percent = _mm256_set1_epi8('%');
+    auto escape = _mm256_set1_epi8(plus ? '+' : '%');
+
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32)
+    {
+        auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        auto special = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(block, percent), _mm256_cmpeq_epi8(block, escape))));
+
+        if (special != 0)
+            return i + __builtin_ctz(special);
+    }
+
+    return i + literal_prefix_sse2(in + i, size - i, plus);
+}
+#endif
+
+// Returns the number of leading bytes of in that do not need escaping.
+std::size_t safe_prefix(const Tables& t, const std::uint8_t* in, std::size_t size, Isa isa)
+{
+    // Text in need of escaping tends to come with short runs,
+    // not worth setting up the vectorized kernels for.
+    std::size_t i = 0;
+    while (i < size && i < short_run && t.safe[in[i]])
+        i++;
+
+    if (i < short_run)
+        return i;
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+    switch (isa)
+    {
+    case Isa::avx2: i += safe_prefix_avx2(t, in + i, size - i); break;
+    case Isa::ssse3: i += safe_prefix_ssse3(t, in + i, size - i); break;
+    case Isa::scalar: break;
+    }
+#else
+    (void) isa;
+#endif
+
+    while (i < size && t.safe[in[i]])
+        i++;
+
+    return i;
+}
+
+// Returns the number of leading bytes of in that decode to themselves.
+std::size_t literal_prefix(const std::uint8_t* in, std::size_t size, bool plus, Isa isa)
+{
+    std::size_t i = 0;
+    while (i < size && i < short_run && in[i] != '%' && not (plus && in[i] == '+'))
+        i++;
+
+    if (i < short_run)
+        return i;
+
+#if defined(CORE_NET_HAVE_X86_KERNELS)
+    switch (isa)
+    {
+    case Isa::avx2: i += literal_prefix_avx2(in + i, size - i, plus); break;
+    case Isa::ssse3: i += literal_prefix_sse2(in + i, size - i, plus); break;
+    case Isa::scalar: break;
+    }
+#else
+    (void) isa;
+#endif
+
+    while (i < size && in[i] != '%' && not (plus && in[i] == '+'))
+        i++;
+
+    return i;
+}
+}
+
+void impl::encode(
+        const char* data,
+        std::size_t size,
+        std::string& out,
+        pe::Component component,
+        Isa isa)
+{
+    const auto& t = tables_for(component);
+
+    // We grow out once for the worst case, every byte needing escaping,
+    // and trim it down to the actual size afterwards.
+    auto offset = out.size();
+    out.resize(offset + 3 * size);
+
+    auto in = reinterpret_cast<const std::uint8_t*>(data);
+    auto begin = &out[0];
+    auto o = begin + offset;
+
+    std::size_t i = 0;
+    while (i < size)
+    {
+        auto run = safe_prefix(t, in + i, size - i, isa);
+        std::memcpy(o, in + i, run);
+        o += run; i += run;
+
+        for (; i < size && not t.safe[in[i]]; i++)
+        {
+            if (t.space_as_plus && in[i] == ' ')
+            {
+                *o++ = '+';
+                continue;
+            }
+
+            o[0] = '%';
+            o[1] = hex_digits[in[i] >> 4];
+            o[2] = hex_digits[in[i] & 0x0f];
+            o += 3;
+        }
+    }
+
+    out.resize(o - begin);
+}
+
+std::size_t impl::encoded_size(
+        const char* data,
+        std::size_t size,
+        pe::Component component,
+        Isa isa)
+{
+    const auto& t = tables_for(component);
+    auto in = reinterpret_cast<const std::uint8_t*>(data);
+
+    std::size_t result{0};
+    std::size_t i = 0;
+    while (i < size)
+    {
+        auto run = safe_prefix(t, in + i, size - i, isa);
+        result += run; i += run;
+
+        for (; i < size && not t.safe[in[i]]; i++)
+            result += t.space_as_plus && in[i] == ' ' ? 1 : 3;
+    }
+
+    return result;
+}
+
+void impl::decode(
+        const char* text,
+        std::size_t size,
+        std::string& out,
+        pe::Component component,
+        Isa isa)
+{
+    auto plus = component == pe::Component::form;
+
+    // Decoding never grows the text.
+    auto offset = out.size();
+    out.resize(offset + size);
+
+    auto in = reinterpret_cast<const std::uint8_t*>(text);
+    auto begin = &out[0];
+    auto o = begin + offset;
+
+    std::size_t i = 0;
+    while (i < size)
+    {
+        auto run = literal_prefix(in + i, size - i, plus, isa);
+        std::memcpy(o, in + i, run);
+        o += run; i += run;
+
+        if (i == size)
+            break;
+
+        if (in[i] == '+')
+        {
+            *o++ = ' ';
+            i++;
+            continue;
+        }
+
+        int hi{-1}, lo{-1};
+        if (i + 2 < size && (hi = hex_value(in[i + 1])) >= 0 && (lo = hex_value(in[i + 2])) >= 0)
+        {
+            *o++ = static_cast<char>(hi << 4 | lo);
+            i += 3;
+        } else
+        {
+            *o++ = '%';
+            i++;
+        }
+    }
+
+    out.resize(o - begin);
+}
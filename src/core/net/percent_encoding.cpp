@@ -0,0 +1,47 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/percent_encoding.h>
+
+#include "impl/percent_encoding.h"
+
+namespace pe = core::net::percent_encoding;
+
+std::string pe::encode(const std::string& data, pe::Component component)
+{
+    std::string result;
+    encode(data.data(), data.size(), result, component);
+    return result;
+}
+
+void pe::encode(const char* data, std::size_t size, std::string& out, pe::Component component)
+{
+    impl::percent_encoding::encode(data, size, out, component, impl::best_supported_isa());
+}
+
+std::string pe::decode(const std::string& text, pe::Component component)
+{
+    std::string result;
+    decode(text.data(), text.size(), result, component);
+    return result;
+}
+
+void pe::decode(const char* text, std::size_t size, std::string& out, pe::Component component)
+{
+    impl::percent_encoding::decode(text, size, out, component, impl::best_supported_isa());
+}
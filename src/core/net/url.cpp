@@ -0,0 +1,356 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/url.h>
+
+#include <core/net/percent_encoding.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace net = core::net;
+namespace pe = core::net::percent_encoding;
+
+namespace
+{
+bool is_alpha(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool is_hex_digit(char c)
+{
+    return is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// Classifies the characters that may appear anywhere in a URI, i.e.,
+// the unreserved and reserved ones as well as '%'.
+struct UriChars
+{
+    enum Class : unsigned char
+    {
+        invalid,
+        valid,
+        percent
+    };
+
+    UriChars()
+    {
+        for (int c = 0; c < 256; c++)
+            classes[c] = is_alpha(c) || is_digit(c) ? valid : invalid;
+
+        for (auto c : std::string{"-._~:/?#[]@!$&'()*+,;="})
+            classes[static_cast<unsigned char>(c)] = valid;
+
+        classes[static_cast<unsigned char>('%')] = percent;
+    }
+
+    Class classes[256];
+};
+
+// Returns the position of the first of delimiters in text at or behind from, or the
+// size of text if there is none. Relies on text not containing NUL, which we reject.
+std::size_t find_first_of(const std::string& text, std::size_t from, const char* delimiters)
+{
+    return from + std::strcspn(text.c_str() + from, delimiters);
+}
+
+[[noreturn]] void throw_malformed(const std::string& reason, const std::string& text)
+{
+    throw net::Url::Errors::Malformed(reason + ": " + text, CORE_FROM_HERE());
+}
+}
+
+net::Url::Errors::Malformed::Malformed(const std::string& what, const core::Location& loc)
+    : core::net::Error(what, loc)
+{
+}
+
+net::Url net::Url::parse(const std::string& text)
+{
+    Url result;
+    result.assign(text);
+    return result;
+}
+
+net::Url::Url()
+    : scheme_{0, 0},
+      authority_{0, 0},
+      userinfo_{0, 0},
+      host_{0, 0},
+      port_{0, 0},
+      path_{0, 0},
+      query_{0, 0},
+      fragment_{0, 0},
+      has_query{false},
+      has_fragment{false}
+{
+}
+
+void net::Url::assign(const std::string& text)
+{
+    static const UriChars uri_chars;
+
+    const auto data = text.data();
+    const auto size = text.size();
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        auto c = uri_chars.classes[static_cast<unsigned char>(data[i])];
+
+        if (c == UriChars::valid)
+            continue;
+
+        if (c == UriChars::invalid)
+            throw_malformed("Invalid character", text);
+
+        if (i + 2 >= size || not is_hex_digit(data[i + 1]) || not is_hex_digit(data[i + 2]))
+            throw_malformed("Invalid percent-encoding", text);
+    }
+
+    // We follow the decomposition given in RFC 3986, appendix B, but only
+    // accept absolute URIs: ^(([^:/?#]+):)(//([^/?#]*))?([^?#]*)(\?([^#]*))?(#(.*))?
+    auto colon = find_first_of(text, 0, ":/?#");
+    if (colon == size || colon == 0 || text[colon] != ':')
+        throw_malformed("Missing scheme", text);
+
+    if (not is_alpha(text[0]))
+        throw_malformed("Invalid scheme", text);
+
+    for (std::size_t i = 1; i < colon; i++)
+        if (not is_alpha(text[i]) && not is_digit(text[i]) && not std::strchr("+-.", text[i]))
+            throw_malformed("Invalid scheme", text);
+
+    Range scheme{0, colon};
+
+    auto i = colon + 1;
+    Range authority{i, i}, userinfo{i, i}, host{i, i}, port{i, i};
+
+    if (text.compare(i, 2, "//") == 0)
+    {
+        auto begin = i + 2;
+        auto end = find_first_of(text, begin, "/?#");
+        authority = Range{begin, end};
+
+        // userinfo must not contain '@', making the first one the separator.
+        auto at = find_first_of(text, begin, "@");
+        auto host_begin = begin;
+        if (at < end)
+        {
+            userinfo = Range{begin, at};
+            host_begin = at + 1;
+        } else
+        {
+            userinfo = Range{begin, begin};
+        }
+
+        auto host_end = end;
+        if (host_begin < end && text[host_begin] == '[')
+        {
+            auto bracket = find_first_of(text, host_begin, "]");
+            if (bracket >= end)
+                throw_malformed("Unterminated IP literal", text);
+
+            host_end = bracket + 1;
+            if (host_end < end && text[host_end] != ':')
+                throw_malformed("Invalid authority", text);
+        } else
+        {
+            host_end = std::min(find_first_of(text, host_begin, ":"), end);
+        }
+
+        host = Range{host_begin, host_end};
+
+        // Brackets are reserved for IP literals.
+        auto is_bracket = [](char c) { return c == '[' || c == ']'; };
+        if (text[host_begin] != '[' && std::any_of(text.begin() + host_begin, text.begin() + host_end, is_bracket))
+            throw_malformed("Invalid host", text);
+
+        if (host_end < end)
+        {
+            port = Range{host_end + 1, end};
+
+            // Ports are 16 bit, checked digit by digit to not overflow on long runs of them.
+            std::uint32_t value{0};
+            for (auto j = port.begin; j < port.end; j++)
+            {
+                if (not is_digit(text[j]))
+                    throw_malformed("Invalid port", text);
+
+                value = value * 10 + static_cast<std::uint32_t>(text[j] - '0');
+                if (value > std::numeric_limits<std::uint16_t>::max())
+                    throw_malformed("Invalid port", text);
+            }
+        } else
+        {
+            port = Range{end, end};
+        }
+
+        i = end;
+    }
+
+    auto path_end = find_first_of(text, i, "?#");
+    Range path{i, path_end};
+    i = path_end;
+
+    Range query{i, i};
+    bool query_present = i < size && text[i] == '?';
+    if (query_present)
+    {
+        auto query_end = find_first_of(text, i + 1, "#");
+        query = Range{i + 1, query_end};
+        i = query_end;
+    }
+
+    Range fragment{i, i};
+    bool fragment_present = i < size && text[i] == '#';
+    if (fragment_present)
+        fragment = Range{i + 1, size};
+
+    // Only '#' itself is excluded from fragments.
+    if (fragment_present && find_first_of(text, fragment.begin, "#") != size)
+        throw_malformed("Invalid fragment", text);
+
+    buffer.assign(text);
+    scheme_ = scheme;
+    authority_ = authority;
+    userinfo_ = userinfo;
+    host_ = host;
+    port_ = port;
+    path_ = path;
+    query_ = query;
+    fragment_ = fragment;
+    has_query = query_present;
+    has_fragment = fragment_present;
+}
+
+std::string net::Url::scheme() const
+{
+    return substr(scheme_);
+}
+
+std::string net::Url::authority() const
+{
+    return substr(authority_);
+}
+
+std::string net::Url::userinfo() const
+{
+    return substr(userinfo_);
+}
+
+std::string net::Url::host() const
+{
+    return substr(host_);
+}
+
+std::string net::Url::port() const
+{
+    return substr(port_);
+}
+
+std::string net::Url::path() const
+{
+    return substr(path_);
+}
+
+std::string net::Url::query() const
+{
+    return substr(query_);
+}
+
+std::string net::Url::fragment() const
+{
+    return substr(fragment_);
+}
+
+net::Url& net::Url::append_path_segment(const std::string& segment)
+{
+    auto from = buffer.size();
+    buffer.push_back('/');
+    pe::encode(segment.data(), segment.size(), buffer, pe::Component::path_segment);
+
+    auto size = buffer.size() - from;
+    move_appended_to(path_.end, from);
+
+    path_.end += size;
+    query_.begin += size; query_.end += size;
+    fragment_.begin += size; fragment_.end += size;
+
+    return *this;
+}
+
+net::Url& net::Url::append_query_parameter(const std::string& key, const std::string& value)
+{
+    auto from = buffer.size();
+
+    if (not has_query)
+        buffer.push_back('?');
+    else if (query_.end > query_.begin)
+        buffer.push_back('&');
+
+    pe::encode(key.data(), key.size(), buffer, pe::Component::query);
+    buffer.push_back('=');
+    pe::encode(value.data(), value.size(), buffer, pe::Component::query);
+
+    auto size = buffer.size() - from;
+
+    if (not has_query)
+    {
+        // The new query starts right behind the path.
+        move_appended_to(path_.end, from);
+        query_ = Range{path_.end + 1, path_.end + size};
+        has_query = true;
+    } else
+    {
+        move_appended_to(query_.end, from);
+        query_.end += size;
+    }
+
+    fragment_.begin += size; fragment_.end += size;
+
+    return *this;
+}
+
+const std::string& net::Url::str() const
+{
+    return buffer;
+}
+
+const char* net::Url::c_str() const
+{
+    return buffer.c_str();
+}
+
+std::string net::Url::substr(const Range& range) const
+{
+    return buffer.substr(range.begin, range.end - range.begin);
+}
+
+void net::Url::move_appended_to(std::size_t offset, std::size_t from)
+{
+    if (offset < from)
+        std::rotate(buffer.begin() + offset, buffer.begin() + from, buffer.end());
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/base64.h>
+
+#include "core/net/impl/base64.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace base64 = core::net::base64;
+namespace impl = core::net::impl;
+namespace kernels = core::net::impl::base64;
+
+namespace
+{
+std::string random_bytes(std::size_t size, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::string result(size, '\0');
+    for (auto& c : result)
+        c = static_cast<char>(dist(rng));
+
+    return result;
+}
+
+std::string encode_with(impl::Isa isa, const std::string& data, base64::Alphabet alphabet, bool padded = true)
+{
+    std::string result;
+    kernels::encode(data.data(), data.size(), result, alphabet, padded, isa);
+    return result;
+}
+
+std::string decode_with(impl::Isa isa, const std::string& text, base64::Alphabet alphabet)
+{
+    std::string result;
+    kernels::decode(text.data(), text.size(), result, alphabet, isa);
+    return result;
+}
+}
+
+TEST(Base64, encodes_rfc_4648_test_vectors)
+{
+    EXPECT_EQ("", base64::encode(""));
+    EXPECT_EQ("Zg==", base64::encode("f"));
+    EXPECT_EQ("Zm8=", base64::encode("fo"));
+    EXPECT_EQ("Zm9v", base64::encode("foo"));
+    EXPECT_EQ("Zm9vYg==", base64::encode("foob"));
+    EXPECT_EQ("Zm9vYmE=", base64::encode("fooba"));
+    EXPECT_EQ("Zm9vYmFy", base64::encode("foobar"));
+
+    EXPECT_EQ("Zm9vYg", base64::encode("foob", base64::Alphabet::standard, false));
+    EXPECT_EQ("Zm9vYmE", base64::encode("fooba", base64::Alphabet::standard, false));
+}
+
+TEST(Base64, url_safe_alphabet_replaces_plus_and_slash)
+{
+    const std::string data{"\xfb\xff\xbf\xfb\xef", 5};
+
+    EXPECT_EQ("+/+/++8=", base64::encode(data));
+    EXPECT_EQ("-_-_--8=", base64::encode(data, base64::Alphabet::url_safe));
+    EXPECT_EQ("-_-_--8", base64::encode(data, base64::Alphabet::url_safe, false));
+
+    EXPECT_EQ(data, base64::decode("-_-_--8=", base64::Alphabet::url_safe));
+    EXPECT_EQ(data, base64::decode("-_-_--8", base64::Alphabet::url_safe));
+    EXPECT_THROW(base64::decode("-_-_--8=", base64::Alphabet::standard), base64::Errors::Malformed);
+    EXPECT_THROW(base64::decode("+/+/++8=", base64::Alphabet::url_safe), base64::Errors::Malformed);
+}
+
+TEST(Base64, appending_overloads_keep_existing_content)
+{
+    std::string out{"data:"};
+    base64::encode("foobar", 6, out);
+    EXPECT_EQ("data:Zm9vYmFy", out);
+
+    std::string decoded{"prefix"};
+    base64::decode("Zm9vYg==", 8, decoded);
+    EXPECT_EQ("prefixfoob", decoded);
+}
+
+TEST(Base64, decode_rejects_malformed_input)
+{
+    // Truncated quantum.
+    EXPECT_THROW(base64::decode("Zm9vY"), base64::Errors::Malformed);
+    // Padding not completing a quantum.
+    EXPECT_THROW(base64::decode("Zm9=="), base64::Errors::Malformed);
+    EXPECT_THROW(base64::decode("Zg="), base64::Errors::Malformed);
+    EXPECT_THROW(base64::decode("Z==="), base64::Errors::Malformed);
+    // Padding in the middle of the text.
+    EXPECT_THROW(base64::decode("Zg==Zg=="), base64::Errors::Malformed);
+    // Non-zero trailing bits.
+    EXPECT_THROW(base64::decode("Zh=="), base64::Errors::Malformed);
+    EXPECT_THROW(base64::decode("Zm9="), base64::Errors::Malformed);
+    // Symbols outside of the alphabet.
+    EXPECT_THROW(base64::decode("Zm9v\nYmFy"), base64::Errors::Malformed);
+    EXPECT_THROW(base64::decode(std::string{"Zm9v\0mFy", 8}), base64::Errors::Malformed);
+}
+
+TEST(Base64, decode_leaves_output_untouched_on_error)
+{
+    std::string out{"unchanged"};
+    EXPECT_THROW(base64::decode("Zm9vYmFy!", 9, out), base64::Errors::Malformed);
+    EXPECT_EQ("unchanged", out);
+}
+
+TEST(Base64, all_kernels_agree_with_the_scalar_implementation)
+{
+    std::mt19937 rng{42};
+
+    for (auto isa : impl::supported_isas())
+    {
+        SCOPED_TRACE(impl::name_of(isa));
+
+        for (std::size_t size = 0; size < 300; size++)
+        {
+            auto data = random_bytes(size, rng);
+
+            for (auto alphabet : {base64::Alphabet::standard, base64::Alphabet::url_safe})
+            {
+                for (auto padded : {true, false})
+                {
+                    auto expected = encode_with(impl::Isa::scalar, data, alphabet, padded);
+                    auto encoded = encode_with(isa, data, alphabet, padded);
+
+                    ASSERT_EQ(expected, encoded);
+                    ASSERT_EQ(data, decode_with(isa, encoded, alphabet));
+                }
+            }
+        }
+    }
+}
+
+TEST(Base64, all_kernels_reject_every_invalid_byte_at_every_position)
+{
+    std::mt19937 rng{42};
+
+    for (auto isa : impl::supported_isas())
+    {
+        SCOPED_TRACE(impl::name_of(isa));
+
+        for (auto alphabet : {base64::Alphabet::standard, base64::Alphabet::url_safe})
+        {
+            // 128 symbols without padding, covering several blocks of all kernels.
+            auto text = encode_with(impl::Isa::scalar, random_bytes(96, rng), alphabet);
+            auto symbols = alphabet == base64::Alphabet::standard ?
+                        std::string{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"} :
+                        std::string{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"};
+
+            for (int c = 0; c < 256; c++)
+            {
+                auto valid = symbols.find(static_cast<char>(c)) != std::string::npos;
+                for (std::size_t position = 0; position < text.size(); position++)
+                {
+                    // Trailing padding is legitimate and covered elsewhere.
+                    if (c == '=' && position >= text.size() - 2)
+                        continue;
+
+                    auto corrupted = text;
+                    corrupted[position] = static_cast<char>(c);
+
+                    if (valid)
+                        EXPECT_NO_THROW(decode_with(isa, corrupted, alphabet));
+                    else
+                        EXPECT_THROW(decode_with(isa, corrupted, alphabet), base64::Errors::Malformed);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/http/event_stream.h>
+#include <core/net/http/ndjson_stream.h>
+
+#include "core/net/impl/line_break.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+namespace http = core::net::http;
+namespace impl = core::net::impl;
+
+namespace
+{
+typedef http::EventStream::Event Event;
+
+// Feeds text to stream in slices of size bytes.
+template<typename Stream>
+void feed_in_slices(Stream& stream, const std::string& text, std::size_t size)
+{
+    for (std::size_t i = 0; i < text.size(); i += size)
+        stream.feed(text.substr(i, size));
+}
+
+std::vector<Event> events_of(const std::string& text, std::size_t slice)
+{
+    std::vector<Event> result;
+    http::EventStream stream{[&result](const Event& event) { result.push_back(event); }};
+    feed_in_slices(stream, text, slice);
+    return result;
+}
+}
+
+TEST(LineBreak, all_kernels_find_the_first_cr_or_lf)
+{
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> letter('a', 'z');
+
+    for (auto isa : impl::supported_isas())
+    {
+        for (std::size_t size : {0, 1, 15, 16, 17, 31, 32, 33, 100, 1000})
+        {
+            std::string text(size, ' ');
+            for (auto& c : text)
+                c = static_cast<char>(letter(rng));
+
+            EXPECT_EQ(size, impl::find_line_break(text.data(), text.size(), isa)) << impl::name_of(isa);
+
+            for (std::size_t at = 0; at < size; at += 7)
+            {
+                auto copy = text;
+                copy[at] = at % 2 ? '\r' : '\n';
+                if (at + 3 < size)
+                    copy[at + 3] = '\n';
+
+                EXPECT_EQ(at, impl::find_line_break(copy.data(), copy.size(), isa)) << impl::name_of(isa) << " " << size;
+            }
+        }
+    }
+}
+
+TEST(EventStream, parses_fields_regardless_of_chunk_boundaries)
+{
+    const std::string text
+    {
+        "\xEF\xBB\xBF: a comment\n"
+        "retry: 1500\n"
+        "\n"
+        "data: first\n"
+        "\n"
+        "id: 7\r\n"
+        "event: update\r\n"
+        "data:no space\r\n"
+        "data:  two spaces\r\n"
+        "\r\n"
+        "data\r"
+        "\r"
+        "retry: soon\n"
+        "event: ignored, as no data follows\n"
+        "\n"
+        "data: incomplete"
+    };
+
+    for (std::size_t slice = 1; slice <= text.size(); slice++)
+    {
+        auto events = events_of(text, slice);
+
+        ASSERT_EQ(3u, events.size()) << slice;
+
+        EXPECT_EQ("", events[0].id);
+        EXPECT_EQ("message", events[0].type);
+        EXPECT_EQ("first", events[0].data);
+        EXPECT_EQ(std::chrono::milliseconds{1500}, events[0].retry);
+
+        EXPECT_EQ("7", events[1].id);
+        EXPECT_EQ("update", events[1].type);
+        EXPECT_EQ("no space\n two spaces", events[1].data);
+
+        // The id carries over, and a field without a colon has an empty value.
+        EXPECT_EQ("7", events[2].id);
+        EXPECT_EQ("message", events[2].type);
+        EXPECT_EQ("", events[2].data);
+        EXPECT_EQ(std::chrono::milliseconds{1500}, events[2].retry);
+    }
+}
+
+TEST(EventStream, reset_discards_partial_events_but_keeps_last_event_id)
+{
+    std::vector<Event> events;
+    http::EventStream stream{[&events](const Event& event) { events.push_back(event); }};
+
+    EXPECT_EQ(std::chrono::milliseconds{http::EventStream::default_reconnection_time_in_ms}, stream.reconnection_time());
+
+    stream.feed("id: 1\ndata: one\n\nid: 2\ndata: tw");
+    EXPECT_EQ("1", stream.last_event_id());
+
+    stream.reset();
+    stream.feed("data: three\n\n");
+
+    ASSERT_EQ(2u, events.size());
+    EXPECT_EQ("1", events[1].id);
+    EXPECT_EQ("three", events[1].data);
+}
+
+TEST(EventStream, saturates_reconnection_time_instead_of_throwing)
+{
+    http::EventStream stream{[](const Event&) {}};
+
+    EXPECT_NO_THROW(stream.feed("retry: 99999999999999999999\n\n"));
+    EXPECT_EQ(std::chrono::milliseconds::max(), stream.reconnection_time());
+
+    stream.feed("retry: 9223372036854775807\n\n");
+    EXPECT_EQ(std::chrono::milliseconds::max(), stream.reconnection_time());
+
+    stream.feed("retry: 250\n\n");
+    EXPECT_EQ(std::chrono::milliseconds{250}, stream.reconnection_time());
+}
+
+TEST(NdjsonStream, splits_records_regardless_of_chunk_boundaries)
+{
+    const std::string text{"{\"a\":1}\n\n{\"b\":\n2}\r\n{\"c\":3}"};
+
+    for (std::size_t slice = 1; slice <= text.size(); slice++)
+    {
+        std::vector<std::string> records;
+        http::NdjsonStream stream{[&records](const char* data, std::size_t size) { records.emplace_back(data, size); }};
+
+        feed_in_slices(stream, text, slice);
+        EXPECT_EQ(3u, records.size());
+
+        stream.finish();
+        ASSERT_EQ(4u, records.size());
+        EXPECT_EQ("{\"a\":1}", records[0]);
+        EXPECT_EQ("{\"b\":", records[1]);
+        EXPECT_EQ("2}", records[2]);
+        EXPECT_EQ("{\"c\":3}", records[3]);
+    }
+}
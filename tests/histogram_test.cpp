@@ -0,0 +1,174 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/http/histogram.h>
+
+#include "core/net/http/impl/concurrent_histogram.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace http = core::net::http;
+
+namespace
+{
+typedef std::chrono::duration<double, std::milli> Milliseconds;
+
+// Relative error guaranteed by the log-linear buckets.
+constexpr const double precision{1. / 64};
+}
+
+TEST(Histogram, empty_histogram_reports_max)
+{
+    http::Histogram histogram;
+
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(http::Histogram::Seconds::max(), histogram.min());
+    EXPECT_EQ(http::Histogram::Seconds::max(), histogram.max());
+    EXPECT_EQ(http::Histogram::Seconds::max(), histogram.mean());
+    EXPECT_EQ(http::Histogram::Seconds::max(), histogram.percentile(99));
+}
+
+TEST(Histogram, summary_is_exact)
+{
+    http::Histogram histogram;
+
+    histogram.record(Milliseconds{1});
+    histogram.record(Milliseconds{2});
+    histogram.record(Milliseconds{3});
+
+    EXPECT_EQ(3u, histogram.count());
+    EXPECT_DOUBLE_EQ(0.001, histogram.min().count());
+    EXPECT_DOUBLE_EQ(0.003, histogram.max().count());
+    EXPECT_DOUBLE_EQ(0.002, histogram.mean().count());
+    EXPECT_NEAR(2. / 3 * 1e-6, histogram.variance().count(), 1e-12);
+    EXPECT_DOUBLE_EQ(0.006, histogram.sum().count());
+}
+
+TEST(Histogram, percentiles_are_within_precision)
+{
+    http::Histogram histogram;
+
+    for (int i = 1; i <= 10000; i++)
+        histogram.record(Milliseconds{i * 0.1});
+
+    for (double percentage : {50., 90., 99., 99.9})
+    {
+        auto expected = percentage / 100;
+        EXPECT_NEAR(expected, histogram.percentile(percentage).count(), expected * precision);
+    }
+
+    EXPECT_DOUBLE_EQ(histogram.max().count(), histogram.percentile(100).count());
+    EXPECT_NEAR(histogram.min().count(), histogram.percentile(0).count(), 1e-6);
+}
+
+TEST(Histogram, merging_equals_recording_into_a_single_histogram)
+{
+    http::Histogram all, even, odd;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        all.record(Milliseconds{i});
+        (i % 2 == 0 ? even : odd).record(Milliseconds{i});
+    }
+
+    even.merge(odd);
+
+    EXPECT_EQ(all.count(), even.count());
+    EXPECT_EQ(all.min(), even.min());
+    EXPECT_EQ(all.max(), even.max());
+    EXPECT_DOUBLE_EQ(all.mean().count(), even.mean().count());
+    EXPECT_EQ(all.percentile(99), even.percentile(99));
+}
+
+TEST(Histogram, reset_drops_all_durations)
+{
+    http::Histogram histogram;
+    histogram.record(Milliseconds{1});
+
+    histogram.reset();
+
+    EXPECT_EQ(0u, histogram.count());
+    EXPECT_EQ(http::Histogram::Seconds::max(), histogram.percentile(50));
+}
+
+TEST(Histogram, enumerates_non_empty_buckets_in_ascending_order)
+{
+    http::Histogram histogram;
+
+    histogram.record(std::chrono::hours{24 * 365});
+    histogram.record(Milliseconds{1});
+    histogram.record(Milliseconds{1});
+    histogram.record(Milliseconds{-1});
+
+    std::vector<std::pair<double, std::uint64_t>> buckets;
+    histogram.enumerate([&buckets](const http::Histogram::Seconds& upper_bound, std::uint64_t count)
+    {
+        buckets.push_back(std::make_pair(upper_bound.count(), count));
+    });
+
+    ASSERT_EQ(3u, buckets.size());
+    EXPECT_EQ(1u, buckets[0].second);
+    EXPECT_EQ(2u, buckets[1].second);
+    EXPECT_NEAR(0.001, buckets[1].first, 0.001 * precision);
+    EXPECT_EQ(1u, buckets[2].second);
+    EXPECT_LT(buckets[1].first, buckets[2].first);
+}
+
+TEST(ConcurrentHistogram, collected_total_matches_buckets_while_recording)
+{
+    http::impl::ConcurrentHistogram concurrent;
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> recorders;
+    for (int i = 0; i < 4; i++)
+    {
+        recorders.emplace_back([&concurrent, &done, i]()
+        {
+            while (not done.load())
+                concurrent.record(Milliseconds{1 + i});
+        });
+    }
+
+    std::uint64_t collected{0};
+
+    // Durations recorded while resetting must neither be counted twice nor show up in the total only.
+    for (int i = 0; i < 1000; i++)
+    {
+        http::Histogram histogram;
+        concurrent.collect(histogram, true);
+
+        std::uint64_t sum{0};
+        histogram.enumerate([&sum](const http::Histogram::Seconds&, std::uint64_t count) { sum += count; });
+
+        EXPECT_EQ(histogram.count(), sum);
+        collected += sum;
+    }
+
+    done.store(true);
+    for (auto& recorder : recorders)
+        recorder.join();
+
+    http::Histogram rest;
+    concurrent.collect(rest, false);
+
+    EXPECT_LT(0u, collected + rest.count());
+}
@@ -17,6 +17,7 @@
  */
 
 #include <core/net/error.h>
+#include <core/net/executor.h>
 #include <core/net/http/client.h>
 #include <core/net/http/content_type.h>
 #include <core/net/http/request.h>
@@ -29,6 +30,9 @@
 
 #include <json/json.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
 
 #include <future>
@@ -53,7 +57,7 @@ struct HttpClientLoadTest : public ::testing::Test
         std::thread worker{[client]() { client->run(); }};
 
         // Url pointing to the resource we would like to access via http.
-        auto url = std::string(httpbin::host) + httpbin::resources::get();
+        auto url = httpbin::host() + httpbin::resources::get();
 
         std::size_t completed{1};
         std::size_t total{200};
@@ -122,7 +126,7 @@ static const bool is_initialized __attribute__((used)) = init();
 
 TEST_F(HttpClientLoadTest, async_head_request_for_existing_resource_succeeds)
 {
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     auto request_factory = [url](const std::shared_ptr<http::Client>& client)
     {
@@ -147,7 +151,7 @@ TEST_F(HttpClientLoadTest, async_head_request_for_existing_resource_succeeds)
 
 TEST_F(HttpClientLoadTest, async_get_request_for_existing_resource_succeeds)
 {
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     auto request_factory = [url](const std::shared_ptr<http::Client>& client)
     {
@@ -176,7 +180,7 @@ TEST_F(HttpClientLoadTest, async_get_request_for_existing_resource_succeeds)
 
 TEST_F(HttpClientLoadTest, async_post_request_for_existing_resource_succeeds)
 {
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
     auto payload = "{ 'test': 'test' }";
 
     auto request_factory = [url, payload](const std::shared_ptr<http::Client>& client)
@@ -205,3 +209,81 @@ TEST_F(HttpClientLoadTest, async_post_request_for_existing_resource_succeeds)
 
     run(request_factory, response_verifier);
 }
+
+TEST(HttpClientLoad, cpu_heavy_response_handling_scales_with_executor_threads)
+{
+    auto url = httpbin::host() + httpbin::resources::get();
+
+    // Every response keeps a thread busy for 200µs, emulating parsing and processing.
+    auto handle_response = []()
+    {
+        auto until = std::chrono::steady_clock::now() + std::chrono::microseconds{200};
+        while (std::chrono::steady_clock::now() < until);
+    };
+
+    const std::size_t total{1000};
+    const std::size_t cores{std::max(1u, std::thread::hardware_concurrency())};
+
+    testing::Table::Row<15, '|'> row;
+    testing::Table::Row<15, '|'>::HorizontalSeparator<3> sep;
+
+    std::cout << sep;
+    std::cout << (row << "Threads" << "Requests [1/s]" << "Speedup");
+    std::cout << sep;
+
+    double baseline{0};
+
+    for (std::size_t threads = 1; threads <= cores; threads *= 2)
+    {
+        http::Client::Configuration configuration;
+        configuration.callbacks.executor = net::make_thread_pool_executor(threads);
+
+        auto client = http::make_client(configuration);
+        std::thread worker{[client]() { client->run(); }};
+
+        std::atomic<std::size_t> completed{0};
+        std::promise<void> done;
+
+        auto on_completed = [&completed, &done, total]()
+        {
+            if (++completed == total)
+                done.set_value();
+        };
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < total; i++)
+        {
+            client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                        http::Request::Handler()
+                        .on_response([handle_response, on_completed](const core::net::http::Response& response)
+                        {
+                            EXPECT_EQ(core::net::http::Status::ok, response.status);
+                            handle_response();
+                            on_completed();
+                        })
+                        .on_error([on_completed](const core::net::Error&)
+                        {
+                            ADD_FAILURE();
+                            on_completed();
+                        }));
+        }
+
+        done.get_future().wait();
+
+        std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+        auto throughput = total / elapsed.count();
+
+        if (threads == 1)
+            baseline = throughput;
+
+        std::cout << (row << threads << throughput << throughput / baseline);
+
+        client->stop();
+
+        if (worker.joinable())
+            worker.join();
+    }
+
+    std::cout << sep;
+}
@@ -18,20 +18,32 @@
  */
 
 #include <core/net/error.h>
+#include <core/net/percent_encoding.h>
 #include <core/net/uri.h>
 #include <core/net/http/client.h>
 #include <core/net/http/content_type.h>
+#include <core/net/http/form.h>
 #include <core/net/http/request.h>
 #include <core/net/http/response.h>
 
 #include "httpbin.h"
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include <json/json.h>
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
 #include <future>
 #include <fstream>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
 
 namespace http = core::net::http;
 namespace json = Json;
@@ -56,6 +68,25 @@ bool init()
 }
 
 static const bool is_initialized __attribute__((used)) = init();
+
+// A client implementation other than the default one, relying on the
+// convenience overloads to dispatch to its virtual methods.
+struct MockClient : public http::Client
+{
+    MOCK_CONST_METHOD1(url_escape, std::string(const std::string&));
+    MOCK_CONST_METHOD1(base64_encode, std::string(const std::string&));
+    MOCK_CONST_METHOD1(base64_decode, std::string(const std::string&));
+    MOCK_METHOD0(timings, Timings());
+    MOCK_METHOD0(run, void());
+    MOCK_METHOD0(stop, void());
+    MOCK_METHOD1(get, std::shared_ptr<http::Request>(const http::Request::Configuration&));
+    MOCK_METHOD1(head, std::shared_ptr<http::Request>(const http::Request::Configuration&));
+    MOCK_METHOD3(put, std::shared_ptr<http::Request>(const http::Request::Configuration&, std::istream&, std::size_t));
+    MOCK_METHOD3(post, std::shared_ptr<http::Request>(const http::Request::Configuration&, const std::string&, const std::string&));
+
+    using http::Client::put;
+    using http::Client::post;
+};
 }
 
 TEST(HttpClient, uri_to_string)
@@ -74,6 +105,13 @@ TEST(HttpClient, uri_to_string)
             client->uri_to_string(net::make_uri("http://banana.fruit",
             { "my", "endpoint" },
             { { "hello there", "good bye" }, { "happy", "sad" } })));
+
+    // Delimiters of the respective component are escaped, everything else is left alone.
+    EXPECT_EQ(
+            "http://example.com/a%2Fb/user@host:1?q=a%26b%3Dc%2Bd&redirect=/p?x",
+            client->uri_to_string(net::make_uri("http://example.com",
+            { "a/b", "user@host:1" },
+            { { "q", "a&b=c+d" }, { "redirect", "/p?x" } })));
 }
 
 TEST(HttpClient, head_request_for_existing_resource_succeeds)
@@ -82,7 +120,7 @@ TEST(HttpClient, head_request_for_existing_resource_succeeds)
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->head(http::Request::Configuration::from_uri_as_string(url));
@@ -100,7 +138,7 @@ TEST(HttpClient, DISABLED_a_request_can_timeout)
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->head(http::Request::Configuration::from_uri_as_string(url));
@@ -137,7 +175,7 @@ TEST(HttpClient, get_request_for_existing_resource_succeeds)
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->get(http::Request::Configuration::from_uri_as_string(url));
@@ -163,7 +201,7 @@ TEST(HttpClient, get_request_with_custom_headers_for_existing_resource_succeeds)
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::headers();
+    auto url = httpbin::host() + httpbin::resources::headers();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -197,7 +235,7 @@ TEST(HttpClient, empty_header_values_are_handled_correctly)
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::headers();
+    auto url = httpbin::host() + httpbin::resources::headers();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -228,7 +266,7 @@ TEST(HttpClient, get_request_for_existing_resource_guarded_by_basic_auth_succeed
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::basic_auth();
+    auto url = httpbin::host() + httpbin::resources::basic_auth();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -262,7 +300,7 @@ TEST(HttpClient, DISABLED_get_request_for_existing_resource_guarded_by_digest_au
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::digest_auth();
+    auto url = httpbin::host() + httpbin::resources::digest_auth();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -298,7 +336,7 @@ TEST(HttpClient, async_get_request_for_existing_resource_succeeds)
     std::thread worker{[client]() { client->run(); }};
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->get(http::Request::Configuration::from_uri_as_string(url));
@@ -339,6 +377,86 @@ TEST(HttpClient, async_get_request_for_existing_resource_succeeds)
         worker.join();
 }
 
+TEST(HttpClient, async_request_can_be_issued_from_a_response_handler)
+{
+    auto client = http::make_client();
+    std::thread worker{[client]() { client->run(); }};
+
+    auto url = httpbin::host() + httpbin::resources::get();
+
+    std::promise<core::net::http::Response> promise;
+    auto future = promise.get_future();
+
+    // The follow-up request is issued on the reactor, while it processes the finished transfer.
+    client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                http::Request::Handler()
+                    .on_response([&](const core::net::http::Response&)
+                    {
+                        client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                                    http::Request::Handler()
+                                        .on_response([&](const core::net::http::Response& response)
+                                        {
+                                            promise.set_value(response);
+                                        })
+                                        .on_error([&](const core::net::Error& e)
+                                        {
+                                            promise.set_exception(std::make_exception_ptr(e));
+                                        }));
+                    })
+                    .on_error([&](const core::net::Error& e)
+                    {
+                        promise.set_exception(std::make_exception_ptr(e));
+                    }));
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{10}));
+    EXPECT_EQ(core::net::http::Status::ok, future.get().status);
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
+TEST(HttpClient, async_request_can_be_issued_from_an_error_handler)
+{
+    auto client = http::make_client();
+    std::thread worker{[client]() { client->run(); }};
+
+    auto url = httpbin::host() + httpbin::resources::get();
+
+    std::promise<core::net::http::Response> promise;
+    auto future = promise.get_future();
+
+    // Nothing listens on port 1, so the first request fails right away.
+    client->get(http::Request::Configuration::from_uri_as_string("http://127.0.0.1:1/"))->async_execute(
+                http::Request::Handler()
+                    .on_response([&](const core::net::http::Response& response)
+                    {
+                        promise.set_value(response);
+                    })
+                    .on_error([&](const core::net::Error&)
+                    {
+                        client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                                    http::Request::Handler()
+                                        .on_response([&](const core::net::http::Response& response)
+                                        {
+                                            promise.set_value(response);
+                                        })
+                                        .on_error([&](const core::net::Error& e)
+                                        {
+                                            promise.set_exception(std::make_exception_ptr(e));
+                                        }));
+                    }));
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{10}));
+    EXPECT_EQ(core::net::http::Status::ok, future.get().status);
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
 TEST(HttpClient, async_get_request_for_existing_resource_guarded_by_basic_authentication_succeeds)
 {
     // We obtain a default client instance, dispatching to the default implementation.
@@ -348,7 +466,7 @@ TEST(HttpClient, async_get_request_for_existing_resource_guarded_by_basic_authen
     std::thread worker{[client]() { client->run(); }};
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::basic_auth();
+    auto url = httpbin::host() + httpbin::resources::basic_auth();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -405,7 +523,7 @@ TEST(HttpClient, post_request_for_existing_resource_succeeds)
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
 
     std::string payload = "{ 'test': 'test' }";
 
@@ -429,17 +547,134 @@ TEST(HttpClient, post_request_for_existing_resource_succeeds)
     EXPECT_EQ(payload, root["data"].asString());
 }
 
+TEST(HttpClient, post_request_with_compression_announces_content_encoding)
+{
+    // We obtain a default client instance, dispatching to the default implementation.
+    auto client = http::make_client();
+
+    // Url pointing to the resource we would like to access via http.
+    auto url = httpbin::host() + httpbin::resources::post();
+
+    std::string payload = "{ 'test': 'test' }";
+
+    // We ask for the payload to be compressed on the fly.
+    auto configuration = http::Request::Configuration::from_uri_as_string(url);
+    configuration.upload.compression = http::Request::Compression::gzip;
+
+    auto request = client->post(configuration, payload, core::net::http::ContentType::json);
+
+    // All endpoint data on httpbin.org is JSON encoded.
+    json::Value root;
+    json::Reader reader;
+
+    // We finally execute the query synchronously and story the response.
+    auto response = request->execute(default_progress_reporter);
+
+    // We expect the query to complete successfully
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    // Parsing the body of the response as JSON should succeed.
+    EXPECT_TRUE(reader.parse(response.body, root));
+    // The compressed body is announced with the right content-coding.
+    EXPECT_EQ("gzip", root["headers"]["Content-Encoding"].asString());
+    EXPECT_EQ("chunked", root["headers"]["Transfer-Encoding"].asString());
+    // And inflates to what we posted.
+    EXPECT_EQ(payload, httpbin::inflated(root["data"].asString()));
+}
+
+TEST(HttpClient, put_request_with_compression_of_stream_inflates_to_payload)
+{
+    auto client = http::make_client();
+    auto url = httpbin::host() + httpbin::resources::put();
+
+    // Compresses well, such that the body sent is much smaller than the payload.
+    std::string value(64 * 1024, 'x');
+    std::stringstream payload(value);
+
+    auto configuration = http::Request::Configuration::from_uri_as_string(url);
+    configuration.upload.compression = http::Request::Compression::deflate;
+
+    auto request = client->put(configuration, payload, value.size());
+
+    json::Value root;
+    json::Reader reader;
+
+    auto response = request->execute(default_progress_reporter);
+
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    EXPECT_TRUE(reader.parse(response.body, root));
+    EXPECT_EQ("deflate", root["headers"]["Content-Encoding"].asString());
+    EXPECT_EQ(value, httpbin::inflated(root["data"].asString()));
+}
+
+TEST(HttpClient, post_request_announces_the_given_content_type)
+{
+    // We obtain a default client instance, dispatching to the default implementation.
+    auto client = http::make_client();
+
+    // Url pointing to the resource we would like to access via http.
+    auto url = httpbin::host() + httpbin::resources::post();
+
+    std::string payload = "{ 'test': 'test' }";
+
+    for (auto compression : {http::Request::Compression::none, http::Request::Compression::gzip})
+    {
+        auto configuration = http::Request::Configuration::from_uri_as_string(url);
+        configuration.upload.compression = compression;
+
+        auto request = client->post(configuration, payload, core::net::http::ContentType::json);
+
+        // All endpoint data on httpbin.org is JSON encoded.
+        json::Value root;
+        json::Reader reader;
+
+        auto response = request->execute(default_progress_reporter);
+
+        EXPECT_EQ(core::net::http::Status::ok, response.status);
+        EXPECT_TRUE(reader.parse(response.body, root));
+        // Instead of the form type curl defaults to.
+        EXPECT_EQ(std::string{core::net::http::ContentType::json}, root["headers"]["Content-Type"].asString());
+    }
+}
+
+TEST(HttpClient, post_request_keeps_the_content_type_of_the_configured_header)
+{
+    // We obtain a default client instance, dispatching to the default implementation.
+    auto client = http::make_client();
+
+    // Url pointing to the resource we would like to access via http.
+    auto url = httpbin::host() + httpbin::resources::post();
+
+    auto configuration = http::Request::Configuration::from_uri_as_string(url);
+    configuration.header.set("Content-Type", "application/vnd.test+json");
+
+    std::string payload = "{ 'test': 'test' }";
+
+    auto request = client->post(configuration, payload, core::net::http::ContentType::json);
+
+    // All endpoint data on httpbin.org is JSON encoded.
+    json::Value root;
+    json::Reader reader;
+
+    auto response = request->execute(default_progress_reporter);
+
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    EXPECT_TRUE(reader.parse(response.body, root));
+    // Header fields configured by the caller take precedence.
+    EXPECT_EQ("application/vnd.test+json", root["headers"]["Content-Type"].asString());
+}
+
 TEST(HttpClient, post_form_request_for_existing_resource_succeeds)
 {
     // We obtain a default client instance, dispatching to the default implementation.
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
 
     std::map<std::string, std::string> values
     {
-        {"test", "test"}
+        {"test", "test"},
+        {"hello there", "a&b=c+d ~"}
     };
 
     // The client mostly acts as a factory for http requests.
@@ -456,12 +691,118 @@ TEST(HttpClient, post_form_request_for_existing_resource_succeeds)
     EXPECT_EQ(core::net::http::Status::ok, response.status);
     EXPECT_TRUE(reader.parse(response.body, root));
     EXPECT_EQ("test", root["form"]["test"].asString());
+    EXPECT_EQ("a&b=c+d ~", root["form"]["hello there"].asString());
+}
+
+TEST(HttpClient, form_reader_hands_out_exactly_size_bytes_in_any_slices)
+{
+    std::vector<std::pair<std::string, std::string>> values
+    {
+        {"z", "last but one"},
+        {"a", std::string(50000, '&')},
+        {"", ""}
+    };
+
+    auto form = http::Form::from(values);
+    EXPECT_EQ("application/x-www-form-urlencoded", form.content_type());
+
+    // Fields keep their order and values are encoded in slices.
+    auto expected = "z=last+but+one&a=" + core::net::percent_encoding::encode(values[1].second, core::net::percent_encoding::Component::form) + "&=";
+    EXPECT_EQ(expected.size(), form.size());
+
+    for (std::size_t slice : {1, 7, 4096, 1024 * 1024})
+    {
+        auto reader = form.reader();
+        std::string body;
+        std::vector<char> buffer(slice);
+
+        while (auto n = reader(buffer.data(), buffer.size()))
+            body.append(buffer.data(), n);
+
+        EXPECT_EQ(expected, body);
+    }
+}
+
+TEST(HttpClient, form_refuses_files_it_cannot_upload)
+{
+    http::Form url_encoded;
+    EXPECT_THROW(url_encoded.add_file("file", "/etc/hostname"), http::Form::Errors::FilesRequireMultipart);
+
+    http::Form multipart{http::Form::Encoding::multipart};
+    EXPECT_THROW(multipart.add_file("file", "/does/not/exist"), http::Form::Errors::InaccessibleFile);
+    EXPECT_THROW(multipart.add_file("file", "/tmp"), http::Form::Errors::InaccessibleFile);
+}
+
+TEST(HttpClient, post_form_with_multipart_body_streams_fields_and_files)
+{
+    auto client = http::make_client();
+    auto url = httpbin::host() + httpbin::resources::post();
+
+    char path[] = "/tmp/net-cpp-form-XXXXXX";
+    auto fd = ::mkstemp(path);
+    ASSERT_NE(-1, fd);
+    ::close(fd);
+
+    const std::string contents{"line one\nline two\n"};
+    {
+        std::ofstream ofs(path, std::ios::binary | std::ios::out);
+        ofs << contents;
+    }
+
+    auto form = http::Form{http::Form::Encoding::multipart}
+            .add("title", "a \"quoted\" & multi\r\nline value")
+            .add_file("upload", path, "text/plain");
+
+    auto request = client->post_form(http::Request::Configuration::from_uri_as_string(url), form);
+    auto response = request->execute(default_progress_reporter);
+
+    json::Value root;
+    json::Reader reader;
+
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    EXPECT_TRUE(reader.parse(response.body, root));
+    EXPECT_EQ("a \"quoted\" & multi\r\nline value", root["form"]["title"].asString());
+    EXPECT_EQ(contents, root["files"]["upload"].asString());
+    EXPECT_EQ(form.content_type(), root["headers"]["Content-Type"].asString());
+    EXPECT_EQ(std::to_string(form.size()), root["headers"]["Content-Length"].asString());
+
+    std::remove(path);
+}
+
+TEST(HttpClient, post_form_is_sent_again_to_answer_an_authentication_challenge)
+{
+    auto client = http::make_client();
+    auto url = httpbin::host() + httpbin::resources::digest_auth();
+
+    // Large enough for curl to have sent it when the challenge arrives, such that it has to rewind.
+    auto form = http::Form{http::Form::Encoding::multipart}
+            .add("title", std::string(64 * 1024, 'x'));
+
+    for (auto compression : {http::Request::Compression::none, http::Request::Compression::gzip})
+    {
+        auto configuration = http::Request::Configuration::from_uri_as_string(url);
+        configuration.upload.compression = compression;
+        configuration.authentication_handler.for_http = [](const std::string&)
+        {
+            return http::Request::Credentials{"user", "passwd"};
+        };
+
+        auto request = client->post_form(configuration, form);
+        auto response = request->execute(default_progress_reporter);
+
+        json::Value root;
+        json::Reader reader;
+
+        EXPECT_EQ(core::net::http::Status::ok, response.status);
+        EXPECT_TRUE(reader.parse(response.body, root));
+        EXPECT_TRUE(root["authenticated"].asBool());
+    }
 }
 
 TEST(HttpClient, post_request_for_file_with_large_chunk_succeeds)
 {
     auto client = http::make_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
 
     // create temp file with large chunk
     const std::size_t size = 1024*1024;
@@ -488,7 +829,7 @@ TEST(HttpClient, post_request_for_file_with_large_chunk_succeeds)
 TEST(HttpClient, put_request_for_existing_resource_succeeds)
 {
     auto client = http::make_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::put();
+    auto url = httpbin::host() + httpbin::resources::put();
 
     const std::string value{"{ 'test': 'test' }"};
     std::stringstream payload(value);
@@ -507,10 +848,59 @@ TEST(HttpClient, put_request_for_existing_resource_succeeds)
     EXPECT_EQ(payload.str(), root["data"].asString());
 }
 
+TEST(HttpClient, put_request_for_shared_payload_succeeds)
+{
+    auto client = http::make_client();
+    auto url = httpbin::host() + httpbin::resources::put();
+
+    // The request shares ownership of the payload instead of copying it.
+    auto payload = std::make_shared<const std::string>("{ 'test': 'test' }");
+
+    auto request = client->put(http::Request::Configuration::from_uri_as_string(url),
+                               payload);
+
+    json::Value root;
+    json::Reader reader;
+
+    auto response = request->execute(default_progress_reporter);
+
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    EXPECT_TRUE(reader.parse(response.body, root));
+    EXPECT_EQ(*payload, root["data"].asString());
+}
+
+TEST(HttpClient, convenience_overloads_dispatch_to_virtuals_of_other_implementations)
+{
+    using namespace ::testing;
+
+    MockClient client;
+    auto configuration = http::Request::Configuration::from_uri_as_string("http://example.com");
+
+    EXPECT_CALL(client, post(_, "{}", http::ContentType::json)).Times(2).WillRepeatedly(Return(nullptr));
+    EXPECT_CALL(client, post(_, "a=b", http::ContentType::x_www_form_urlencoded)).Times(1).WillOnce(Return(nullptr));
+
+    std::string uploaded;
+    EXPECT_CALL(client, put(_, _, 2)).Times(2).WillRepeatedly(Invoke([&uploaded](const http::Request::Configuration&, std::istream& in, std::size_t)
+    {
+        uploaded.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+        return std::shared_ptr<http::Request>{};
+    }));
+
+    client.post(configuration, "{}", http::ContentType::json);
+    client.post(configuration, std::make_shared<const std::string>("{}"), http::ContentType::json);
+    client.post_form(configuration, {{"a", "b"}});
+
+    client.put(configuration, std::string{"{}"});
+    EXPECT_EQ("{}", uploaded);
+    uploaded.clear();
+    client.put(configuration, std::make_shared<const std::string>("{}"));
+    EXPECT_EQ("{}", uploaded);
+}
+
 TEST(HttpClient, put_request_for_file_with_large_chunk_succeeds)
 {
     auto client = http::make_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::put();
+    auto url = httpbin::host() + httpbin::resources::put();
 
     // create temp file with large chunk
     const std::size_t size = 1024*1024;
@@ -537,7 +927,7 @@ TEST(HttpClient, put_request_for_file_with_large_chunk_succeeds)
 TEST(HttpClient, del_request_for_existing_resource_succeeds)
 {
     auto client = http::make_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::del();
+    auto url = httpbin::host() + httpbin::resources::del();
 
     auto request = client->del(http::Request::Configuration::from_uri_as_string(url));
 
@@ -551,13 +941,475 @@ TEST(HttpClient, del_request_for_existing_resource_succeeds)
     EXPECT_EQ(url, root["url"].asString());
 }
 
+TEST(HttpClient, get_request_for_fresh_cached_resource_is_answered_from_cache)
+{
+    struct Recorder : public http::Client::Observer
+    {
+        void on_event(const http::Client::TraceEvent& event) override
+        {
+            if (event.kind == http::Client::TraceEvent::Kind::created)
+                created++;
+        }
+
+        std::atomic<int> created{0};
+    };
+
+    auto recorder = std::make_shared<Recorder>();
+
+    http::Client::Configuration configuration;
+    configuration.cache.capacity = 1024 * 1024;
+    configuration.tracing.observer = recorder;
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::cache_for_a_minute();
+
+    auto first = client->get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter);
+    auto second = client->get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter);
+
+    EXPECT_EQ(core::net::http::Status::ok, second.status);
+    EXPECT_EQ(first.body, second.body);
+    EXPECT_TRUE(second.header.has("Cache-Control", "public, max-age=60"));
+
+    auto statistics = client->cache_statistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(1u, statistics.misses);
+    EXPECT_EQ(0u, statistics.revalidations);
+    EXPECT_EQ(1u, statistics.entries);
+
+    // The hit did not even set up a transfer.
+    EXPECT_EQ(1, recorder->created.load());
+}
+
+TEST(HttpClient, async_get_request_for_fresh_cached_resource_is_answered_on_the_reactor)
+{
+    http::Client::Configuration configuration;
+    configuration.cache.capacity = 1024 * 1024;
+
+    auto client = http::make_client(configuration);
+    std::thread worker{[client]() { client->run(); }};
+
+    auto url = httpbin::host() + httpbin::resources::cache_for_a_minute();
+    client->get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter);
+
+    std::promise<std::thread::id> promise;
+    auto future = promise.get_future();
+
+    // Answered from cache, but still delivered on the thread running the client.
+    client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                http::Request::Handler()
+                    .on_response([&](const core::net::http::Response&)
+                    {
+                        promise.set_value(std::this_thread::get_id());
+                    })
+                    .on_error([&](const core::net::Error& e)
+                    {
+                        promise.set_exception(std::make_exception_ptr(e));
+                    }));
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{10}));
+    EXPECT_EQ(worker.get_id(), future.get());
+    EXPECT_EQ(1u, client->cache_statistics().hits);
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
+TEST(HttpClient, get_request_for_stale_cached_resource_is_revalidated)
+{
+    http::Client::Configuration configuration;
+    configuration.cache.capacity = 1024 * 1024;
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::cache();
+
+    auto first = client->get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter);
+    // The origin server answers with a 304 that we translate to the cached response.
+    auto second = client->get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter);
+
+    EXPECT_EQ(core::net::http::Status::ok, second.status);
+    EXPECT_EQ(first.body, second.body);
+
+    auto statistics = client->cache_statistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(1u, statistics.misses);
+    EXPECT_EQ(1u, statistics.revalidations);
+}
+
+TEST(HttpClient, identical_get_requests_in_flight_share_a_single_transfer)
+{
+    http::Client::Configuration configuration;
+    configuration.coalescing.enabled = true;
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::uuid();
+
+    std::vector<std::promise<core::net::http::Response>> promises(5);
+
+    // All requests are in flight before the client starts to carry out transfers.
+    for (auto& promise : promises)
+    {
+        auto p = &promise;
+        client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                    http::Request::Handler()
+                        .on_response([p](const core::net::http::Response& response)
+                        {
+                            p->set_value(response);
+                        })
+                        .on_error([p](const core::net::Error& e)
+                        {
+                            p->set_exception(std::make_exception_ptr(e));
+                        }));
+    }
+
+    std::thread worker{[client]() { client->run(); }};
+
+    auto first = promises.front().get_future().get();
+    EXPECT_EQ(core::net::http::Status::ok, first.status);
+
+    // A separate transfer for each request would have yielded a different UUID each.
+    for (std::size_t i = 1; i < promises.size(); i++)
+        EXPECT_EQ(first.body, promises[i].get_future().get().body);
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
+TEST(HttpClient, identical_get_requests_with_progress_handlers_share_a_single_transfer)
+{
+    http::Client::Configuration configuration;
+    configuration.coalescing.enabled = true;
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::uuid();
+
+    std::vector<std::promise<core::net::http::Response>> promises(3);
+
+    for (auto& promise : promises)
+    {
+        auto p = &promise;
+        client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                    http::Request::Handler()
+                        .on_progress(default_progress_reporter)
+                        .on_response([p](const core::net::http::Response& response)
+                        {
+                            p->set_value(response);
+                        })
+                        .on_error([p](const core::net::Error& e)
+                        {
+                            p->set_exception(std::make_exception_ptr(e));
+                        }));
+    }
+
+    std::thread worker{[client]() { client->run(); }};
+
+    auto first = promises.front().get_future().get();
+    EXPECT_EQ(core::net::http::Status::ok, first.status);
+
+    for (std::size_t i = 1; i < promises.size(); i++)
+        EXPECT_EQ(first.body, promises[i].get_future().get().body);
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
+TEST(HttpClient, identical_get_requests_executed_synchronously_share_a_single_transfer)
+{
+    struct Recorder : public http::Client::Observer
+    {
+        void on_event(const http::Client::TraceEvent& event) override
+        {
+            if (event.kind == http::Client::TraceEvent::Kind::created)
+                created++;
+        }
+
+        std::atomic<int> created{0};
+    };
+
+    auto recorder = std::make_shared<Recorder>();
+
+    http::Client::Configuration configuration;
+    configuration.coalescing.enabled = true;
+    configuration.tracing.observer = recorder;
+
+    auto client = http::make_client(configuration);
+
+    // Slow enough for all threads to join the transfer of the first one.
+    auto url = httpbin::host() + httpbin::resources::delay(std::chrono::milliseconds{500});
+
+    std::vector<std::thread> threads;
+    std::atomic<int> succeeded{0};
+
+    for (int i = 0; i < 3; i++)
+        threads.emplace_back([client, url, &succeeded]()
+        {
+            auto response = client->get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter);
+            if (response.status == core::net::http::Status::ok)
+                succeeded++;
+        });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(3, succeeded.load());
+    EXPECT_EQ(1, recorder->created.load());
+}
+
+TEST(HttpClient, identical_get_requests_with_options_of_their_own_do_not_share_a_transfer)
+{
+    http::Client::Configuration configuration;
+    configuration.coalescing.enabled = true;
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::uuid();
+
+    std::vector<std::promise<core::net::http::Response>> promises(3);
+
+    for (std::size_t i = 0; i < promises.size(); i++)
+    {
+        auto p = &promises[i];
+        auto request = client->get(http::Request::Configuration::from_uri_as_string(url));
+
+        // All but the first request have a timeout.
+        if (i > 0)
+            request->set_timeout(std::chrono::seconds{10});
+
+        auto handler = http::Request::Handler()
+                .on_response([p](const core::net::http::Response& response)
+                {
+                    p->set_value(response);
+                })
+                .on_error([p](const core::net::Error& e)
+                {
+                    p->set_exception(std::make_exception_ptr(e));
+                });
+
+        request->async_execute(handler);
+    }
+
+    std::thread worker{[client]() { client->run(); }};
+
+    std::set<std::string> bodies;
+    for (auto& promise : promises)
+    {
+        auto response = promise.get_future().get();
+        EXPECT_EQ(core::net::http::Status::ok, response.status);
+        bodies.insert(response.body);
+    }
+
+    // Each request carried out a transfer of its own, yielding a different UUID each.
+    EXPECT_EQ(promises.size(), bodies.size());
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
+TEST(HttpClient, endpoint_metrics_break_down_requests_by_route)
+{
+    http::Client::Configuration configuration;
+    configuration.metrics.endpoints = 4;
+
+    auto client = http::make_client(configuration);
+
+    auto request_config = http::Request::Configuration::from_uri_as_string(
+                httpbin::host() + httpbin::resources::get());
+    request_config.route = "/get";
+
+    for (int i = 0; i < 3; i++)
+        EXPECT_EQ(core::net::http::Status::ok,
+                  client->get(request_config)->execute(http::Request::ProgressHandler{}).status);
+
+    auto metrics = client->endpoint_metrics();
+    ASSERT_EQ(1u, metrics.size());
+
+    EXPECT_EQ("/get", metrics.front().route);
+    EXPECT_FALSE(metrics.front().overflow);
+    EXPECT_EQ(3u, metrics.front().requests);
+    EXPECT_EQ(3u, metrics.front().responses.success);
+    EXPECT_TRUE(metrics.front().errors.empty());
+    EXPECT_LT(0u, metrics.front().bytes_received);
+    EXPECT_EQ(3u, metrics.front().timings.total.histogram.count());
+}
+
+TEST(HttpClient, write_metrics_renders_transfers_in_open_metrics_format)
+{
+    auto client = http::make_client();
+
+    auto request_config = http::Request::Configuration::from_uri_as_string(
+                httpbin::host() + httpbin::resources::get());
+
+    EXPECT_EQ(core::net::http::Status::ok,
+              client->get(request_config)->execute(http::Request::ProgressHandler{}).status);
+
+    auto statistics = client->transfer_statistics();
+    EXPECT_EQ(0u, statistics.in_flight);
+    EXPECT_EQ(1u, statistics.completed);
+    EXPECT_EQ(1u, statistics.connections_opened + statistics.connections_reused);
+
+    std::ostringstream out;
+    client->write_metrics(out);
+
+    auto metrics = out.str();
+    EXPECT_NE(std::string::npos, metrics.find("\nnet_cpp_transfers_total 1\n"));
+    EXPECT_NE(std::string::npos, metrics.find("\nnet_cpp_transfer_phase_seconds_count{phase=\"total\"} 1\n"));
+    EXPECT_NE(std::string::npos, metrics.find("\nnet_cpp_transfer_phase_seconds_bucket{phase=\"total\",le=\"+Inf\"} 1\n"));
+    ASSERT_LE(6u, metrics.size());
+    EXPECT_EQ("# EOF\n", metrics.substr(metrics.size() - 6));
+}
+
+TEST(HttpClient, response_describes_the_transfer_it_resulted_from)
+{
+    auto client = http::make_client();
+
+    auto request_config = http::Request::Configuration::from_uri_as_string(
+                httpbin::host() + httpbin::resources::get());
+
+    auto response = client->get(request_config)->execute(http::Request::ProgressHandler{});
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+
+    // Synchronous requests never share connections.
+    EXPECT_EQ(1u, response.transfer.connects);
+    EXPECT_FALSE(response.transfer.reused);
+    EXPECT_EQ(0u, response.transfer.redirects);
+    EXPECT_FALSE(response.transfer.http_version.empty());
+    EXPECT_FALSE(response.transfer.local.address.empty());
+    EXPECT_NE(0, response.transfer.local.port);
+    EXPECT_FALSE(response.transfer.remote.address.empty());
+    EXPECT_NE(0, response.transfer.remote.port);
+    EXPECT_LT(0., response.transfer.total.count());
+
+    EXPECT_EQ(0., client->transfer_statistics().connection_reuse_ratio);
+}
+
+TEST(HttpClient, slow_callbacks_on_the_reactor_are_reported)
+{
+    std::promise<http::Client::SlowCallback> reported;
+
+    http::Client::Configuration configuration;
+    configuration.reactor.probe_interval = std::chrono::milliseconds{5};
+    configuration.reactor.slow_callback_threshold = std::chrono::milliseconds{10};
+    configuration.reactor.on_slow_callback = [&reported](const http::Client::SlowCallback& callback)
+    {
+        reported.set_value(callback);
+    };
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::get();
+
+    std::promise<void> done;
+
+    client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                http::Request::Handler()
+                    .on_response([&done](const core::net::http::Response&)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+                        done.set_value();
+                    }));
+
+    std::thread worker{[client]() { client->run(); }};
+
+    done.get_future().wait();
+
+    auto callback = reported.get_future().get();
+    EXPECT_EQ(http::Client::SlowCallback::Kind::response, callback.kind);
+    EXPECT_LE(0.05, callback.duration.count());
+    EXPECT_EQ(url, callback.uri);
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+
+    auto statistics = client->reactor_statistics();
+    EXPECT_EQ(1u, statistics.slow_callbacks);
+    EXPECT_EQ(1u, statistics.callbacks.count());
+    EXPECT_LT(0u, statistics.loop_lag.count());
+}
+
+TEST(HttpClient, responses_are_delivered_on_the_configured_executor)
+{
+    http::Client::Configuration configuration;
+    configuration.callbacks.executor = core::net::make_thread_pool_executor(2);
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::get();
+
+    std::promise<std::thread::id> delivered;
+
+    client->get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                http::Request::Handler()
+                    .on_response([&delivered](const core::net::http::Response& response)
+                    {
+                        EXPECT_EQ(core::net::http::Status::ok, response.status);
+                        delivered.set_value(std::this_thread::get_id());
+                    }));
+
+    std::thread worker{[client]() { client->run(); }};
+
+    // The reactor does not run the handler, it runs on a thread of the pool.
+    EXPECT_NE(worker.get_id(), delivered.get_future().get());
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
+TEST(HttpClient, requests_report_the_steps_they_pass_to_the_observer)
+{
+    struct Recorder : public http::Client::Observer
+    {
+        void on_event(const http::Client::TraceEvent& event) override
+        {
+            events.push_back(event);
+        }
+
+        std::vector<http::Client::TraceEvent> events;
+    };
+
+    auto recorder = std::make_shared<Recorder>();
+
+    http::Client::Configuration configuration;
+    configuration.tracing.observer = recorder;
+
+    auto client = http::make_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::get();
+
+    auto response = client->get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter);
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+
+    typedef http::Client::TraceEvent::Kind Kind;
+
+    std::vector<Kind> kinds;
+    for (const auto& event : recorder->events)
+    {
+        EXPECT_EQ(recorder->events.front().request, event.request);
+        kinds.push_back(event.kind);
+    }
+
+    // A fresh client has to connect, chunks are not reported unless asked for.
+    std::vector<Kind> expected
+    {
+        Kind::created, Kind::queued, Kind::name_look_up_started, Kind::name_look_up_finished,
+        Kind::connected, Kind::first_byte, Kind::completed, Kind::released
+    };
+    EXPECT_EQ(expected, kinds);
+}
+
 TEST(HttpClient, get_request_for_http_headers_checking)
 {
     // We obtain a default client instance, dispatching to the default implementation.
     auto client = http::make_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->head(http::Request::Configuration::from_uri_as_string(url));
@@ -31,8 +31,13 @@
 
 #include <json/json.h>
 
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <fstream>
 #include <iomanip>
@@ -123,7 +128,7 @@ TEST(StreamingStreamingHttpClient, head_request_for_existing_resource_succeeds)
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->streaming_head(http::Request::Configuration::from_uri_as_string(url));
@@ -146,7 +151,7 @@ TEST(StreamingHttpClient, get_request_for_existing_resource_succeeds)
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->streaming_get(http::Request::Configuration::from_uri_as_string(url));
@@ -177,7 +182,7 @@ TEST(StreamingHttpClient, get_request_with_custom_headers_for_existing_resource_
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::headers();
+    auto url = httpbin::host() + httpbin::resources::headers();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -216,7 +221,7 @@ TEST(StreamingHttpClient, empty_header_values_are_handled_correctly)
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::headers();
+    auto url = httpbin::host() + httpbin::resources::headers();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -252,7 +257,7 @@ TEST(StreamingHttpClient, get_request_for_existing_resource_guarded_by_basic_aut
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::basic_auth();
+    auto url = httpbin::host() + httpbin::resources::basic_auth();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -291,7 +296,7 @@ TEST(StreamingHttpClient, DISABLED_get_request_for_existing_resource_guarded_by_
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::digest_auth();
+    auto url = httpbin::host() + httpbin::resources::digest_auth();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -332,7 +337,7 @@ TEST(StreamingHttpClient, async_get_request_for_existing_resource_succeeds)
     std::thread worker{[client]() { client->run(); }};
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::get();
+    auto url = httpbin::host() + httpbin::resources::get();
 
     // The client mostly acts as a factory for http requests.
     auto request = client->streaming_get(http::Request::Configuration::from_uri_as_string(url));
@@ -388,7 +393,7 @@ TEST(StreamingHttpClient, async_get_request_for_existing_resource_guarded_by_bas
     std::thread worker{[client]() { client->run(); }};
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::basic_auth();
+    auto url = httpbin::host() + httpbin::resources::basic_auth();
 
     // The client mostly acts as a factory for http requests.
     auto configuration = http::Request::Configuration::from_uri_as_string(url);
@@ -443,6 +448,202 @@ TEST(StreamingHttpClient, async_get_request_for_existing_resource_guarded_by_bas
     EXPECT_EQ("user", root["user"].asString());
 }
 
+TEST(StreamingHttpClient, get_request_for_resource_cached_on_disk_survives_restarts_of_client)
+{
+    using namespace ::testing;
+
+    char directory[] = "/tmp/net-cpp-cache-XXXXXX";
+    ASSERT_NE(nullptr, ::mkdtemp(directory));
+
+    // Everything goes to disk, nothing is kept in memory.
+    http::Client::Configuration configuration;
+    configuration.cache.disk.directory = directory;
+    configuration.cache.disk.capacity = 10 * 1024 * 1024;
+    configuration.cache.disk.threshold = 0;
+
+    auto url = httpbin::host() + httpbin::resources::cache_for_a_minute();
+
+    http::Response first;
+    {
+        auto client = http::make_streaming_client(configuration);
+        first = client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter, [](const std::string&) {});
+        EXPECT_EQ(1u, client->cache_statistics().entries);
+    }
+
+    auto client = http::make_streaming_client(configuration);
+
+    // The cached body is handed to the data handler as if it came from the network.
+    auto dh = MockDataHandler::create(); EXPECT_CALL(*dh, on_new_data(first.body)).Times(1);
+
+    auto second = client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter, dh->to_data_handler());
+
+    EXPECT_EQ(core::net::http::Status::ok, second.status);
+    EXPECT_EQ(first.body, second.body);
+
+    auto statistics = client->cache_statistics();
+    EXPECT_EQ(1u, statistics.hits);
+    EXPECT_EQ(0u, statistics.misses);
+
+    std::system((std::string{"rm -rf "} + directory).c_str());
+}
+
+TEST(StreamingHttpClient, revalidated_resource_cached_on_disk_keeps_its_body)
+{
+    char directory[] = "/tmp/net-cpp-cache-XXXXXX";
+    ASSERT_NE(nullptr, ::mkdtemp(directory));
+
+    http::Client::Configuration configuration;
+    configuration.cache.disk.directory = directory;
+    configuration.cache.disk.capacity = 10 * 1024 * 1024;
+    configuration.cache.disk.threshold = 0;
+
+    auto client = http::make_streaming_client(configuration);
+    auto url = httpbin::host() + httpbin::resources::cache();
+
+    auto first = client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter, [](const std::string&) {});
+    auto size = client->cache_statistics().size;
+
+    // Each 304 updates the metadata of the entry, which has to stay readable together with its body.
+    for (int i = 0; i < 3; i++)
+    {
+        auto response = client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter, [](const std::string&) {});
+
+        EXPECT_EQ(core::net::http::Status::ok, response.status);
+        EXPECT_EQ(first.body, response.body);
+    }
+
+    auto statistics = client->cache_statistics();
+    EXPECT_EQ(3u, statistics.revalidations);
+    EXPECT_EQ(1u, statistics.entries);
+    EXPECT_EQ(size, statistics.size);
+
+    std::system((std::string{"rm -rf "} + directory).c_str());
+}
+
+TEST(StreamingHttpClient, revalidated_resource_cached_on_disk_stays_there_if_the_threshold_is_raised)
+{
+    char directory[] = "/tmp/net-cpp-cache-XXXXXX";
+    ASSERT_NE(nullptr, ::mkdtemp(directory));
+
+    http::Client::Configuration configuration;
+    configuration.cache.disk.directory = directory;
+    configuration.cache.disk.capacity = 10 * 1024 * 1024;
+    configuration.cache.disk.threshold = 0;
+
+    auto url = httpbin::host() + httpbin::resources::cache();
+
+    http::Response first;
+    {
+        auto client = http::make_streaming_client(configuration);
+        first = client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter, [](const std::string&) {});
+    }
+
+    // The body would be kept in memory now, but the entry is validated from disk.
+    {
+        auto raised = configuration;
+        raised.cache.capacity = 10 * 1024 * 1024;
+        raised.cache.disk.threshold = 1024 * 1024;
+
+        auto client = http::make_streaming_client(raised);
+        auto response = client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter, [](const std::string&) {});
+
+        EXPECT_EQ(first.body, response.body);
+        EXPECT_EQ(1u, client->cache_statistics().revalidations);
+    }
+
+    // Which leaves it on disk, instead of copying it to memory.
+    auto client = http::make_streaming_client(configuration);
+    auto response = client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->execute(default_progress_reporter, [](const std::string&) {});
+
+    EXPECT_EQ(first.body, response.body);
+
+    auto statistics = client->cache_statistics();
+    EXPECT_EQ(1u, statistics.revalidations);
+    EXPECT_EQ(0u, statistics.misses);
+
+    std::system((std::string{"rm -rf "} + directory).c_str());
+}
+
+TEST(StreamingHttpClient, identical_get_requests_do_not_join_a_transfer_beyond_its_replay_limit)
+{
+    struct Recorder : public http::Client::Observer
+    {
+        void on_event(const http::Client::TraceEvent& event) override
+        {
+            if (event.kind == http::Client::TraceEvent::Kind::created)
+                created++;
+        }
+
+        std::atomic<int> created{0};
+    };
+
+    auto recorder = std::make_shared<Recorder>();
+
+    http::Client::Configuration configuration;
+    configuration.coalescing.enabled = true;
+    configuration.coalescing.replay_limit = 1024;
+    configuration.tracing.observer = recorder;
+
+    auto client = http::make_streaming_client(configuration);
+    std::thread worker{[client]() { client->run(); }};
+
+    const std::size_t size = 4 * 1024 * 1024;
+    auto url = httpbin::host() + httpbin::resources::stream_bytes(size);
+
+    auto on_error = [](const core::net::Error& e) { FAIL() << e.what(); };
+
+    auto request = client->streaming_get(http::Request::Configuration::from_uri_as_string(url));
+    std::weak_ptr<http::StreamingRequest> weak{request};
+
+    std::promise<void> first, overflowed;
+    std::size_t chunks{0};
+
+    // The first request pauses once it handed out more than the replay limit.
+    request->async_execute(
+                http::Request::Handler()
+                    .on_response([&first](const core::net::http::Response&) { first.set_value(); })
+                    .on_error(on_error),
+                [&chunks, &overflowed, weak](const std::string&)
+                {
+                    if (++chunks != 2)
+                        return;
+
+                    if (auto request = weak.lock())
+                        request->pause();
+
+                    overflowed.set_value();
+                });
+
+    overflowed.get_future().wait();
+
+    std::promise<std::size_t> late;
+    auto late_received = std::make_shared<std::size_t>(0);
+
+    client->streaming_get(http::Request::Configuration::from_uri_as_string(url))->async_execute(
+                http::Request::Handler()
+                    .on_response([&late, late_received](const core::net::http::Response&)
+                    {
+                        late.set_value(*late_received);
+                    })
+                    .on_error(on_error),
+                [late_received](const std::string& chunk) { *late_received += chunk.size(); });
+
+    request->resume();
+
+    auto future = late.get_future();
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{30}));
+    first.get_future().wait();
+
+    // The late request carried out a transfer of its own and received the whole body.
+    EXPECT_EQ(size, future.get());
+    EXPECT_EQ(2, recorder->created.load());
+
+    client->stop();
+
+    if (worker.joinable())
+        worker.join();
+}
+
 TEST(StreamingHttpClient, post_request_for_existing_resource_succeeds)
 {
     using namespace ::testing;
@@ -451,7 +652,7 @@ TEST(StreamingHttpClient, post_request_for_existing_resource_succeeds)
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
 
     std::string payload = "{ 'test': 'test' }";
 
@@ -486,7 +687,7 @@ TEST(StreamingHttpClient, post_form_request_for_existing_resource_succeeds)
     auto client = http::make_streaming_client();
 
     // Url pointing to the resource we would like to access via http.
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
 
     std::map<std::string, std::string> values
     {
@@ -517,7 +718,7 @@ TEST(StreamingHttpClient, post_request_for_file_with_large_chunk_succeeds)
     using namespace ::testing;
 
     auto client = http::make_streaming_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
   
     // create temp file with large chunk
     const std::size_t size = 1024*1024;
@@ -548,7 +749,7 @@ TEST(StreamingHttpClient, post_request_for_file_with_large_chunk_with_read_callb
     using namespace ::testing;
 
     auto client = http::make_streaming_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::post();
+    auto url = httpbin::host() + httpbin::resources::post();
   
     // create temp file with large chunk
     const std::size_t size = 1024*1024;
@@ -576,12 +777,241 @@ TEST(StreamingHttpClient, post_request_for_file_with_large_chunk_with_read_callb
     EXPECT_EQ(url, root["url"].asString());
 }
 
+namespace
+{
+// Posts pieces with chunked transfer-encoding, handing each of them
+// to the producer a little later than the request asks for it.
+core::net::http::Response post_chunked_piece_by_piece(const http::Request::Configuration& configuration,
+                                                      const std::vector<std::string>& pieces,
+                                                      std::size_t& pauses)
+{
+    auto client = http::make_streaming_client();
+    std::thread worker{[client]() { client->run(); }};
+
+    std::mutex guard;
+    std::string pending;
+    bool done{false};
+
+    auto request = client->streaming_post_chunked(configuration, [&](void* dest, std::size_t size) -> std::size_t
+    {
+        std::lock_guard<std::mutex> lg(guard);
+
+        if (pending.empty())
+        {
+            if (done)
+                return http::StreamingClient::end_of_body;
+
+            pauses++;
+            return http::StreamingClient::no_data_yet;
+        }
+
+        auto n = std::min(size, pending.size());
+        std::memcpy(dest, pending.data(), n);
+        pending.erase(0, n);
+        return n;
+    }, "text/plain");
+
+    std::promise<core::net::http::Response> promise;
+    auto future = promise.get_future();
+
+    request->async_execute(http::Request::Handler()
+        .on_response([&](const core::net::http::Response& response)
+        {
+            promise.set_value(response);
+        })
+        .on_error([&](const core::net::Error& e)
+        {
+            promise.set_exception(std::make_exception_ptr(e));
+        }),
+        [](const std::string&) {});
+
+    for (std::size_t i = 0; i < pieces.size(); i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        {
+            std::lock_guard<std::mutex> lg(guard);
+            pending += pieces[i];
+            done = i + 1 == pieces.size();
+        }
+        request->resume();
+    }
+
+    auto response = future.get();
+
+    client->stop();
+    if (worker.joinable())
+        worker.join();
+
+    return response;
+}
+}
+
+TEST(StreamingHttpClient, chunked_post_request_pauses_until_producer_has_data)
+{
+    auto url = httpbin::host() + httpbin::resources::post();
+    std::vector<std::string> pieces{"first line\n", "second line\n", std::string(100000, 'x')};
+    std::size_t pauses{0};
+
+    auto response = post_chunked_piece_by_piece(http::Request::Configuration::from_uri_as_string(url), pieces, pauses);
+
+    json::Value root;
+    json::Reader reader;
+
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    EXPECT_TRUE(reader.parse(response.body, root));
+    EXPECT_EQ(pieces[0] + pieces[1] + pieces[2], root["data"].asString());
+    EXPECT_EQ("chunked", root["headers"]["Transfer-Encoding"].asString());
+    EXPECT_EQ("text/plain", root["headers"]["Content-Type"].asString());
+    EXPECT_LE(pieces.size(), pauses);
+}
+
+TEST(StreamingHttpClient, compressed_chunked_post_request_pauses_until_producer_has_data)
+{
+    auto url = httpbin::host() + httpbin::resources::post();
+    std::vector<std::string> pieces{"first line\n", "second line\n"};
+    std::size_t pauses{0};
+
+    auto configuration = http::Request::Configuration::from_uri_as_string(url);
+    configuration.upload.compression = http::Request::Compression::gzip;
+
+    auto response = post_chunked_piece_by_piece(configuration, pieces, pauses);
+
+    json::Value root;
+    json::Reader reader;
+
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    EXPECT_TRUE(reader.parse(response.body, root));
+    EXPECT_EQ("gzip", root["headers"]["Content-Encoding"].asString());
+    EXPECT_EQ("chunked", root["headers"]["Transfer-Encoding"].asString());
+    EXPECT_EQ(pieces[0] + pieces[1], httpbin::inflated(root["data"].asString()));
+    EXPECT_LE(pieces.size(), pauses);
+}
+
+TEST(StreamingHttpClient, chunked_post_request_executes_synchronously)
+{
+    auto client = http::make_streaming_client();
+    auto url = httpbin::host() + httpbin::resources::post();
+
+    std::vector<std::string> pieces{"first line\n", "second line\n"};
+    std::size_t next{0};
+
+    auto request = client->streaming_post_chunked(http::Request::Configuration::from_uri_as_string(url),
+                                                  [&](void* dest, std::size_t size) -> std::size_t
+    {
+        if (next == pieces.size())
+            return http::StreamingClient::end_of_body;
+
+        auto n = std::min(size, pieces[next].size());
+        std::memcpy(dest, pieces[next++].data(), n);
+        return n;
+    }, "text/plain");
+
+    auto response = request->execute([](const http::Request::Progress&) { return http::Request::Progress::Next::continue_operation; },
+                                     [](const std::string&) {});
+
+    json::Value root;
+    json::Reader reader;
+
+    EXPECT_EQ(core::net::http::Status::ok, response.status);
+    EXPECT_TRUE(reader.parse(response.body, root));
+    EXPECT_EQ(pieces[0] + pieces[1], root["data"].asString());
+    EXPECT_EQ("chunked", root["headers"]["Transfer-Encoding"].asString());
+}
+
+TEST(StreamingHttpClient, chunked_post_request_executed_synchronously_fails_if_producer_has_no_data_yet)
+{
+    auto client = http::make_streaming_client();
+    auto url = httpbin::host() + httpbin::resources::post();
+
+    auto request = client->streaming_post_chunked(http::Request::Configuration::from_uri_as_string(url),
+                                                  [](void*, std::size_t) -> std::size_t
+    {
+        return http::StreamingClient::no_data_yet;
+    }, "text/plain");
+
+    // Nothing could resume the upload, so it must not hang.
+    EXPECT_THROW(request->execute([](const http::Request::Progress&) { return http::Request::Progress::Next::continue_operation; },
+                                  [](const std::string&) {}),
+                 std::runtime_error);
+}
+
+TEST(StreamingHttpClient, event_source_reconnects_asking_for_events_following_the_last_one)
+{
+    auto client = http::make_streaming_client();
+    std::thread worker{[client]() { client->run(); }};
+
+    // Every connection hands out 3 events, with ids following Last-Event-ID.
+    auto url = httpbin::host() + httpbin::resources::event_stream(3);
+
+    std::mutex guard;
+    std::vector<std::string> ids;
+    std::promise<void> promise;
+    auto future = promise.get_future();
+
+    auto source = client->open_event_source(
+                http::Request::Configuration::from_uri_as_string(url),
+                [&](const http::EventStream::Event& event)
+                {
+                    EXPECT_EQ("tick", event.type);
+                    EXPECT_EQ(event.id, event.data);
+                    EXPECT_EQ(std::chrono::milliseconds{10}, event.retry);
+
+                    std::lock_guard<std::mutex> lg(guard);
+                    if (ids.size() < 7)
+                    {
+                        ids.push_back(event.id);
+                        if (ids.size() == 7)
+                            promise.set_value();
+                    }
+                },
+                [](const core::net::Error& e)
+                {
+                    ADD_FAILURE() << e.what();
+                });
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{10}));
+    source->close();
+
+    EXPECT_EQ((std::vector<std::string>{"1", "2", "3", "4", "5", "6", "7"}), ids);
+
+    client->stop();
+    if (worker.joinable())
+        worker.join();
+}
+
+TEST(StreamingHttpClient, event_source_gives_up_on_status_other_than_200)
+{
+    auto client = http::make_streaming_client();
+    std::thread worker{[client]() { client->run(); }};
+
+    auto url = httpbin::host() + httpbin::resources::status(404);
+
+    std::promise<core::net::http::Status> promise;
+    auto future = promise.get_future();
+
+    auto source = client->open_event_source(
+                http::Request::Configuration::from_uri_as_string(url),
+                [](const http::EventStream::Event&) {},
+                [&promise](const core::net::Error& e)
+                {
+                    auto failed = dynamic_cast<const http::EventSource::Errors::ConnectionFailed*>(&e);
+                    promise.set_value(failed ? failed->status : core::net::http::Status::ok);
+                });
+
+    ASSERT_EQ(std::future_status::ready, future.wait_for(std::chrono::seconds{10}));
+    EXPECT_EQ(core::net::http::Status::not_found, future.get());
+
+    client->stop();
+    if (worker.joinable())
+        worker.join();
+}
+
 TEST(StreamingHttpClient, put_request_for_existing_resource_succeeds)
 {
     using namespace ::testing;
 
     auto client = http::make_streaming_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::put();
+    auto url = httpbin::host() + httpbin::resources::put();
 
     const std::string value{"{ 'test': 'test' }"};
     std::stringstream payload(value);
@@ -608,7 +1038,7 @@ TEST(StreamingHttpClient, put_request_for_file_with_large_chunk_succeeds)
     using namespace ::testing;
 
     auto client = http::make_streaming_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::put();
+    auto url = httpbin::host() + httpbin::resources::put();
   
     // create temp file with large chunk
     const std::size_t size = 1024*1024;
@@ -639,7 +1069,7 @@ TEST(StreamingHttpClient, put_request_for_file_with_large_chunk_with_read_callba
     using namespace ::testing;
 
     auto client = http::make_streaming_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::put();
+    auto url = httpbin::host() + httpbin::resources::put();
   
     // create temp file with large chunk
     const std::size_t size = 1024*1024;
@@ -672,7 +1102,7 @@ TEST(StreamingHttpClient, del_request_for_existing_resource_succeeds)
     using namespace ::testing;
 
     auto client = http::make_streaming_client();
-    auto url = std::string(httpbin::host) + httpbin::resources::del();
+    auto url = httpbin::host() + httpbin::resources::del();
   
     auto request = client->streaming_del(http::Request::Configuration::from_uri_as_string(url));
   
@@ -698,13 +1128,27 @@ TEST(StreamingHttpClient, request_can_be_paused_and_resumed)
     // Execute the client
     std::thread worker{[client]() { client->run(); }};
 
-    auto url = "http://archive.ubuntu.com/ubuntu/dists/xenial/main/installer-amd64/current/images/netboot/ubuntu-installer/amd64/linux";
+    // Large enough to still be in flight when pausing.
+    const std::size_t size = 32 * 1024 * 1024;
+    auto url = httpbin::host() + httpbin::resources::stream_bytes(size);
 
     // The client mostly acts as a factory for http requests.
     auto request = client->streaming_get(http::Request::Configuration::from_uri_as_string(url));
 
-    // Our mocked data handler.
-    auto dh = MockDataHandler::create(); EXPECT_CALL(*dh, on_new_data(_)).Times(AtLeast(1));
+    // Pauses the request as soon as the first chunk arrives, such that the
+    // transfer is guaranteed to still be in flight.
+    std::atomic<std::size_t> received{0};
+    std::promise<void> first_chunk;
+    std::weak_ptr<http::StreamingRequest> weak{request};
+    auto dh = [&received, &first_chunk, weak](const std::string& chunk)
+    {
+        if (received.fetch_add(chunk.size()) == 0)
+        {
+            if (auto request = weak.lock())
+                request->pause();
+            first_chunk.set_value();
+        }
+    };
 
     std::promise<core::net::http::Response> promise;
     auto future = promise.get_future();
@@ -729,11 +1173,17 @@ TEST(StreamingHttpClient, request_can_be_paused_and_resumed)
         {
             promise.set_exception(std::make_exception_ptr(e));
         }),
-        dh->to_data_handler());
+        dh);
+
+    first_chunk.get_future().wait();
 
-    std::this_thread::sleep_for(std::chrono::seconds(2));
+    // Pausing is dispatched to the reactor, give it time to take effect.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    auto paused_at = received.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(paused_at, received.load());
+    EXPECT_LT(paused_at, size);
 
-    request->pause();
     request->resume();
 
     try
@@ -742,6 +1192,8 @@ TEST(StreamingHttpClient, request_can_be_paused_and_resumed)
         EXPECT_EQ(core::net::http::Status::ok, future.get().status);
     } catch (const std::exception& e) { FAIL() << e.what(); }
 
+    EXPECT_EQ(size, received.load());
+
     client->stop();
 
     // We shut down our worker thread
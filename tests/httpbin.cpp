@@ -0,0 +1,1509 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include "httpbin.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE (1u << 28)
+#endif
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+// Upper bounds protecting the instance against broken clients.
+constexpr const std::size_t max_head_size{64 * 1024};
+constexpr const std::size_t max_body_size{256 * 1024 * 1024};
+// Upper bound on the delay a client can ask for, as on httpbin.org.
+constexpr const double max_delay_in_seconds{10};
+// Size of the chunks handed out by /stream-bytes, unless asked for differently.
+constexpr const std::size_t default_chunk_size{10 * 1024};
+
+// Port of the first instance started in this process, see httpbin::host().
+std::atomic<std::uint16_t> first_port{0};
+
+std::string url_for(std::uint16_t port)
+{
+    return "http://127.0.0.1:" + std::to_string(port);
+}
+
+std::system_error last_error(const char* what)
+{
+    return std::system_error(errno, std::system_category(), what);
+}
+
+bool iequals(const std::string& lhs, const std::string& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char l, char r)
+    {
+        return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+    });
+}
+
+std::string trim(const std::string& s)
+{
+    static constexpr const char* whitespace{" \t"};
+
+    auto begin = s.find_first_not_of(whitespace);
+    if (begin == std::string::npos)
+        return std::string{};
+
+    return s.substr(begin, s.find_last_not_of(whitespace) - begin + 1);
+}
+
+// Spells header field names like httpbin.org does, e.g., "content-type" as "Content-Type".
+std::string title_case(std::string name)
+{
+    bool start{true};
+
+    for (auto& c : name)
+    {
+        auto u = static_cast<unsigned char>(c);
+        c = static_cast<char>(start ? std::toupper(u) : std::tolower(u));
+        start = c == '-';
+    }
+
+    return name;
+}
+
+// Decodes %XX sequences and '+' as used in query strings and form bodies.
+std::string url_decode(const std::string& s)
+{
+    std::string result;
+    result.reserve(s.size());
+
+    for (std::size_t i = 0; i < s.size(); i++)
+    {
+        if (s[i] == '+')
+            result.push_back(' ');
+        else if (s[i] == '%' && i + 2 < s.size() &&
+                 std::isxdigit(static_cast<unsigned char>(s[i + 1])) &&
+                 std::isxdigit(static_cast<unsigned char>(s[i + 2])))
+        {
+            result.push_back(static_cast<char>(std::stoi(s.substr(i + 1, 2), nullptr, 16)));
+            i += 2;
+        } else
+            result.push_back(s[i]);
+    }
+
+    return result;
+}
+
+std::map<std::string, std::string> parse_pairs(const std::string& s)
+{
+    std::map<std::string, std::string> result;
+    std::istringstream in{s};
+    std::string pair;
+
+    while (std::getline(in, pair, '&'))
+    {
+        if (pair.empty())
+            continue;
+
+        auto equals = pair.find('=');
+        result[url_decode(pair.substr(0, equals))] =
+                equals == std::string::npos ? std::string{} : url_decode(pair.substr(equals + 1));
+    }
+
+    return result;
+}
+
+const std::string base64_alphabet{"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"};
+
+std::string base64_encode(const std::string& in)
+{
+    std::string result;
+    std::uint32_t buffer{0};
+    int bits{0};
+
+    for (auto c : in)
+    {
+        buffer = (buffer << 8) | static_cast<unsigned char>(c);
+        bits += 8;
+
+        while (bits >= 6)
+        {
+            bits -= 6;
+            result.push_back(base64_alphabet[(buffer >> bits) & 0x3f]);
+        }
+    }
+
+    if (bits > 0)
+        result.push_back(base64_alphabet[(buffer << (6 - bits)) & 0x3f]);
+
+    while (result.size() % 4 != 0)
+        result.push_back('=');
+
+    return result;
+}
+
+std::string base64_decode(const std::string& in)
+{
+    const auto& alphabet = base64_alphabet;
+
+    std::string result;
+    std::uint32_t buffer{0};
+    int bits{0};
+
+    for (auto c : in)
+    {
+        auto value = alphabet.find(c);
+        if (value == std::string::npos)
+            break;
+
+        buffer = (buffer << 6) | value;
+        bits += 6;
+
+        if (bits >= 8)
+        {
+            bits -= 8;
+            result.push_back(static_cast<char>((buffer >> bits) & 0xff));
+        }
+    }
+
+    return result;
+}
+
+// MD5 as specified in RFC 1321, as required by digest authentication.
+std::string md5(const std::string& message)
+{
+    static const std::uint32_t k[64] =
+    {
+        0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+        0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+        0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+        0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+        0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+        0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+        0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+        0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+    };
+
+    static const int shifts[64] =
+    {
+        7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+        5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+        4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+        6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+    };
+
+    std::uint32_t h[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+    std::string padded{message};
+    std::uint64_t length_in_bits = static_cast<std::uint64_t>(message.size()) * 8;
+
+    padded.push_back(static_cast<char>(0x80));
+    while (padded.size() % 64 != 56)
+        padded.push_back(0);
+    for (int i = 0; i < 8; i++)
+        padded.push_back(static_cast<char>((length_in_bits >> (8 * i)) & 0xff));
+
+    for (std::size_t offset = 0; offset < padded.size(); offset += 64)
+    {
+        std::uint32_t m[16];
+        for (int i = 0; i < 16; i++)
+        {
+            auto p = reinterpret_cast<const unsigned char*>(padded.data() + offset + 4 * i);
+            m[i] = p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+        }
+
+        std::uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+
+        for (int i = 0; i < 64; i++)
+        {
+            std::uint32_t f;
+            int g;
+
+            switch (i / 16)
+            {
+            case 0: f = (b & c) | (~b & d); g = i; break;
+            case 1: f = (d & b) | (~d & c); g = (5 * i + 1) % 16; break;
+            case 2: f = b ^ c ^ d; g = (3 * i + 5) % 16; break;
+            default: f = c ^ (b | ~d); g = (7 * i) % 16; break;
+            }
+
+            auto rotated = a + f + k[i] + m[g];
+            a = d;
+            d = c;
+            c = b;
+            b = b + ((rotated << shifts[i]) | (rotated >> (32 - shifts[i])));
+        }
+
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    }
+
+    std::ostringstream out;
+    for (auto word : h)
+        for (int i = 0; i < 4; i++)
+            out << std::hex << std::setw(2) << std::setfill('0') << ((word >> (8 * i)) & 0xff);
+
+    return out.str();
+}
+
+bool is_utf8(const std::string& s)
+{
+    std::size_t continuations{0};
+
+    for (auto c : s)
+    {
+        auto u = static_cast<unsigned char>(c);
+
+        if (continuations > 0)
+        {
+            if ((u & 0xc0) != 0x80)
+                return false;
+            continuations--;
+        } else if (u >= 0xf0 && u < 0xf8)
+            continuations = 3;
+        else if (u >= 0xe0)
+            continuations = u < 0xf0 ? 2 : 4;
+        else if (u >= 0xc0)
+            continuations = 1;
+        else if (u >= 0x80)
+            return false;
+
+        if (continuations > 3)
+            return false;
+    }
+
+    return continuations == 0;
+}
+
+std::string random_hex(std::size_t digits)
+{
+    static std::mutex guard;
+    static std::mt19937_64 generator{std::random_device{}()};
+
+    std::lock_guard<std::mutex> lg(guard);
+
+    std::ostringstream out;
+    for (std::size_t i = 0; i < digits; i++)
+        out << std::hex << (generator() & 0xf);
+
+    return out.str();
+}
+
+std::string http_date(std::time_t t)
+{
+    std::tm tm;
+    gmtime_r(&t, &tm);
+
+    char buffer[64];
+    std::strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+
+    return buffer;
+}
+
+// Minimal JSON output, sufficient for the documents handed out by the endpoints.
+namespace json
+{
+std::string quoted(const std::string& s)
+{
+    std::ostringstream out;
+    out << '"';
+
+    for (auto c : s)
+    {
+        switch (c)
+        {
+        case '"': out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+            else
+                out << c;
+        }
+    }
+
+    out << '"';
+    return out.str();
+}
+
+// Members of an object, with values already encoded as JSON.
+typedef std::vector<std::pair<std::string, std::string>> Members;
+
+std::string object(const Members& members)
+{
+    std::string result{"{"};
+
+    for (const auto& member : members)
+    {
+        if (result.size() > 1)
+            result.append(", ");
+
+        result.append(quoted(member.first)).append(": ").append(member.second);
+    }
+
+    return result.append("}");
+}
+
+std::string object(const std::map<std::string, std::string>& strings)
+{
+    Members members;
+    for (const auto& pair : strings)
+        members.emplace_back(pair.first, quoted(pair.second));
+
+    return object(members);
+}
+}
+
+struct Request
+{
+    // Returns the value of the header field name, joining repeated fields.
+    std::string header(const std::string& name) const
+    {
+        std::string result;
+
+        for (const auto& field : fields)
+        {
+            if (not iequals(field.first, name))
+                continue;
+
+            if (not result.empty())
+                result.push_back(',');
+            result.append(field.second);
+        }
+
+        return result;
+    }
+
+    bool has_header(const std::string& name) const
+    {
+        return std::any_of(fields.begin(), fields.end(), [&name](const std::pair<std::string, std::string>& field)
+        {
+            return iequals(field.first, name);
+        });
+    }
+
+    bool keep_alive() const
+    {
+        auto connection = header("Connection");
+
+        if (version == "HTTP/1.0")
+            return iequals(connection, "keep-alive");
+
+        return not iequals(connection, "close");
+    }
+
+    std::string method;
+    std::string target;
+    std::string version;
+    std::string path;
+    std::string query;
+    std::vector<std::pair<std::string, std::string>> fields;
+    std::string body;
+    std::string origin;
+};
+
+struct Response
+{
+    Response(int status = 200, const std::string& reason = "OK")
+        : status(status),
+          reason(reason)
+    {
+    }
+
+    static Response json(const std::string& body)
+    {
+        Response response;
+        response.fields.emplace_back("Content-Type", "application/json");
+        response.body = body + "\n";
+        return response;
+    }
+
+    int status;
+    std::string reason;
+    std::vector<std::pair<std::string, std::string>> fields;
+    std::string body;
+    // Hands out the body in chunks of the given size if not 0.
+    std::size_t chunk_size{0};
+    std::chrono::milliseconds delay{0};
+};
+
+std::string reason_for(int status)
+{
+    switch (status)
+    {
+    case 100: return "Continue";
+    case 200: return "OK";
+    case 201: return "Created";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 413: return "Payload Too Large";
+    case 418: return "I'm a teapot";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    }
+
+    return "Unknown";
+}
+
+Response status(int code)
+{
+    Response response{code, reason_for(code)};
+    response.fields.emplace_back("Content-Type", "text/plain");
+    response.body = response.reason + "\n";
+
+    return response;
+}
+
+std::string serialize(const Response& response, bool head, bool keep_alive)
+{
+    std::ostringstream out;
+
+    out << "HTTP/1.1 " << response.status << " " << response.reason << "\r\n"
+        << "Server: httpbin\r\n"
+        << "Date: " << http_date(std::time(nullptr)) << "\r\n"
+        << "Access-Control-Allow-Origin: *\r\n"
+        << "Access-Control-Allow-Credentials: true\r\n"
+        << "Connection: " << (keep_alive ? "keep-alive" : "close") << "\r\n";
+
+    for (const auto& field : response.fields)
+        out << field.first << ": " << field.second << "\r\n";
+
+    bool without_body = head || response.status == 304 || response.status == 204;
+
+    if (response.chunk_size > 0)
+        out << "Transfer-Encoding: chunked\r\n";
+    else if (response.status != 304 && response.status != 204)
+        out << "Content-Length: " << response.body.size() << "\r\n";
+
+    out << "\r\n";
+
+    if (without_body)
+        return out.str();
+
+    if (response.chunk_size == 0)
+    {
+        out << response.body;
+        return out.str();
+    }
+
+    for (std::size_t offset = 0; offset < response.body.size(); offset += response.chunk_size)
+    {
+        auto size = std::min(response.chunk_size, response.body.size() - offset);
+        out << std::hex << size << std::dec << "\r\n";
+        out.write(response.body.data() + offset, size);
+        out << "\r\n";
+    }
+
+    out << "0\r\n\r\n";
+    return out.str();
+}
+
+// Splits path into its segments, dropping the leading slash.
+std::vector<std::string> segments_of(const std::string& path)
+{
+    std::vector<std::string> result;
+    std::istringstream in{path.substr(1)};
+    std::string segment;
+
+    while (std::getline(in, segment, '/'))
+        result.push_back(segment);
+
+    return result;
+}
+
+std::string url_of(const Request& request)
+{
+    return "http://" + request.header("Host") + request.target;
+}
+
+std::string headers_of(const Request& request)
+{
+    std::map<std::string, std::string> headers;
+
+    for (const auto& field : request.fields)
+    {
+        auto& value = headers[title_case(field.first)];
+
+        if (not value.empty())
+            value.push_back(',');
+        value.append(field.second);
+    }
+
+    return json::object(headers);
+}
+
+json::Members get_members(const Request& request)
+{
+    return json::Members
+    {
+        {"args", json::object(parse_pairs(request.query))},
+        {"headers", headers_of(request)},
+        {"origin", json::quoted(request.origin)},
+        {"url", json::quoted(url_of(request))}
+    };
+}
+
+// The value of parameter name in a header value like
+// 'form-data; name="field"; filename="a.txt"'.
+std::string parameter_of(const std::string& value, const std::string& name)
+{
+    auto pos = value.find("; " + name + "=");
+    if (pos == std::string::npos)
+        return std::string{};
+
+    pos += name.size() + 3;
+    if (pos < value.size() && value[pos] == '"')
+        return value.substr(pos + 1, value.find('"', pos + 1) - pos - 1);
+
+    return value.substr(pos, value.find(';', pos) - pos);
+}
+
+// Splits a multipart/form-data body into fields and files, returns false if it is malformed.
+bool parse_multipart(const std::string& body,
+                     const std::string& boundary,
+                     std::map<std::string, std::string>& form,
+                     std::map<std::string, std::string>& files)
+{
+    const auto delimiter = "--" + boundary;
+
+    if (body.compare(0, delimiter.size(), delimiter) != 0)
+        return false;
+
+    auto pos = delimiter.size();
+    while (body.compare(pos, 2, "--") != 0)
+    {
+        if (body.compare(pos, 2, "\r\n") != 0)
+            return false;
+
+        auto headers_end = body.find("\r\n\r\n", pos);
+        auto next = body.find("\r\n" + delimiter, headers_end);
+        if (headers_end == std::string::npos || next == std::string::npos)
+            return false;
+
+        std::string disposition;
+        std::istringstream headers{body.substr(pos + 2, headers_end - pos - 2)};
+        std::string line;
+        while (std::getline(headers, line))
+        {
+            if (not line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            auto colon = line.find(':');
+            if (colon != std::string::npos && iequals(line.substr(0, colon), "Content-Disposition"))
+                disposition = trim(line.substr(colon + 1));
+        }
+
+        auto content = body.substr(headers_end + 4, next - headers_end - 4);
+        if (disposition.find("; filename=") != std::string::npos)
+            files[parameter_of(disposition, "name")] = content;
+        else
+            form[parameter_of(disposition, "name")] = content;
+
+        pos = next + 2 + delimiter.size();
+    }
+
+    return true;
+}
+
+Response echo(const Request& request)
+{
+    auto members = get_members(request);
+
+    auto form = std::map<std::string, std::string>{};
+    auto files = std::map<std::string, std::string>{};
+    auto type = request.header("Content-Type");
+    if (type.find("application/x-www-form-urlencoded") == 0)
+        form = parse_pairs(request.body);
+    else if (type.find("multipart/form-data") == 0 &&
+             not parse_multipart(request.body, parameter_of(type, "boundary"), form, files))
+        return status(400);
+
+    // Like httpbin.org, hand out binary data as a data URI.
+    auto data = is_utf8(request.body) ?
+                request.body :
+                "data:application/octet-stream;base64," + base64_encode(request.body);
+
+    members.emplace_back("data", json::quoted(form.empty() && files.empty() ? data : std::string{}));
+    members.emplace_back("files", json::object(files));
+    members.emplace_back("form", json::object(form));
+    members.emplace_back("json", "null");
+
+    return Response::json(json::object(members));
+}
+
+Response authenticated(const std::string& user)
+{
+    return Response::json(json::object(json::Members{{"authenticated", "true"}, {"user", json::quoted(user)}}));
+}
+
+Response basic_auth(const Request& request, const std::string& user, const std::string& password)
+{
+    auto authorization = request.header("Authorization");
+
+    if (authorization.compare(0, 6, "Basic ") == 0 && base64_decode(trim(authorization.substr(6))) == user + ":" + password)
+        return authenticated(user);
+
+    auto response = status(401);
+    response.fields.emplace_back("WWW-Authenticate", "Basic realm=\"Fake Realm\"");
+    return response;
+}
+
+// Parses the parameters of a digest Authorization header.
+std::map<std::string, std::string> digest_parameters_of(const std::string& authorization)
+{
+    std::map<std::string, std::string> result;
+    std::size_t i{7};
+
+    while (i < authorization.size())
+    {
+        auto equals = authorization.find('=', i);
+        if (equals == std::string::npos)
+            break;
+
+        auto key = trim(authorization.substr(i, equals - i));
+        std::string value;
+
+        i = equals + 1;
+        if (i < authorization.size() && authorization[i] == '"')
+        {
+            auto end = authorization.find('"', i + 1);
+            value = authorization.substr(i + 1, end - i - 1);
+            i = end == std::string::npos ? authorization.size() : end + 1;
+        } else
+        {
+            auto end = authorization.find(',', i);
+            value = trim(authorization.substr(i, end - i));
+            i = end == std::string::npos ? authorization.size() : end;
+        }
+
+        result[key] = value;
+
+        i = authorization.find_first_not_of(", ", i);
+        if (i == std::string::npos)
+            break;
+    }
+
+    return result;
+}
+
+Response digest_auth(const Request& request, const std::string& qop, const std::string& user, const std::string& password)
+{
+    static constexpr const char* realm{"me@kennethreitz.com"};
+
+    auto authorization = request.header("Authorization");
+
+    if (authorization.compare(0, 7, "Digest ") == 0)
+    {
+        auto p = digest_parameters_of(authorization);
+
+        auto ha1 = md5(user + ":" + realm + ":" + password);
+        auto ha2 = md5(request.method + ":" + p["uri"]);
+        auto expected = p["qop"].empty() ?
+                    md5(ha1 + ":" + p["nonce"] + ":" + ha2) :
+                    md5(ha1 + ":" + p["nonce"] + ":" + p["nc"] + ":" + p["cnonce"] + ":" + p["qop"] + ":" + ha2);
+
+        if (p["username"] == user && p["response"] == expected)
+            return authenticated(user);
+    }
+
+    auto response = status(401);
+    response.fields.emplace_back(
+                "WWW-Authenticate",
+                std::string{"Digest realm=\""} + realm + "\", nonce=\"" + random_hex(32) +
+                "\", qop=\"" + qop + "\", opaque=\"" + random_hex(32) + "\", algorithm=MD5");
+    return response;
+}
+
+Response bytes(std::size_t size)
+{
+    Response response;
+    response.fields.emplace_back("Content-Type", "application/octet-stream");
+    response.body.resize(size);
+
+    for (std::size_t i = 0; i < size; i++)
+        response.body[i] = static_cast<char>(i % 251);
+
+    return response;
+}
+
+// Maps a request to the response of the respective endpoint.
+Response handle(const Request& request)
+{
+    auto segments = segments_of(request.path);
+    auto name = segments.empty() ? std::string{} : segments.front();
+
+    bool is_get = request.method == "GET" || request.method == "HEAD";
+
+    auto only = [&request](const char* method, const std::function<Response()>& f)
+    {
+        return request.method == method ? f() : status(405);
+    };
+
+    try
+    {
+        if (request.path == "/ip" && is_get)
+            return Response::json(json::object(json::Members{{"origin", json::quoted(request.origin)}}));
+
+        if (request.path == "/user-agent" && is_get)
+            return Response::json(json::object(json::Members{{"user-agent", json::quoted(request.header("User-Agent"))}}));
+
+        if (request.path == "/headers" && is_get)
+            return Response::json(json::object(json::Members{{"headers", headers_of(request)}}));
+
+        if (request.path == "/get")
+            return is_get ? Response::json(json::object(get_members(request))) : status(405);
+
+        if (request.path == "/post")
+            return only("POST", [&request]() { return echo(request); });
+
+        if (request.path == "/put")
+            return only("PUT", [&request]() { return echo(request); });
+
+        if (request.path == "/delete")
+            return only("DELETE", [&request]() { return echo(request); });
+
+        if (request.path == "/uuid" && is_get)
+        {
+            auto hex = random_hex(32);
+            auto uuid = hex.substr(0, 8) + "-" + hex.substr(8, 4) + "-4" + hex.substr(13, 3) + "-a" +
+                        hex.substr(17, 3) + "-" + hex.substr(20, 12);
+            return Response::json(json::object(json::Members{{"uuid", json::quoted(uuid)}}));
+        }
+
+        if (name == "basic-auth" && segments.size() == 3 && is_get)
+            return basic_auth(request, segments[1], segments[2]);
+
+        if (name == "digest-auth" && segments.size() == 4)
+            return digest_auth(request, segments[1], segments[2], segments[3]);
+
+        if (name == "cache" && segments.size() == 1 && is_get)
+        {
+            if (request.has_header("If-Modified-Since") || request.has_header("If-None-Match"))
+                return Response{304, reason_for(304)};
+
+            auto response = Response::json(json::object(get_members(request)));
+            response.fields.emplace_back("Last-Modified", http_date(std::time(nullptr)));
+            response.fields.emplace_back("ETag", "\"" + random_hex(32) + "\"");
+            return response;
+        }
+
+        if (name == "cache" && segments.size() == 2 && is_get)
+        {
+            auto response = Response::json(json::object(get_members(request)));
+            response.fields.emplace_back("Cache-Control", "public, max-age=" + std::to_string(std::stoul(segments[1])));
+            return response;
+        }
+
+        if (name == "delay" && segments.size() == 2)
+        {
+            auto seconds = std::min(std::max(0., std::stod(segments[1])), max_delay_in_seconds);
+            auto response = Response::json(json::object(get_members(request)));
+            response.delay = std::chrono::milliseconds{static_cast<std::int64_t>(seconds * 1000)};
+            return response;
+        }
+
+        if (name == "bytes" && segments.size() == 2 && is_get)
+            return bytes(std::min<std::size_t>(std::stoull(segments[1]), max_body_size));
+
+        if (name == "stream-bytes" && segments.size() == 2 && is_get)
+        {
+            auto response = bytes(std::min<std::size_t>(std::stoull(segments[1]), max_body_size));
+            auto args = parse_pairs(request.query);
+            response.chunk_size = args.count("chunk_size") > 0 ? std::max(1ul, std::stoul(args["chunk_size"])) : default_chunk_size;
+            return response;
+        }
+
+        if (name == "event-stream" && segments.size() == 2 && is_get)
+        {
+            auto last = request.has_header("Last-Event-ID") ? std::stoull(request.header("Last-Event-ID")) : 0;
+            auto count = std::min<std::size_t>(std::stoull(segments[1]), 100);
+
+            Response response;
+            response.fields.emplace_back("Content-Type", "text/event-stream");
+            response.body = ": resuming\r\nretry: 10\n\n";
+            for (auto id = last + 1; id <= last + count; id++)
+                response.body += "id: " + std::to_string(id) + "\nevent: tick\ndata: " + std::to_string(id) + "\r\n\r\n";
+            // Small chunks split up lines and events.
+            response.chunk_size = 7;
+            return response;
+        }
+
+        if (name == "status" && segments.size() == 2)
+        {
+            auto code = std::stoi(segments[1]);
+            if (code >= 200 && code < 600)
+                return status(code);
+        }
+    } catch (const std::exception&)
+    {
+        // Malformed numbers in paths end up here.
+        return status(400);
+    }
+
+    return status(404);
+}
+
+// A response waiting for its delay to pass before being written out.
+struct Pending
+{
+    Clock::time_point due;
+    std::string data;
+    bool close;
+};
+
+// An accepted connection, parsing requests off its input as they arrive.
+class Connection
+{
+public:
+    Connection(int fd, const std::string& origin, const std::chrono::milliseconds& latency)
+        : fd(fd),
+          origin(origin),
+          latency(latency)
+    {
+    }
+
+    ~Connection()
+    {
+        ::close(fd);
+    }
+
+    // Reads all available input, returns false if the connection should be closed.
+    bool read()
+    {
+        char buffer[64 * 1024];
+
+        while (true)
+        {
+            auto rc = ::recv(fd, buffer, sizeof(buffer), 0);
+
+            if (rc > 0)
+            {
+                in.append(buffer, rc);
+                continue;
+            }
+
+            if (rc == 0)
+                return false;
+
+            if (errno == EINTR)
+                continue;
+
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+
+    // Parses all complete requests off the input and queues their responses.
+    void consume()
+    {
+        std::size_t offset{0};
+
+        while (not closing)
+        {
+            if (stage == Stage::head)
+            {
+                auto end = in.find("\r\n\r\n", offset);
+
+                if (end == std::string::npos)
+                {
+                    if (in.size() - offset > max_head_size)
+                        reject(431);
+                    break;
+                }
+
+                if (not parse_head(in.substr(offset, end - offset)))
+                {
+                    reject(400);
+                    break;
+                }
+
+                offset = end + 4;
+
+                if (stage != Stage::head && iequals(request.header("Expect"), "100-continue") && offset == in.size())
+                    queue("HTTP/1.1 100 Continue\r\n\r\n", Clock::now(), false);
+            }
+
+            if (stage == Stage::body)
+            {
+                auto size = std::min(remaining, in.size() - offset);
+                request.body.append(in, offset, size);
+                offset += size;
+                remaining -= size;
+
+                if (remaining > 0)
+                    break;
+
+                stage = Stage::head;
+            }
+
+            if (stage == Stage::chunk_size || stage == Stage::trailer)
+            {
+                auto end = in.find("\r\n", offset);
+                if (end == std::string::npos)
+                    break;
+
+                auto line = in.substr(offset, end - offset);
+                offset = end + 2;
+
+                if (stage == Stage::trailer)
+                {
+                    if (line.empty())
+                        stage = Stage::head;
+                    else
+                        continue;
+                } else
+                {
+                    try
+                    {
+                        remaining = std::stoull(line.substr(0, line.find(';')), nullptr, 16);
+                    } catch (const std::exception&)
+                    {
+                        reject(400);
+                        break;
+                    }
+
+                    if (request.body.size() + remaining > max_body_size)
+                    {
+                        reject(413);
+                        break;
+                    }
+
+                    stage = remaining == 0 ? Stage::trailer : Stage::chunk_data;
+                    continue;
+                }
+            }
+
+            if (stage == Stage::chunk_data)
+            {
+                // The data of a chunk is followed by a line break.
+                if (remaining > 0)
+                {
+                    auto size = std::min(remaining, in.size() - offset);
+                    request.body.append(in, offset, size);
+                    offset += size;
+                    remaining -= size;
+                }
+
+                if (remaining > 0 || in.size() - offset < 2)
+                    break;
+
+                offset += 2;
+                stage = Stage::chunk_size;
+                continue;
+            }
+
+            respond();
+        }
+
+        in.erase(0, offset);
+    }
+
+    // Appends all responses that are due to the output, returning the
+    // point in time the next response is due at, if any.
+    Clock::time_point flush_due(const Clock::time_point& now)
+    {
+        while (not pending.empty() && pending.front().due <= now)
+        {
+            out.append(pending.front().data);
+            close_after_output = close_after_output || pending.front().close;
+            pending.pop_front();
+
+            // Nothing is read past a response that closes the connection.
+            if (close_after_output)
+                pending.clear();
+        }
+
+        return pending.empty() ? Clock::time_point::max() : pending.front().due;
+    }
+
+    // Writes as much output as possible, returns false if the connection should be closed.
+    bool write()
+    {
+        while (not out.empty())
+        {
+            auto rc = ::send(fd, out.data(), out.size(), MSG_NOSIGNAL);
+
+            if (rc > 0)
+            {
+                out.erase(0, rc);
+                continue;
+            }
+
+            if (rc < 0 && errno == EINTR)
+                continue;
+
+            return rc < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+
+        return not close_after_output;
+    }
+
+    bool wants_to_write() const
+    {
+        return not out.empty();
+    }
+
+    const int fd;
+
+private:
+    enum class Stage
+    {
+        head,
+        body,
+        chunk_size,
+        chunk_data,
+        trailer
+    };
+
+    // Parses the request line and header fields, and figures out how the body is transferred.
+    bool parse_head(const std::string& head)
+    {
+        request = Request{};
+        request.origin = origin;
+
+        std::istringstream lines{head};
+        std::string line;
+
+        if (not std::getline(lines, line))
+            return false;
+
+        if (not line.empty() && line.back() == '\r')
+            line.pop_back();
+
+        std::istringstream request_line{line};
+        if (not (request_line >> request.method >> request.target >> request.version))
+            return false;
+
+        if (request.version.compare(0, 5, "HTTP/") != 0 || request.target.empty() || request.target.front() != '/')
+            return false;
+
+        auto question_mark = request.target.find('?');
+        request.path = request.target.substr(0, question_mark);
+        if (question_mark != std::string::npos)
+            request.query = request.target.substr(question_mark + 1);
+
+        while (std::getline(lines, line))
+        {
+            if (not line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            auto colon = line.find(':');
+            if (colon == std::string::npos || colon == 0)
+                return false;
+
+            request.fields.emplace_back(line.substr(0, colon), trim(line.substr(colon + 1)));
+        }
+
+        if (request.header("Transfer-Encoding").find("chunked") != std::string::npos)
+        {
+            stage = Stage::chunk_size;
+            return true;
+        }
+
+        auto content_length = request.header("Content-Length");
+        if (content_length.empty())
+        {
+            stage = Stage::body;
+            remaining = 0;
+            return true;
+        }
+
+        try
+        {
+            remaining = std::stoull(content_length);
+        } catch (const std::exception&)
+        {
+            return false;
+        }
+
+        stage = Stage::body;
+        return remaining <= max_body_size;
+    }
+
+    void respond()
+    {
+        auto response = handle(request);
+        auto keep_alive = request.keep_alive();
+
+        queue(serialize(response, request.method == "HEAD", keep_alive), Clock::now() + latency + response.delay, not keep_alive);
+        closing = not keep_alive;
+    }
+
+    void reject(int code)
+    {
+        queue(serialize(status(code), false, false), Clock::now(), true);
+        closing = true;
+    }
+
+    void queue(const std::string& data, const Clock::time_point& due, bool close)
+    {
+        // Responses go out in order, a response is never due prior to the previous one.
+        auto at = pending.empty() ? due : std::max(due, pending.back().due);
+        pending.push_back(Pending{at, data, close});
+    }
+
+    std::string origin;
+    std::chrono::milliseconds latency;
+
+    std::string in;
+    std::string out;
+    std::deque<Pending> pending;
+    bool closing{false};
+    bool close_after_output{false};
+
+    Stage stage{Stage::head};
+    std::size_t remaining{0};
+    Request request;
+};
+
+// Serves the connections it accepted from its own epoll instance.
+class Worker
+{
+public:
+    Worker(int listener, int shutdown, const std::chrono::milliseconds& latency)
+        : listener(listener),
+          shutdown(shutdown),
+          latency(latency),
+          epoll(::epoll_create1(EPOLL_CLOEXEC))
+    {
+        if (epoll < 0)
+            throw last_error("Could not create epoll instance");
+
+        // All workers watch the listener, only one of them is woken up per connection.
+        watch(listener, EPOLLIN | EPOLLEXCLUSIVE);
+        watch(shutdown, EPOLLIN);
+    }
+
+    ~Worker()
+    {
+        connections.clear();
+        ::close(epoll);
+    }
+
+    void run()
+    {
+        std::vector<epoll_event> events(256);
+
+        while (true)
+        {
+            auto timeout = timeout_for_next_due();
+            auto count = ::epoll_wait(epoll, events.data(), events.size(), timeout);
+
+            if (count < 0 && errno != EINTR)
+                return;
+
+            for (int i = 0; i < count; i++)
+            {
+                auto fd = events[i].data.fd;
+
+                if (fd == shutdown)
+                    return;
+
+                if (fd == listener)
+                {
+                    accept();
+                    continue;
+                }
+
+                auto it = connections.find(fd);
+                if (it == connections.end())
+                    continue;
+
+                auto& connection = *it->second;
+                bool alive{true};
+
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+                {
+                    alive = connection.read();
+                    connection.consume();
+                }
+
+                if (alive)
+                    update(connection, Clock::now());
+                else
+                    connections.erase(it);
+            }
+
+            flush_due();
+        }
+    }
+
+private:
+    void watch(int fd, std::uint32_t events)
+    {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+
+        if (::epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+            throw last_error("Could not watch file descriptor");
+    }
+
+    void accept()
+    {
+        while (true)
+        {
+            sockaddr_in address{};
+            socklen_t length = sizeof(address);
+
+            auto fd = ::accept4(listener, reinterpret_cast<sockaddr*>(&address), &length, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0)
+                return;
+
+            int enable{1};
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+
+            char ip[INET_ADDRSTRLEN] = {0};
+            ::inet_ntop(AF_INET, &address.sin_addr, ip, sizeof(ip));
+
+            connections[fd].reset(new Connection{fd, ip, latency});
+            watch(fd, EPOLLIN);
+        }
+    }
+
+    // Writes out due responses of connection and adjusts what we wait for, closing it if done.
+    void update(Connection& connection, const Clock::time_point& now)
+    {
+        auto due = connection.flush_due(now);
+
+        if (due != Clock::time_point::max())
+            timers.emplace(due, connection.fd);
+
+        if (not connection.write())
+        {
+            connections.erase(connection.fd);
+            return;
+        }
+
+        epoll_event event{};
+        event.events = connection.wants_to_write() ? EPOLLIN | EPOLLOUT : EPOLLIN;
+        event.data.fd = connection.fd;
+        ::epoll_ctl(epoll, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+
+    void flush_due()
+    {
+        auto now = Clock::now();
+
+        while (not timers.empty() && timers.begin()->first <= now)
+        {
+            auto fd = timers.begin()->second;
+            timers.erase(timers.begin());
+
+            auto it = connections.find(fd);
+            if (it != connections.end())
+                update(*it->second, now);
+        }
+    }
+
+    int timeout_for_next_due() const
+    {
+        if (timers.empty())
+            return -1;
+
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(timers.begin()->first - Clock::now());
+        // Round up, waking up early would make us spin.
+        return std::max<int>(0, wait.count() + 1);
+    }
+
+    int listener;
+    int shutdown;
+    std::chrono::milliseconds latency;
+    int epoll;
+
+    std::map<int, std::unique_ptr<Connection>> connections;
+    std::set<std::pair<Clock::time_point, int>> timers;
+};
+}
+
+struct httpbin::Instance::Private
+{
+    Private(const Options& options)
+        : listener(::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)),
+          shutdown(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (listener < 0 || shutdown < 0)
+            throw last_error("Could not create socket");
+
+        int enable{1};
+        ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(options.port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+            throw last_error("Could not bind to port");
+
+        socklen_t size{sizeof(address)};
+        if (::getsockname(listener, reinterpret_cast<sockaddr*>(&address), &size) < 0)
+            throw last_error("Could not query port");
+
+        port = ntohs(address.sin_port);
+
+        // Once listening, the kernel queues up connections until a worker accepts them.
+        if (::listen(listener, SOMAXCONN) < 0)
+            throw last_error("Could not listen");
+
+        auto count = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+        for (std::size_t i = 0; i < count; i++)
+            workers.emplace_back(new Worker{listener, shutdown, options.latency});
+
+        for (auto& worker : workers)
+        {
+            auto w = worker.get();
+            threads.emplace_back([w]() { w->run(); });
+        }
+    }
+
+    ~Private()
+    {
+        std::uint64_t value{1};
+        if (::write(shutdown, &value, sizeof(value)) < 0)
+        {
+            // Workers stay blocked, there is nothing left to do but to leave them behind,
+            // together with everything they still use.
+            for (auto& thread : threads)
+                thread.detach();
+
+            for (auto& worker : workers)
+                worker.release();
+
+            return;
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        workers.clear();
+
+        ::close(listener);
+        ::close(shutdown);
+    }
+
+    int listener;
+    int shutdown;
+    std::uint16_t port{0};
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+};
+
+httpbin::Instance::Instance() : Instance(Options{})
+{
+}
+
+httpbin::Instance::Instance(const Options& options) : d(new Private(options))
+{
+    std::uint16_t none{0};
+    first_port.compare_exchange_strong(none, d->port);
+}
+
+httpbin::Instance::~Instance()
+{
+}
+
+std::uint16_t httpbin::Instance::port() const
+{
+    return d->port;
+}
+
+std::string httpbin::Instance::host() const
+{
+    return url_for(d->port);
+}
+
+std::string httpbin::host()
+{
+    auto port = first_port.load();
+
+    if (port == 0)
+        throw std::logic_error("No httpbin instance has been started.");
+
+    return url_for(port);
+}
+
+std::string httpbin::inflated(const std::string& data)
+{
+    static const std::string prefix{"data:application/octet-stream;base64,"};
+
+    auto compressed = data.compare(0, prefix.size(), prefix) == 0 ? base64_decode(data.substr(prefix.size())) : data;
+
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+
+    // Adding 32 to the window bits detects gzip and zlib headers alike.
+    if (::inflateInit2(&stream, 15 + 32) != Z_OK)
+        throw std::runtime_error("Could not set up inflating.");
+
+    stream.next_in = reinterpret_cast<Bytef*>(&compressed[0]);
+    stream.avail_in = static_cast<uInt>(compressed.size());
+
+    std::string result;
+    char buffer[4096];
+    int rc{Z_OK};
+
+    while (rc == Z_OK)
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+
+        rc = ::inflate(&stream, Z_NO_FLUSH);
+        result.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+
+    ::inflateEnd(&stream);
+
+    if (rc != Z_STREAM_END)
+        throw std::runtime_error("Body is not a complete compressed stream.");
+
+    return result;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright © 2013 Canonical Ltd.
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: Thomas Voß <thomas.voss@canonical.com>
+ *              Gary Wang  <gary.wang@canonical.com>
+ *              agent <agent@local>
+ */
+
+#ifndef HTTPBIN_H_
+#define HTTPBIN_H_
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ *
+ * Testing an HTTP Library can become difficult sometimes. Postbin is fantastic
+ * for testing POST requests, but not much else. This exists to cover all kinds
+ * of HTTP scenarios, modelled after the endpoints of httpbin.org.
+ *
+ * All endpoint responses are JSON-encoded, apart from the ones handing out bytes.
+ *
+ */
+namespace httpbin
+{
+/** Tunes a local instance. */
+struct Options
+{
+    /** The port to listen on, on the loopback interface. The kernel picks a free one if 0. */
+    std::uint16_t port{0};
+    /** The number of threads serving connections, one per core if 0. */
+    std::size_t threads{0};
+    /** Delay added to every response, on top of the delay requested by /delay. */
+    std::chrono::milliseconds latency{0};
+};
+
+/**
+ * Runs a local instance of httpbin in the background of the current process: an
+ * HTTP/1.1 server with keep-alive and chunked transfer coding, serving connections
+ * from a set of threads that each multiplex their connections with epoll.
+ */
+class Instance
+{
+public:
+    /** Starts listening with default options, throws std::system_error in case of issues. */
+    Instance();
+    /** Starts listening as configured, throws std::system_error in case of issues. */
+    explicit Instance(const Options& options);
+
+    Instance(const Instance&) = delete;
+    /** Closes all connections and stops serving. */
+    ~Instance();
+
+    Instance& operator=(const Instance&) = delete;
+
+    // Connections are accepted as soon as the constructor returns, there
+    // is no need to wait for the instance to become ready.
+
+    /** The port the instance listens on. */
+    std::uint16_t port() const;
+
+    /** The URL of the instance, e.g., "http://127.0.0.1:5000". */
+    std::string host() const;
+
+private:
+    struct Private;
+    std::unique_ptr<Private> d;
+};
+
+/**
+ * Returns the URL of the first instance started in this process, such that
+ * test suites relying on a single instance do not have to pass it around.
+ * Throws std::logic_error if no instance has been started yet.
+ */
+std::string host();
+
+/**
+ * Returns the body of a request as echoed in the "data" field, decoding the
+ * data URI binary bodies are handed out as and inflating gzip or zlib streams.
+ * Throws std::runtime_error if the body is not a complete compressed stream.
+ */
+std::string inflated(const std::string& data);
+
+namespace resources
+{
+/** A non-existing resource */
+inline const char* does_not_exist()
+{
+    return "/does_not_exist";
+}
+/** Returns Origin IP. */
+inline const char* ip()
+{
+    return "/ip";
+}
+/** Returns user-agent. */
+inline const char* user_agent()
+{
+    return "/user-agent";
+}
+/** Returns header dict. */
+inline const char* headers()
+{
+    return "/headers";
+}
+/** Returns GET data. */
+inline const char* get()
+{
+    return "/get";
+}
+/** Returns POST data. */
+inline const char* post()
+{
+    return "/post";
+}
+/** Returns PUT data. */
+inline const char* put()
+{
+    return "/put";
+}
+/** Returns DELETE data. */
+inline const char* del()
+{
+    return "/delete";
+}
+/** Challenges basic authentication. */
+inline const char* basic_auth()
+{
+    return "/basic-auth/user/passwd";
+}
+/** Challenges digest authentication. */
+inline const char* digest_auth()
+{
+    return "/digest-auth/auth/user/passwd";
+}
+/** Returns 304 for conditional requests, and a response carrying validators otherwise. */
+inline const char* cache()
+{
+    return "/cache";
+}
+/** Returns a response that is fresh for 60 seconds. */
+inline const char* cache_for_a_minute()
+{
+    return "/cache/60";
+}
+/** Returns a UUID that differs for every response. */
+inline const char* uuid()
+{
+    return "/uuid";
+}
+/** Returns GET data after the given delay. */
+inline std::string delay(const std::chrono::milliseconds& delay)
+{
+    return "/delay/" + std::to_string(delay.count() / 1000.);
+}
+/** Returns size bytes of binary data. */
+inline std::string bytes(std::size_t size)
+{
+    return "/bytes/" + std::to_string(size);
+}
+/** Returns size bytes of binary data with chunked transfer coding. */
+inline std::string stream_bytes(std::size_t size)
+{
+    return "/stream-bytes/" + std::to_string(size);
+}
+/** Returns count server-sent events following the one given as Last-Event-ID, asking for reconnecting after 10ms. */
+inline std::string event_stream(std::size_t count)
+{
+    return "/event-stream/" + std::to_string(count);
+}
+/** Returns the given status code. */
+inline std::string status(int code)
+{
+    return "/status/" + std::to_string(code);
+}
+}
+}
+
+#endif // HTTPBIN_H_
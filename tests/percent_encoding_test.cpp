@@ -0,0 +1,158 @@
+/*
+ * Copyright © 2026 agent
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authored by: agent <agent@local>
+ */
+
+#include <core/net/percent_encoding.h>
+
+#include "core/net/impl/percent_encoding.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+namespace impl = core::net::impl;
+namespace kernels = core::net::impl::percent_encoding;
+namespace pe = core::net::percent_encoding;
+
+namespace
+{
+const pe::Component all_components[] =
+{
+    pe::Component::unreserved,
+    pe::Component::path_segment,
+    pe::Component::query,
+    pe::Component::form
+};
+
+// Mostly characters that stay as they are, to give the kernels long runs to chew on.
+std::string random_text(std::size_t size, std::mt19937& rng)
+{
+    static const std::string mostly_safe{"abcdefghijklmnopqrstuvwxyz0123456789-._~"};
+    std::uniform_int_distribution<int> any(0, 255);
+    std::uniform_int_distribution<int> safe(0, mostly_safe.size() - 1);
+    std::bernoulli_distribution unsafe(0.05);
+
+    std::string result(size, '\0');
+    for (auto& c : result)
+        c = unsafe(rng) ? static_cast<char>(any(rng)) : mostly_safe[safe(rng)];
+
+    return result;
+}
+
+std::string encode_with(impl::Isa isa, const std::string& data, pe::Component component)
+{
+    std::string result;
+    kernels::encode(data.data(), data.size(), result, component, isa);
+    return result;
+}
+
+std::string decode_with(impl::Isa isa, const std::string& text, pe::Component component)
+{
+    std::string result;
+    kernels::decode(text.data(), text.size(), result, component, isa);
+    return result;
+}
+}
+
+TEST(PercentEncoding, unreserved_matches_curl_escape)
+{
+    EXPECT_EQ("", pe::encode(""));
+    EXPECT_EQ("AZaz09-._~", pe::encode("AZaz09-._~"));
+    EXPECT_EQ("Hello%20G%C3%BCnter", pe::encode("Hello Günter"));
+    EXPECT_EQ("%2F%3F%23%5B%5D%40%21%24%26%27%28%29%2A%2B%2C%3B%3D%25", pe::encode("/?#[]@!$&'()*+,;=%"));
+    EXPECT_EQ("%00%FF", pe::encode(std::string{"\0\xff", 2}));
+}
+
+TEST(PercentEncoding, components_leave_their_delimiters_alone)
+{
+    EXPECT_EQ("a:b@c!$&'()*+,;=%2F%3F%23%25%20", pe::encode("a:b@c!$&'()*+,;=/?#% ", pe::Component::path_segment));
+    EXPECT_EQ("a:b@c/?!$'()*,;%26%3D%2B%23%25%20", pe::encode("a:b@c/?!$'()*,;&=+#% ", pe::Component::query));
+    EXPECT_EQ("a+b*-._%7E%26%3D%2B", pe::encode("a b*-._~&=+", pe::Component::form));
+}
+
+TEST(PercentEncoding, decode_handles_plus_and_malformed_escapes)
+{
+    EXPECT_EQ("A b", pe::decode("%41%20b"));
+    EXPECT_EQ("\xff\xab", pe::decode("%ff%aB"));
+    EXPECT_EQ("a+b", pe::decode("a+b"));
+    EXPECT_EQ("a b c", pe::decode("a+b%20c", pe::Component::form));
+    EXPECT_EQ("%zz%4%", pe::decode("%zz%4%"));
+    EXPECT_EQ("100%", pe::decode("100%25"));
+}
+
+TEST(PercentEncoding, appending_overloads_keep_existing_content)
+{
+    std::string out{"q="};
+    pe::encode("a b", 3, out, pe::Component::query);
+    EXPECT_EQ("q=a%20b", out);
+
+    std::string decoded{"value: "};
+    pe::decode("a+b", 3, decoded, pe::Component::form);
+    EXPECT_EQ("value: a b", decoded);
+}
+
+TEST(PercentEncoding, all_kernels_agree_with_the_scalar_implementation)
+{
+    std::mt19937 rng{42};
+
+    for (auto isa : impl::supported_isas())
+    {
+        SCOPED_TRACE(impl::name_of(isa));
+
+        for (std::size_t size = 0; size < 300; size++)
+        {
+            auto data = random_text(size, rng);
+
+            for (auto component : all_components)
+            {
+                auto expected = encode_with(impl::Isa::scalar, data, component);
+                auto encoded = encode_with(isa, data, component);
+
+                ASSERT_EQ(expected, encoded);
+                ASSERT_EQ(data, decode_with(isa, encoded, component));
+                ASSERT_EQ(decode_with(impl::Isa::scalar, data, component), decode_with(isa, data, component));
+            }
+        }
+    }
+}
+
+TEST(PercentEncoding, all_kernels_escape_every_byte_at_every_position)
+{
+    for (auto isa : impl::supported_isas())
+    {
+        SCOPED_TRACE(impl::name_of(isa));
+
+        for (auto component : all_components)
+        {
+            const std::string text(96, 'a');
+
+            for (int c = 0; c < 256; c++)
+            {
+                auto expected = encode_with(impl::Isa::scalar, std::string(1, static_cast<char>(c)), component);
+
+                for (std::size_t position = 0; position < text.size(); position++)
+                {
+                    auto data = text;
+                    data[position] = static_cast<char>(c);
+
+                    ASSERT_EQ(text.substr(0, position) + expected + text.substr(position + 1),
+                              encode_with(isa, data, component));
+                }
+            }
+        }
+    }
+}